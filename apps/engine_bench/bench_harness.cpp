@@ -0,0 +1,196 @@
+#include "bench_harness.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace bench {
+
+namespace {
+
+void set_error(std::string* out_error, const std::string& message) {
+  if (out_error != nullptr) {
+    *out_error = message;
+  }
+}
+
+// Names come from code, but keep the output valid JSON regardless.
+std::string json_escape(const std::string_view text) {
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+    }
+    escaped.push_back(c);
+  }
+  return escaped;
+}
+
+} // namespace
+
+bool parse_harness_args(const int argc, char** argv, HarnessOptions* out_options, std::string* out_error) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    const size_t equals = arg.find('=');
+    const std::string_view name = arg.substr(0, equals);
+    const std::string value(equals == std::string_view::npos ? std::string_view{} : arg.substr(equals + 1U));
+    char* end = nullptr;
+
+    if (name == "--list" && equals == std::string_view::npos) {
+      out_options->list_only = true;
+    } else if (name == "--suite" && !value.empty()) {
+      size_t start = 0;
+      while (start <= value.size()) {
+        const size_t comma = std::min(value.find(',', start), value.size());
+        if (comma > start) {
+          out_options->suites.push_back(value.substr(start, comma - start));
+        }
+        start = comma + 1U;
+      }
+    } else if (name == "--repetitions") {
+      const unsigned long repetitions = std::strtoul(value.c_str(), &end, 10);
+      if (value.empty() || *end != '\0' || repetitions == 0U) {
+        set_error(out_error, "Invalid value for --repetitions: '" + value + "'");
+        return false;
+      }
+      out_options->repetitions = static_cast<uint32_t>(repetitions);
+    } else if (name == "--min-time-ms") {
+      const double min_time = std::strtod(value.c_str(), &end);
+      if (value.empty() || *end != '\0' || min_time <= 0.0) {
+        set_error(out_error, "Invalid value for --min-time-ms: '" + value + "'");
+        return false;
+      }
+      out_options->min_repetition_ms = min_time;
+    } else if (name == "--output" && !value.empty()) {
+      out_options->output_path = value;
+    } else {
+      set_error(out_error, "Unknown argument: " + std::string(arg));
+      return false;
+    }
+  }
+  return true;
+}
+
+Harness::Harness(HarnessOptions options) : options_(std::move(options)) {}
+
+bool Harness::suite_enabled(const std::string_view suite) {
+  if (std::find(seen_suites_.begin(), seen_suites_.end(), suite) == seen_suites_.end()) {
+    seen_suites_.emplace_back(suite);
+  }
+  if (options_.list_only) {
+    return false;
+  }
+  return options_.suites.empty() ||
+         std::find(options_.suites.begin(), options_.suites.end(), suite) != options_.suites.end();
+}
+
+void Harness::add_counter(const std::string_view name, const double value) {
+  if (options_.list_only || results_.empty()) {
+    return;
+  }
+  results_.back().counters.emplace_back(name, value);
+  std::printf("%-10s %-32s   %s = %.10g\n", results_.back().suite.c_str(), "", std::string(name).c_str(), value);
+  std::fflush(stdout);
+}
+
+const std::vector<BenchmarkResult>& Harness::results() const {
+  return results_;
+}
+
+const std::vector<std::string>& Harness::seen_suites() const {
+  return seen_suites_;
+}
+
+void Harness::record(const std::string_view suite,
+                     const std::string_view name,
+                     const uint64_t iterations,
+                     const uint64_t items_per_iteration,
+                     std::vector<double> repetition_ns) {
+  BenchmarkResult result;
+  result.suite = suite;
+  result.name = name;
+  result.iterations = iterations;
+  result.items_per_iteration = items_per_iteration;
+
+  std::sort(repetition_ns.begin(), repetition_ns.end());
+  const size_t count = repetition_ns.size();
+  double sum = 0.0;
+  for (const double sample : repetition_ns) {
+    sum += sample;
+  }
+  result.mean_ns = sum / static_cast<double>(count);
+  double variance = 0.0;
+  for (const double sample : repetition_ns) {
+    variance += (sample - result.mean_ns) * (sample - result.mean_ns);
+  }
+  result.stddev_ns = count > 1U ? std::sqrt(variance / static_cast<double>(count - 1U)) : 0.0;
+  result.min_ns = repetition_ns.front();
+  result.max_ns = repetition_ns.back();
+  result.median_ns = (count % 2U) == 1U ? repetition_ns[count / 2U]
+                                        : (repetition_ns[(count / 2U) - 1U] + repetition_ns[count / 2U]) * 0.5;
+
+  std::printf("%-10s %-32s median=%12.3f ns  min=%12.3f ns  stddev=%6.2f%%  (%llu x %u)\n",
+              result.suite.c_str(),
+              result.name.c_str(),
+              result.median_ns,
+              result.min_ns,
+              result.mean_ns > 0.0 ? (100.0 * result.stddev_ns / result.mean_ns) : 0.0,
+              static_cast<unsigned long long>(result.iterations),
+              options_.repetitions);
+  std::fflush(stdout);
+  results_.push_back(std::move(result));
+}
+
+bool Harness::write_json(std::string* out_error) const {
+  std::FILE* file = std::fopen(options_.output_path.c_str(), "w");
+  if (file == nullptr) {
+    set_error(out_error, "Failed to create benchmark report: " + options_.output_path);
+    return false;
+  }
+
+  std::fprintf(file, "{\n");
+  std::fprintf(file,
+               "  \"config\": {\"repetitions\": %u, \"min_repetition_ms\": %.3f},\n",
+               options_.repetitions,
+               options_.min_repetition_ms);
+  std::fprintf(file, "  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results_.size(); ++i) {
+    const BenchmarkResult& result = results_[i];
+    std::fprintf(file,
+                 "    {\"suite\": \"%s\", \"name\": \"%s\", \"iterations\": %llu, \"items_per_iteration\": %llu, "
+                 "\"unit\": \"ns/item\", \"min\": %.4f, \"median\": %.4f, \"mean\": %.4f, \"stddev\": %.4f, "
+                 "\"max\": %.4f",
+                 json_escape(result.suite).c_str(),
+                 json_escape(result.name).c_str(),
+                 static_cast<unsigned long long>(result.iterations),
+                 static_cast<unsigned long long>(result.items_per_iteration),
+                 result.min_ns,
+                 result.median_ns,
+                 result.mean_ns,
+                 result.stddev_ns,
+                 result.max_ns);
+    if (!result.counters.empty()) {
+      std::fprintf(file, ", \"counters\": {");
+      for (size_t c = 0; c < result.counters.size(); ++c) {
+        std::fprintf(file,
+                     "%s\"%s\": %.10g",
+                     c > 0U ? ", " : "",
+                     json_escape(result.counters[c].first).c_str(),
+                     result.counters[c].second);
+      }
+      std::fprintf(file, "}");
+    }
+    std::fprintf(file, "}%s\n", i + 1U < results_.size() ? "," : "");
+  }
+  std::fprintf(file, "  ]\n}\n");
+
+  const bool ok = std::ferror(file) == 0;
+  std::fclose(file);
+  if (!ok) {
+    set_error(out_error, "Failed to write benchmark report: " + options_.output_path);
+  }
+  return ok;
+}
+
+} // namespace bench
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+struct HarnessOptions {
+  uint32_t repetitions = 10U;
+  double min_repetition_ms = 20.0; // each repetition runs at least this long
+  std::vector<std::string> suites; // empty = every suite
+  std::string output_path = "engine_bench.json";
+  bool list_only = false;
+};
+
+// Recognizes --suite=a,b --repetitions=N --min-time-ms=X --output=PATH and --list.
+bool parse_harness_args(int argc, char** argv, HarnessOptions* out_options, std::string* out_error);
+
+// Keeps the compiler from discarding a computed value.
+template <typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  const volatile char* bytes = reinterpret_cast<const volatile char*>(&value);
+  (void)bytes[0];
+#endif
+}
+
+struct BenchmarkResult {
+  std::string suite;
+  std::string name;
+  uint64_t iterations = 0; // per repetition
+  uint64_t items_per_iteration = 1;
+  double min_ns = 0.0; // per item
+  double median_ns = 0.0;
+  double mean_ns = 0.0;
+  double stddev_ns = 0.0;
+  double max_ns = 0.0;
+  std::vector<std::pair<std::string, double>> counters; // non-timing figures, e.g. compression ratio
+};
+
+// Runs each benchmark body enough times per repetition to reach the minimum
+// repetition time, repeats that several times and reports per-item statistics.
+class Harness {
+public:
+  explicit Harness(HarnessOptions options);
+
+  // Also records the suite name for --list.
+  bool suite_enabled(std::string_view suite);
+
+  // body() performs one iteration covering items_per_iteration items (e.g. vertices).
+  template <typename Body>
+  void run(std::string_view suite, std::string_view name, uint64_t items_per_iteration, Body&& body);
+
+  // Attaches a named figure (error, byte count, ...) to the most recent run().
+  void add_counter(std::string_view name, double value);
+
+  const std::vector<BenchmarkResult>& results() const;
+  const std::vector<std::string>& seen_suites() const;
+  bool write_json(std::string* out_error = nullptr) const;
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  void record(std::string_view suite,
+              std::string_view name,
+              uint64_t iterations,
+              uint64_t items_per_iteration,
+              std::vector<double> repetition_ns);
+
+  HarnessOptions options_;
+  std::vector<BenchmarkResult> results_;
+  std::vector<std::string> seen_suites_;
+};
+
+template <typename Body>
+void Harness::run(const std::string_view suite,
+                  const std::string_view name,
+                  const uint64_t items_per_iteration,
+                  Body&& body) {
+  if (options_.list_only) {
+    return;
+  }
+
+  // Calibrate (this doubles as warm-up): grow the batch until it meets the minimum time.
+  const auto min_time = std::chrono::duration<double, std::milli>(options_.min_repetition_ms);
+  uint64_t iterations = 1;
+  while (true) {
+    const clock::time_point start = clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+      body();
+    }
+    const std::chrono::duration<double, std::milli> elapsed = clock::now() - start;
+    if (elapsed >= min_time || iterations >= (uint64_t{1} << 40U)) {
+      break;
+    }
+    const double scale = elapsed.count() > 0.0 ? (min_time / elapsed) * 1.2 : 10.0;
+    iterations =
+        std::max(iterations * 2U, static_cast<uint64_t>(static_cast<double>(iterations) * std::min(scale, 10.0)));
+  }
+
+  std::vector<double> repetition_ns;
+  repetition_ns.reserve(options_.repetitions);
+  for (uint32_t repetition = 0; repetition < options_.repetitions; ++repetition) {
+    const clock::time_point start = clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+      body();
+    }
+    const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+    repetition_ns.push_back(elapsed.count() / static_cast<double>(iterations * items_per_iteration));
+  }
+
+  record(suite, name, iterations, items_per_iteration, std::move(repetition_ns));
+}
+
+} // namespace bench
@@ -0,0 +1,640 @@
+#include "bench_harness.h"
+
+#include "engine/assets/asset_manager.h"
+#include "engine/assets/gltf_loader.h"
+#include "engine/assets/mesh_data.h"
+#include "engine/assets/mesh_simplifier.h"
+#include "engine/assets/vertex_format.h"
+#include "engine/core/allocators.h"
+#include "engine/core/logger.h"
+#include "engine/core/slot_map.h"
+#include "engine/core/string_id.h"
+#include "engine/core/thread_pool.h"
+#include "engine/math/mat4.h"
+#include "engine/renderer/vertex_projection.h"
+#include "engine/runtime/scene.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory_resource>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+engine::assets::MeshData make_sphere_mesh(const uint32_t rings, const uint32_t segments) {
+  engine::assets::MeshData mesh{};
+  constexpr float pi = 3.14159265359F;
+  constexpr float radius = 2.5F;
+
+  for (uint32_t r = 0; r <= rings; ++r) {
+    const float v = static_cast<float>(r) / static_cast<float>(rings);
+    const float phi = v * pi;
+    for (uint32_t s = 0; s <= segments; ++s) {
+      const float u = static_cast<float>(s) / static_cast<float>(segments);
+      const float theta = u * 2.0F * pi;
+      const engine::math::Vec3 n{std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta)};
+      mesh.vertices.push_back(engine::assets::Vertex{n * radius});
+      mesh.normals.push_back(n);
+      mesh.uvs.push_back({u, v});
+    }
+  }
+
+  const uint32_t stride = segments + 1U;
+  for (uint32_t r = 0; r < rings; ++r) {
+    for (uint32_t s = 0; s < segments; ++s) {
+      const uint32_t i0 = (r * stride) + s;
+      const uint32_t i1 = i0 + stride;
+      mesh.indices.push_back(i0);
+      mesh.indices.push_back(i1);
+      mesh.indices.push_back(i0 + 1U);
+      mesh.indices.push_back(i0 + 1U);
+      mesh.indices.push_back(i1);
+      mesh.indices.push_back(i1 + 1U);
+    }
+  }
+
+  mesh.bounds = engine::assets::compute_aabb(mesh.vertices);
+  return mesh;
+}
+
+// Fixed pseudo-random sequence so every run and every build sees the same inputs.
+uint32_t next_random(uint32_t* state) {
+  *state = (*state * 1664525U) + 1013904223U;
+  return *state;
+}
+
+float random_unit(uint32_t* state) {
+  return static_cast<float>(next_random(state) >> 8U) / static_cast<float>(1U << 24U);
+}
+
+// Decode cost per vertex for each layout, with the size and error of the encoding as counters.
+void run_quantization_suite(bench::Harness& harness) {
+  struct NamedLayout {
+    const char* name;
+    engine::assets::VertexLayout layout;
+  };
+
+  const NamedLayout layouts[] = {
+      {"float32",
+       {engine::assets::PositionEncoding::Float32,
+        engine::assets::NormalEncoding::Float32,
+        engine::assets::UvEncoding::Float32,
+        false}},
+      {"unorm16_oct16_half", {}},
+      {"unorm16_oct8_half",
+       {engine::assets::PositionEncoding::Unorm16,
+        engine::assets::NormalEncoding::Octahedral8,
+        engine::assets::UvEncoding::Half16,
+        true}},
+  };
+
+  for (const uint32_t segments : {64U, 512U}) {
+    const engine::assets::MeshData mesh = make_sphere_mesh(segments, segments);
+    std::vector<engine::math::Vec3> positions;
+    std::vector<engine::math::Vec3> normals;
+    std::vector<engine::math::Vec2> uvs;
+
+    for (const NamedLayout& entry : layouts) {
+      const engine::assets::CompressedMesh compressed = engine::assets::compress_mesh(mesh, entry.layout);
+      const std::string name = std::string("decode_") + entry.name + "_" + std::to_string(mesh.vertices.size());
+      harness.run("quantization", name, mesh.vertices.size(), [&] {
+        engine::assets::decode_positions(compressed, &positions);
+        engine::assets::decode_normals(compressed, &normals);
+        engine::assets::decode_uvs(compressed, &uvs);
+        bench::do_not_optimize(positions.data());
+        bench::do_not_optimize(normals.data());
+        bench::do_not_optimize(uvs.data());
+      });
+
+      const engine::assets::QuantizationReport report = engine::assets::measure_quantization(mesh, entry.layout, 0U);
+      harness.add_counter("compressed_bytes", static_cast<double>(report.compressed_bytes));
+      harness.add_counter("source_bytes", static_cast<double>(report.source_bytes));
+      harness.add_counter("max_position_error", static_cast<double>(report.max_position_error));
+      harness.add_counter("mean_position_error", static_cast<double>(report.mean_position_error));
+      harness.add_counter("max_normal_error_degrees", static_cast<double>(report.max_normal_error_degrees));
+      harness.add_counter("max_uv_error", static_cast<double>(report.max_uv_error));
+    }
+  }
+}
+
+// Handle lookups against the unordered_map keyed by id that the slot map replaced.
+void run_slot_map_suite(bench::Harness& harness) {
+  for (const uint32_t mesh_count : {64U, 4096U, 65536U}) {
+    engine::core::SlotMap<engine::assets::MeshData, engine::assets::MeshHandle> slot_map;
+    std::unordered_map<uint32_t, engine::assets::MeshData> hash_map;
+    std::vector<engine::assets::MeshHandle> slot_handles;
+    slot_map.reserve(mesh_count);
+    slot_handles.reserve(mesh_count);
+
+    for (uint32_t i = 0; i < mesh_count; ++i) {
+      engine::assets::MeshData mesh{};
+      mesh.vertices.resize((i % 7U) + 1U);
+      slot_handles.push_back(slot_map.insert(mesh));
+      hash_map[i + 1U] = mesh;
+    }
+
+    // Same pseudo-random access order for both containers.
+    std::vector<uint32_t> order(64U * 1024U);
+    uint32_t state = 0x12345678U;
+    for (uint32_t& index : order) {
+      index = next_random(&state) % mesh_count;
+    }
+
+    size_t i = 0;
+    harness.run("slot_map", "slot_map_get_" + std::to_string(mesh_count), 1U, [&] {
+      const engine::assets::MeshData* mesh = slot_map.get(slot_handles[order[i++ & (order.size() - 1U)]]);
+      bench::do_not_optimize(mesh != nullptr ? mesh->vertices.size() : 0U);
+    });
+    harness.run("slot_map", "unordered_map_find_" + std::to_string(mesh_count), 1U, [&] {
+      const auto it = hash_map.find(order[i++ & (order.size() - 1U)] + 1U);
+      bench::do_not_optimize(it != hash_map.end() ? it->second.vertices.size() : 0U);
+    });
+  }
+}
+
+// Simplified LOD chains for a batch of meshes, on the calling thread and on a ThreadPool.
+void run_lod_generation_suite(bench::Harness& harness) {
+  constexpr uint32_t mesh_count = 8U;
+  const engine::assets::MeshData source = make_sphere_mesh(64, 128);
+  const std::string suffix = std::to_string(mesh_count) + "x" + std::to_string(source.indices.size() / 3U);
+  std::vector<engine::assets::MeshData> meshes(mesh_count, source);
+
+  // Only chains that are missing get generated, so clear the previous iteration's output.
+  const auto generate = [&](engine::core::ThreadPool* pool) {
+    for (engine::assets::MeshData& mesh : meshes) {
+      mesh.lods.clear();
+    }
+    engine::assets::generate_missing_lod_chains(meshes, {}, pool);
+    bench::do_not_optimize(meshes.front().lods.size());
+  };
+
+  harness.run("lod_generation", "serial_" + suffix, mesh_count, [&] { generate(nullptr); });
+  for (size_t i = 0; i < meshes.front().lods.size(); ++i) {
+    const engine::assets::MeshLod& lod = meshes.front().lods[i];
+    const std::string prefix = "lod" + std::to_string(i + 1U);
+    harness.add_counter(prefix + "_triangles", static_cast<double>(lod.indices.size() / 3U));
+    harness.add_counter(prefix + "_error", static_cast<double>(lod.error));
+  }
+
+  engine::core::ThreadPool pool;
+  harness.run("lod_generation", "pool_" + suffix, mesh_count, [&] { generate(&pool); });
+  harness.add_counter("threads", static_cast<double>(pool.thread_count()));
+}
+
+struct LiveAllocation {
+  std::byte* data = nullptr;
+  size_t bytes = 0;
+  size_t alignment = 0;
+  uint8_t pattern = 0;
+  bool fallback = false; // served upstream, so not in the allocator's stats
+};
+
+template <typename Resource>
+class AllocatorChecker {
+public:
+  AllocatorChecker(const char* name, Resource* resource)
+      : name_(name),
+        resource_(resource) {}
+
+  bool allocate(const size_t bytes, const size_t alignment) {
+    const uint64_t fallbacks = resource_->stats().fallback_allocations;
+    LiveAllocation allocation;
+    allocation.data = static_cast<std::byte*>(resource_->allocate(bytes, alignment));
+    allocation.bytes = bytes;
+    allocation.alignment = alignment;
+    allocation.pattern = static_cast<uint8_t>(next_pattern_++ | 1U);
+    allocation.fallback = resource_->stats().fallback_allocations != fallbacks;
+    if (reinterpret_cast<uintptr_t>(allocation.data) % alignment != 0U) {
+      return fail("misaligned allocation");
+    }
+    std::memset(allocation.data, allocation.pattern, bytes);
+    live_.push_back(allocation);
+    return true;
+  }
+
+  bool free(const size_t index) {
+    const LiveAllocation allocation = live_[index];
+    if (!intact(allocation)) {
+      return fail("allocation overwritten by another allocation");
+    }
+    resource_->deallocate(allocation.data, allocation.bytes, allocation.alignment);
+    live_[index] = live_.back();
+    live_.pop_back();
+    return true;
+  }
+
+  // For allocators that release everything at once; call before releasing.
+  bool forget_all() {
+    for (const LiveAllocation& allocation : live_) {
+      if (!intact(allocation)) {
+        return fail("allocation overwritten by another allocation");
+      }
+    }
+    live_.clear();
+    return true;
+  }
+
+  // Stats add up, live counts match and (every few calls, as it sorts) no two live allocations
+  // overlap. Contents are checked when an allocation is freed.
+  bool verify() {
+    const engine::core::AllocatorStats stats = resource_->stats();
+    if (stats.used_bytes + stats.free_bytes + stats.overhead_bytes != stats.capacity_bytes) {
+      return fail("used + free + overhead != capacity");
+    }
+    if (stats.largest_free_bytes > stats.free_bytes || stats.peak_used_bytes < stats.used_bytes) {
+      return fail("largest free or peak out of range");
+    }
+    const auto owned = static_cast<uint64_t>(
+        std::count_if(live_.begin(), live_.end(), [](const LiveAllocation& a) { return !a.fallback; }));
+    if (stats.live_allocations != owned) {
+      return fail("live allocation count mismatch");
+    }
+
+    if (++verify_calls_ % 16U != 0U) {
+      return true;
+    }
+    std::vector<LiveAllocation> sorted = live_;
+    std::sort(sorted.begin(), sorted.end(), [](const LiveAllocation& a, const LiveAllocation& b) {
+      return a.data < b.data;
+    });
+    for (size_t i = 0; i + 1U < sorted.size(); ++i) {
+      if (sorted[i].data + sorted[i].bytes > sorted[i + 1U].data) {
+        return fail("overlapping allocations");
+      }
+    }
+    return true;
+  }
+
+  size_t live_count() const { return live_.size(); }
+
+  bool fail(const char* what) const {
+    std::fprintf(stderr, "allocator self-check failed: %s: %s\n", name_, what);
+    return false;
+  }
+
+private:
+  static bool intact(const LiveAllocation& allocation) {
+    for (size_t i = 0; i < allocation.bytes; ++i) {
+      if (static_cast<uint8_t>(allocation.data[i]) != allocation.pattern) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const char* name_;
+  Resource* resource_;
+  std::vector<LiveAllocation> live_;
+  uint32_t next_pattern_ = 0;
+  uint32_t verify_calls_ = 0;
+};
+
+// Randomized allocate/free sequences checked against each allocator's stats after every step.
+// Returns false (and prints why) on the first broken invariant.
+bool check_allocators() {
+  constexpr uint32_t steps = 10000U;
+  constexpr std::array<size_t, 4> alignments = {8U, 16U, 16U, 64U}; // 64 exercises the upstream fallback
+  uint32_t state = 0xA11CA7E5U;
+
+  {
+    engine::core::PoolResource pool(48U, 64U);
+    AllocatorChecker checker("pool", &pool);
+    for (uint32_t step = 0; step < steps; ++step) {
+      const bool allocate = checker.live_count() == 0U || next_random(&state) % 2U == 0U;
+      // Mostly block-sized requests, sometimes too large for a block.
+      const size_t bytes = next_random(&state) % 16U == 0U ? 96U : 1U + (next_random(&state) % pool.block_size());
+      const bool ok = allocate ? checker.allocate(bytes, 8U)
+                               : checker.free(next_random(&state) % checker.live_count());
+      if (!ok || !checker.verify()) {
+        return false;
+      }
+      if (pool.stats().used_bytes % pool.block_size() != 0U) {
+        return checker.fail("used bytes not a multiple of the block size");
+      }
+    }
+    while (checker.live_count() > 0U) {
+      if (!checker.free(checker.live_count() - 1U)) {
+        return false;
+      }
+    }
+    if (!checker.verify() || pool.stats().used_bytes != 0U) {
+      return checker.fail("memory still in use after freeing everything");
+    }
+  }
+
+  {
+    engine::core::ArenaResource arena(4096U);
+    AllocatorChecker checker("arena", &arena);
+    for (uint32_t step = 0; step < steps; ++step) {
+      if (next_random(&state) % 512U == 0U) {
+        if (!checker.forget_all()) {
+          return false;
+        }
+        arena.reset();
+        const engine::core::AllocatorStats stats = arena.stats();
+        if (stats.used_bytes != 0U || stats.overhead_bytes != 0U) {
+          return checker.fail("reset left memory in use");
+        }
+        continue;
+      }
+      // Occasionally larger than a chunk.
+      const size_t bytes = next_random(&state) % 64U == 0U ? 6000U : 1U + (next_random(&state) % 512U);
+      const bool ok = checker.allocate(bytes, alignments[next_random(&state) % alignments.size()]);
+      if (!ok || !checker.verify()) {
+        return false;
+      }
+    }
+  }
+
+  {
+    engine::core::TlsfResource tlsf(256U * 1024U);
+    AllocatorChecker checker("tlsf", &tlsf);
+    const engine::core::AllocatorStats empty = tlsf.stats();
+    for (uint32_t step = 0; step < steps; ++step) {
+      const bool allocate = checker.live_count() == 0U || next_random(&state) % 2U == 0U;
+      // Log-uniform sizes from a few bytes to a sixteenth of the region, so splits, merges and fallbacks happen.
+      const size_t bytes = 1U + (next_random(&state) % (size_t{1} << (2U + (next_random(&state) % 13U))));
+      const bool ok = allocate ? checker.allocate(bytes, alignments[next_random(&state) % alignments.size()])
+                               : checker.free(next_random(&state) % checker.live_count());
+      if (!ok || !checker.verify()) {
+        return false;
+      }
+    }
+    while (checker.live_count() > 0U) {
+      if (!checker.free(checker.live_count() - 1U)) {
+        return false;
+      }
+    }
+    // Everything freed must coalesce back into the single block the region started as.
+    const engine::core::AllocatorStats stats = tlsf.stats();
+    if (!checker.verify() || stats.used_bytes != 0U || stats.free_bytes != empty.free_bytes ||
+        stats.largest_free_bytes != stats.free_bytes) {
+      return checker.fail("free blocks did not coalesce after freeing everything");
+    }
+  }
+  return true;
+}
+
+// Allocates a batch of sizes and frees it in a scrambled order; the arena rewinds instead.
+void run_allocator_suite(bench::Harness& harness) {
+  constexpr size_t batch = 64U;
+  std::array<size_t, batch> sizes{};
+  std::array<size_t, batch> free_order{};
+  uint32_t state = 0x5EED5EEDU;
+  for (size_t i = 0; i < batch; ++i) {
+    sizes[i] = 16U + (next_random(&state) % 240U);
+    free_order[i] = (i * 37U) % batch;
+  }
+  std::array<void*, batch> pointers{};
+
+  const auto allocate_free = [&](std::pmr::memory_resource* resource) {
+    for (size_t i = 0; i < batch; ++i) {
+      pointers[i] = resource->allocate(sizes[i], 16U);
+    }
+    bench::do_not_optimize(pointers);
+    for (const size_t i : free_order) {
+      resource->deallocate(pointers[i], sizes[i], 16U);
+    }
+  };
+
+  harness.run("allocators", "new_delete", batch, [&] { allocate_free(std::pmr::new_delete_resource()); });
+
+  engine::core::PoolResource pool(256U);
+  harness.run("allocators", "pool", batch, [&] { allocate_free(&pool); });
+
+  engine::core::TlsfResource tlsf(1024U * 1024U);
+  harness.run("allocators", "tlsf", batch, [&] { allocate_free(&tlsf); });
+
+  engine::core::ArenaResource arena(64U * 1024U);
+  harness.run("allocators", "arena", batch, [&] {
+    allocate_free(&arena);
+    arena.reset();
+  });
+}
+
+void run_math_suite(bench::Harness& harness) {
+  constexpr size_t count = 256U;
+  std::array<engine::math::Mat4, count> matrices{};
+  std::array<engine::math::Vec3, count> vectors{};
+  uint32_t state = 0x2545F491U;
+  for (size_t i = 0; i < count; ++i) {
+    vectors[i] = {random_unit(&state) * 10.0F, random_unit(&state) * 10.0F, random_unit(&state) * 10.0F};
+    matrices[i] = engine::math::trs(vectors[i], {random_unit(&state), random_unit(&state), 0.0F}, {1.0F, 1.0F, 1.0F});
+  }
+
+  size_t i = 0;
+  harness.run("math", "mat4_multiply", 1U, [&] {
+    const engine::math::Mat4 result =
+        engine::math::multiply(matrices[i & (count - 1U)], matrices[(i + 1U) & (count - 1U)]);
+    bench::do_not_optimize(result);
+    ++i;
+  });
+  harness.run("math", "trs", 1U, [&] {
+    const engine::math::Vec3& v = vectors[i & (count - 1U)];
+    const engine::math::Mat4 result = engine::math::trs(v, v, {1.0F, 2.0F, 1.0F});
+    bench::do_not_optimize(result);
+    ++i;
+  });
+  harness.run("math", "look_at", 1U, [&] {
+    const engine::math::Mat4 result =
+        engine::math::look_at(vectors[i & (count - 1U)], vectors[(i + 7U) & (count - 1U)], {0.0F, 1.0F, 0.0F});
+    bench::do_not_optimize(result);
+    ++i;
+  });
+}
+
+void run_scene_suite(bench::Harness& harness) {
+  for (const uint32_t depth : {1U, 4U, 16U, 64U}) {
+    engine::runtime::Scene scene;
+    std::optional<uint32_t> parent;
+    engine::runtime::Entity leaf;
+    for (uint32_t level = 0; level < depth; ++level) {
+      leaf = scene.create_entity(parent);
+      engine::runtime::Transform& transform = scene.transform(leaf);
+      transform.position = {0.1F, 0.2F, 0.3F};
+      transform.rotation = {0.01F, 0.02F, 0.0F};
+      transform.mark_dirty();
+      parent = leaf.id;
+    }
+
+    harness.run("scene", "compute_world_matrix_depth_" + std::to_string(depth), 1U, [&] {
+      engine::math::Mat4 world;
+      bench::do_not_optimize(scene.compute_world_matrix(leaf, &world));
+      bench::do_not_optimize(world);
+    });
+  }
+}
+
+void run_aabb_suite(bench::Harness& harness) {
+  for (const uint32_t segments : {16U, 256U}) {
+    const engine::assets::MeshData mesh = make_sphere_mesh(segments, segments);
+    harness.run("aabb", "compute_aabb_" + std::to_string(mesh.vertices.size()), mesh.vertices.size(), [&] {
+      bench::do_not_optimize(engine::assets::compute_aabb(mesh.vertices));
+    });
+  }
+}
+
+void run_asset_suite(bench::Harness& harness) {
+  constexpr uint32_t mesh_count = 4096U;
+  engine::assets::AssetManager assets;
+  std::vector<engine::assets::MeshHandle> handles;
+  std::vector<std::string> paths;
+  std::vector<engine::core::StringId> path_ids;
+  handles.reserve(mesh_count);
+  for (uint32_t m = 0; m < mesh_count; ++m) {
+    // Distinct contents, so nothing is deduplicated.
+    engine::assets::MeshData mesh{};
+    mesh.vertices = {{{static_cast<float>(m), 0.0F, 0.0F}}, {{0.0F, 1.0F, 0.0F}}, {{0.0F, 0.0F, 1.0F}}};
+    mesh.indices = {0U, 1U, 2U};
+    mesh.bounds = engine::assets::compute_aabb(mesh.vertices);
+    paths.push_back("bench/mesh_" + std::to_string(m) + ".gltf");
+    handles.push_back(assets.create_mesh(paths.back(), std::move(mesh)));
+    path_ids.push_back(engine::core::intern(paths.back()));
+  }
+
+  std::vector<uint32_t> order(1024U);
+  uint32_t state = 0x9E3779B9U;
+  for (uint32_t& index : order) {
+    index = next_random(&state) % mesh_count;
+  }
+
+  size_t i = 0;
+  harness.run("assets", "get_mesh", 1U, [&] {
+    bench::do_not_optimize(assets.get_mesh(handles[order[i++ & (order.size() - 1U)]]));
+  });
+  // Interning on every call, as a caller that does not keep the id would.
+  harness.run("assets", "load_mesh_cached_path", 1U, [&] {
+    const engine::core::StringId path = engine::core::intern(paths[order[i++ & (order.size() - 1U)]]);
+    const engine::assets::MeshHandle handle = assets.load_mesh(path);
+    assets.release_mesh(handle);
+  });
+  harness.run("assets", "load_mesh_cached_id", 1U, [&] {
+    const engine::assets::MeshHandle handle = assets.load_mesh(path_ids[order[i++ & (order.size() - 1U)]]);
+    assets.release_mesh(handle);
+  });
+}
+
+void run_gltf_suite(bench::Harness& harness) {
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "engine_bench_mesh.gltf";
+  {
+    std::ofstream out(path, std::ios::trunc);
+    out << R"({"asset": {"version": "2.0"}, "scene": 0, "scenes": [{"nodes": [0]}], )"
+        << R"("nodes": [{"mesh": 0}], "meshes": [{"name": "BenchMesh"}]})";
+  }
+
+  const std::string path_text = path.string();
+  harness.run("gltf", "load", 1U, [&] {
+    const engine::assets::GltfLoadResult result = engine::assets::GltfLoader::load(path_text);
+    bench::do_not_optimize(result.meshes.size());
+  });
+
+  std::filesystem::remove(path);
+}
+
+// Swallows console output so logger throughput is not bounded by the terminal.
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(const int c) override { return c; }
+  std::streamsize xsputn(const char* /*s*/, const std::streamsize count) override { return count; }
+};
+
+void run_logger_suite(bench::Harness& harness) {
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "engine_bench_log.txt";
+  NullBuffer null_buffer;
+  std::streambuf* console = std::cout.rdbuf(&null_buffer);
+  {
+    engine::core::Logger logger(path.string());
+    harness.run("logger", "info", 1U, [&] { logger.info("Loaded mesh from path: assets/models/m2-triangle.gltf"); });
+  }
+  std::cout.rdbuf(console);
+  std::filesystem::remove(path);
+}
+
+void run_renderer_suite(bench::Harness& harness) {
+  const engine::math::Mat4 mvp = engine::math::multiply(
+      engine::math::perspective(1.0F, 16.0F / 9.0F, 0.1F, 100.0F),
+      engine::math::look_at({0.0F, 1.0F, 6.0F}, {0.0F, 0.0F, 0.0F}, {0.0F, 1.0F, 0.0F}));
+
+  for (const uint32_t segments : {16U, 256U}) {
+    const engine::assets::MeshData mesh = make_sphere_mesh(segments, segments);
+    std::vector<engine::renderer::ScreenVertex> projected(mesh.vertices.size());
+    harness.run("renderer", "project_vertices_" + std::to_string(mesh.vertices.size()), mesh.vertices.size(), [&] {
+      engine::renderer::project_vertices(
+          &mesh.vertices[0].position, mesh.vertices.size(), mvp, 1280, 720, projected.data());
+      bench::do_not_optimize(projected.data());
+    });
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  bench::HarnessOptions options;
+  if (std::string error; !bench::parse_harness_args(argc, argv, &options, &error)) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+  bench::Harness harness(options);
+
+  if (harness.suite_enabled("math")) {
+    run_math_suite(harness);
+  }
+  if (harness.suite_enabled("scene")) {
+    run_scene_suite(harness);
+  }
+  if (harness.suite_enabled("aabb")) {
+    run_aabb_suite(harness);
+  }
+  if (harness.suite_enabled("assets")) {
+    run_asset_suite(harness);
+  }
+  if (harness.suite_enabled("gltf")) {
+    run_gltf_suite(harness);
+  }
+  if (harness.suite_enabled("logger")) {
+    run_logger_suite(harness);
+  }
+  if (harness.suite_enabled("renderer")) {
+    run_renderer_suite(harness);
+  }
+  bool self_check_passed = true;
+  if (harness.suite_enabled("allocators")) {
+    self_check_passed = options.list_only || check_allocators();
+    run_allocator_suite(harness);
+  }
+
+  if (harness.suite_enabled("quantization")) {
+    run_quantization_suite(harness);
+  }
+  if (harness.suite_enabled("slot_map")) {
+    run_slot_map_suite(harness);
+  }
+  if (harness.suite_enabled("lod_generation")) {
+    run_lod_generation_suite(harness);
+  }
+
+  if (options.list_only) {
+    for (const std::string& suite : harness.seen_suites()) {
+      std::printf("%s\n", suite.c_str());
+    }
+    return 0;
+  }
+
+  if (std::string error; !harness.write_json(&error)) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+  std::printf("wrote %zu results to %s\n", harness.results().size(), options.output_path.c_str());
+  return self_check_passed ? 0 : 1;
+}
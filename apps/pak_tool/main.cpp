@@ -0,0 +1,167 @@
+#include "engine/io/pak_archive.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+void print_usage() {
+  std::fprintf(stderr,
+               "usage:\n"
+               "  pak_tool pack <out.pak> <directory> [--compress none|lz4|zstd] [--align N] [--prefix P]\n"
+               "  pak_tool list <archive.pak>\n");
+}
+
+bool parse_compression(const std::string_view name, engine::io::PakCompression* out) {
+  if (name == "none") {
+    *out = engine::io::PakCompression::None;
+  } else if (name == "lz4") {
+    *out = engine::io::PakCompression::Lz4;
+  } else if (name == "zstd") {
+    *out = engine::io::PakCompression::Zstd;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool read_file(const std::filesystem::path& path, std::vector<uint8_t>* out_bytes) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  out_bytes->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return true;
+}
+
+int run_pack(const int argc, char** argv) {
+  if (argc < 4) {
+    print_usage();
+    return 1;
+  }
+
+  const std::string out_path = argv[2];
+  const std::filesystem::path root = argv[3];
+  engine::io::PakCompression compression = engine::io::PakCompression::None;
+  uint32_t alignment = 16U;
+  std::string prefix;
+
+  for (int i = 4; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg == "--compress" && i + 1 < argc) {
+      if (!parse_compression(argv[++i], &compression)) {
+        std::fprintf(stderr, "unknown compression '%s'\n", argv[i]);
+        return 1;
+      }
+    } else if (arg == "--align" && i + 1 < argc) {
+      alignment = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--prefix" && i + 1 < argc) {
+      prefix = argv[++i];
+    } else {
+      print_usage();
+      return 1;
+    }
+  }
+
+  if (!engine::io::pak_compression_supported(compression)) {
+    std::fprintf(stderr,
+                 "warning: %s support not compiled in, storing entries uncompressed\n",
+                 engine::io::pak_compression_name(compression));
+  }
+
+  std::error_code ec;
+  if (!std::filesystem::is_directory(root, ec)) {
+    std::fprintf(stderr, "not a directory: %s\n", root.string().c_str());
+    return 1;
+  }
+
+  engine::io::PakWriter writer(alignment);
+  uint64_t input_bytes = 0;
+  std::vector<uint8_t> bytes;
+  for (auto it = std::filesystem::recursive_directory_iterator(root, ec);
+       !ec && it != std::filesystem::recursive_directory_iterator();
+       it.increment(ec)) {
+    if (!it->is_regular_file(ec)) {
+      continue;
+    }
+
+    if (!read_file(it->path(), &bytes)) {
+      std::fprintf(stderr, "failed to read %s\n", it->path().string().c_str());
+      return 1;
+    }
+
+    std::filesystem::path virtual_path = std::filesystem::path(prefix) / it->path().lexically_relative(root);
+    std::string error;
+    if (!writer.add_file(virtual_path.generic_string(), bytes, compression, &error)) {
+      std::fprintf(stderr, "%s\n", error.c_str());
+      return 1;
+    }
+    input_bytes += bytes.size();
+  }
+
+  std::string error;
+  if (!writer.write(out_path, &error)) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+
+  std::printf("packed %zu files (%llu bytes) into %s (%llu bytes)\n",
+              writer.entry_count(),
+              static_cast<unsigned long long>(input_bytes),
+              out_path.c_str(),
+              static_cast<unsigned long long>(std::filesystem::file_size(out_path, ec)));
+  return 0;
+}
+
+int run_list(const int argc, char** argv) {
+  if (argc < 3) {
+    print_usage();
+    return 1;
+  }
+
+  engine::io::PakArchive archive;
+  std::string error;
+  if (!archive.open(argv[2], &error)) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+
+  for (const engine::io::PakEntry& entry : archive.entries()) {
+    const std::string_view name = archive.entry_name(entry);
+    std::printf("%016llx %10llu %10llu %-5s %.*s\n",
+                static_cast<unsigned long long>(entry.path_hash),
+                static_cast<unsigned long long>(entry.size),
+                static_cast<unsigned long long>(entry.stored_size),
+                engine::io::pak_compression_name(static_cast<engine::io::PakCompression>(entry.compression)),
+                static_cast<int>(name.size()),
+                name.data());
+  }
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    print_usage();
+    return 1;
+  }
+
+  const std::string_view command = argv[1];
+  if (command == "pack") {
+    return run_pack(argc, argv);
+  }
+  if (command == "list") {
+    return run_list(argc, argv);
+  }
+
+  print_usage();
+  return 1;
+}
@@ -0,0 +1,283 @@
+#include "engine/renderer/basic_renderer.h"
+#include "engine/renderer/render_capture.h"
+#include "engine/renderer/render_stats.h"
+#include "engine/runtime/camera.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void print_usage() {
+  std::fprintf(stderr,
+               "usage:\n"
+               "  render_replay <capture.rcap> [--backend software|bgfx-noop] [--iterations N] [--warmup N]\n"
+               "                [--output report.json]\n");
+}
+
+bool parse_backend(const std::string_view name, engine::renderer::HeadlessBackend* out) {
+  if (name == "software") {
+    *out = engine::renderer::HeadlessBackend::Software;
+  } else if (name == "bgfx-noop") {
+    *out = engine::renderer::HeadlessBackend::BgfxNoop;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+struct Summary {
+  double min_ms = 0.0;
+  double avg_ms = 0.0;
+  double p50_ms = 0.0;
+  double p95_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+Summary summarize(std::vector<double> samples_ms) {
+  Summary summary;
+  if (samples_ms.empty()) {
+    return summary;
+  }
+  std::sort(samples_ms.begin(), samples_ms.end());
+  double total_ms = 0.0;
+  for (const double sample : samples_ms) {
+    total_ms += sample;
+  }
+  const auto percentile = [&samples_ms](const double p) {
+    return samples_ms[static_cast<size_t>(p * static_cast<double>(samples_ms.size() - 1U))];
+  };
+  summary.min_ms = samples_ms.front();
+  summary.avg_ms = total_ms / static_cast<double>(samples_ms.size());
+  summary.p50_ms = percentile(0.50);
+  summary.p95_ms = percentile(0.95);
+  summary.max_ms = samples_ms.back();
+  return summary;
+}
+
+void print_summary(const char* name, const Summary& summary) {
+  std::printf("%-12s min=%9.4f ms  avg=%9.4f ms  p50=%9.4f ms  p95=%9.4f ms  max=%9.4f ms\n",
+              name,
+              summary.min_ms,
+              summary.avg_ms,
+              summary.p50_ms,
+              summary.p95_ms,
+              summary.max_ms);
+}
+
+void write_summary(std::FILE* file, const char* name, const Summary& summary, const bool last) {
+  std::fprintf(file,
+               "    \"%s\": {\"min_ms\": %.4f, \"avg_ms\": %.4f, \"p50_ms\": %.4f, \"p95_ms\": %.4f, "
+               "\"max_ms\": %.4f}%s\n",
+               name,
+               summary.min_ms,
+               summary.avg_ms,
+               summary.p50_ms,
+               summary.p95_ms,
+               summary.max_ms,
+               last ? "" : ",");
+}
+
+// Runs every captured frame once; frame times go to out_frame_ms when it is set.
+void replay_once(const engine::renderer::RenderCapture& capture,
+                 const std::vector<engine::runtime::Camera>& cameras,
+                 engine::renderer::BasicRenderer* renderer,
+                 std::vector<double>* out_frame_ms,
+                 std::array<engine::renderer::RenderPassStats, engine::renderer::render_pass_count>* out_totals) {
+  int width = 0;
+  int height = 0;
+  for (size_t f = 0; f < capture.frame_count(); ++f) {
+    const engine::renderer::CapturedFrame& frame = capture.frame(f);
+    const Clock::time_point start = Clock::now();
+    renderer->begin_frame(frame.clear_color);
+    renderer->add_culled(frame.culled);
+    for (const engine::renderer::CapturedDraw& draw : capture.draws(frame)) {
+      const engine::runtime::Camera& camera = cameras[draw.camera];
+      if (camera.viewport_width() != width || camera.viewport_height() != height) {
+        width = camera.viewport_width();
+        height = camera.viewport_height();
+        renderer->resize(width, height);
+      }
+      renderer->submit_mesh(capture.mesh(draw.mesh), draw.world, camera, draw.lod);
+    }
+    renderer->end_frame();
+
+    if (out_frame_ms != nullptr) {
+      out_frame_ms->push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+      const engine::renderer::RenderStats& stats = renderer->last_frame_stats();
+      for (size_t i = 0; i < engine::renderer::render_pass_count; ++i) {
+        (*out_totals)[i].accumulate(stats.passes[i]);
+      }
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    print_usage();
+    return 1;
+  }
+
+  const std::string capture_path = argv[1];
+  engine::renderer::HeadlessBackend backend = engine::renderer::HeadlessBackend::Software;
+  std::string backend_name = "software";
+  uint32_t iterations = 10U;
+  uint32_t warmup = 1U;
+  std::string output_path;
+  for (int i = 2; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg == "--backend" && i + 1 < argc) {
+      backend_name = argv[++i];
+      if (!parse_backend(backend_name, &backend)) {
+        std::fprintf(stderr, "unknown backend '%s'\n", backend_name.c_str());
+        return 1;
+      }
+    } else if (arg == "--iterations" && i + 1 < argc) {
+      iterations = std::max(1U, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+    } else if (arg == "--warmup" && i + 1 < argc) {
+      warmup = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else if (arg == "--output" && i + 1 < argc) {
+      output_path = argv[++i];
+    } else {
+      print_usage();
+      return 1;
+    }
+  }
+
+  engine::renderer::RenderCapture capture;
+  std::string error;
+  if (!capture.load(capture_path, &error)) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+  if (capture.frame_count() == 0U) {
+    std::fprintf(stderr, "capture has no frames: %s\n", capture_path.c_str());
+    return 1;
+  }
+
+  // Rebuilt once so the timed loop only measures the renderer.
+  std::vector<engine::runtime::Camera> cameras;
+  cameras.reserve(capture.camera_count());
+  for (uint32_t c = 0; c < capture.camera_count(); ++c) {
+    cameras.push_back(capture.make_camera(c));
+  }
+
+  const int width = !cameras.empty() ? cameras.front().viewport_width() : 1280;
+  const int height = !cameras.empty() ? cameras.front().viewport_height() : 720;
+  engine::renderer::BasicRenderer renderer;
+  if (!renderer.init_headless(width, height, backend)) {
+    std::fprintf(stderr, "backend '%s' is not available in this build\n", backend_name.c_str());
+    return 1;
+  }
+
+  std::printf("%s: %zu frames, %zu draws, %zu meshes; backend %s, %u iterations (+%u warm-up)\n",
+              capture_path.c_str(),
+              capture.frame_count(),
+              capture.draw_count(),
+              capture.mesh_count(),
+              backend_name.c_str(),
+              iterations,
+              warmup);
+
+  for (uint32_t i = 0; i < warmup; ++i) {
+    replay_once(capture, cameras, &renderer, nullptr, nullptr);
+  }
+
+  std::vector<double> frame_ms;
+  frame_ms.reserve(capture.frame_count() * iterations);
+  std::vector<double> iteration_ms;
+  std::array<engine::renderer::RenderPassStats, engine::renderer::render_pass_count> pass_totals{};
+  for (uint32_t i = 0; i < iterations; ++i) {
+    const Clock::time_point start = Clock::now();
+    replay_once(capture, cameras, &renderer, &frame_ms, &pass_totals);
+    iteration_ms.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+  }
+  const engine::renderer::FrameAllocatorStats frame_memory = renderer.frame_allocator().stats();
+  renderer.shutdown();
+
+  const Summary iteration_summary = summarize(iteration_ms);
+  const Summary frame_summary = summarize(frame_ms);
+  const double frames = static_cast<double>(frame_ms.size());
+  print_summary("iteration", iteration_summary);
+  print_summary("frame", frame_summary);
+  for (size_t i = 0; i < engine::renderer::render_pass_count; ++i) {
+    const engine::renderer::RenderPassStats& pass = pass_totals[i];
+    std::printf("%-12s %.1f draws, %.1f tris, %.1f verts, %.1f culled, %.1f KB uploaded, %.4f ms cpu per frame\n",
+                engine::renderer::render_pass_name(static_cast<engine::renderer::RenderPass>(i)),
+                static_cast<double>(pass.draws) / frames,
+                static_cast<double>(pass.triangles) / frames,
+                static_cast<double>(pass.vertices) / frames,
+                static_cast<double>(pass.culled) / frames,
+                static_cast<double>(pass.bytes_uploaded) / 1024.0 / frames,
+                pass.cpu_ms / frames);
+  }
+
+  std::printf("frame memory peak %.1f of %.1f KB per frame, %llu overflows\n",
+              static_cast<double>(frame_memory.peak_used_bytes) / 1024.0,
+              static_cast<double>(frame_memory.capacity_bytes) / 1024.0,
+              static_cast<unsigned long long>(frame_memory.total_overflows));
+
+  if (output_path.empty()) {
+    return 0;
+  }
+  std::FILE* file = std::fopen(output_path.c_str(), "w");
+  if (file == nullptr) {
+    std::fprintf(stderr, "failed to create report: %s\n", output_path.c_str());
+    return 1;
+  }
+  std::fprintf(file, "{\n");
+  std::fprintf(file,
+               "  \"capture\": {\"frames\": %zu, \"draws\": %zu, \"meshes\": %zu},\n",
+               capture.frame_count(),
+               capture.draw_count(),
+               capture.mesh_count());
+  std::fprintf(file, "  \"backend\": \"%s\",\n", backend_name.c_str());
+  std::fprintf(file, "  \"iterations\": %u,\n", iterations);
+  std::fprintf(file, "  \"timings\": {\n");
+  write_summary(file, "iteration", iteration_summary, false);
+  write_summary(file, "frame", frame_summary, true);
+  std::fprintf(file, "  },\n");
+  std::fprintf(file, "  \"passes\": {\n");
+  for (size_t i = 0; i < engine::renderer::render_pass_count; ++i) {
+    const engine::renderer::RenderPassStats& pass = pass_totals[i];
+    std::fprintf(file,
+                 "    \"%s\": {\"draws_per_frame\": %.1f, \"triangles_per_frame\": %.1f, "
+                 "\"vertices_per_frame\": %.1f, \"culled_per_frame\": %.1f, \"bytes_uploaded_per_frame\": %.1f, "
+                 "\"state_changes_per_frame\": %.1f, \"cpu_ms_per_frame\": %.4f}%s\n",
+                 engine::renderer::render_pass_name(static_cast<engine::renderer::RenderPass>(i)),
+                 static_cast<double>(pass.draws) / frames,
+                 static_cast<double>(pass.triangles) / frames,
+                 static_cast<double>(pass.vertices) / frames,
+                 static_cast<double>(pass.culled) / frames,
+                 static_cast<double>(pass.bytes_uploaded) / frames,
+                 static_cast<double>(pass.state_changes) / frames,
+                 pass.cpu_ms / frames,
+                 i + 1U < engine::renderer::render_pass_count ? "," : "");
+  }
+  std::fprintf(file, "  },\n");
+  std::fprintf(file,
+               "  \"frame_memory\": {\"capacity_bytes\": %u, \"peak_used_bytes\": %u, \"overflows\": %llu}\n",
+               frame_memory.capacity_bytes,
+               frame_memory.peak_used_bytes,
+               static_cast<unsigned long long>(frame_memory.total_overflows));
+  std::fprintf(file, "}\n");
+  const bool ok = std::ferror(file) == 0;
+  std::fclose(file);
+  if (!ok) {
+    std::fprintf(stderr, "failed to write report: %s\n", output_path.c_str());
+    return 1;
+  }
+  std::printf("wrote %s\n", output_path.c_str());
+  return 0;
+}
@@ -0,0 +1,255 @@
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string_view>
+
+namespace sandbox {
+
+namespace {
+
+constexpr const char* phase_names[benchmark_phase_count] = {
+    "events",
+    "simulation",
+    "draw_collection",
+    "occlusion",
+    "visibility",
+    "render",
+};
+
+bool parse_unsigned(const std::string_view text, uint32_t* out_value) {
+  const std::string value(text);
+  char* end = nullptr;
+  const unsigned long parsed = std::strtoul(value.c_str(), &end, 10);
+  if (value.empty() || *end != '\0') {
+    return false;
+  }
+  *out_value = static_cast<uint32_t>(parsed);
+  return true;
+}
+
+bool parse_float(const std::string_view text, float* out_value) {
+  const std::string value(text);
+  char* end = nullptr;
+  const float parsed = std::strtof(value.c_str(), &end);
+  if (value.empty() || *end != '\0') {
+    return false;
+  }
+  *out_value = parsed;
+  return true;
+}
+
+void write_summary(std::FILE* file, const char* name, const TimingSummary& summary, const bool last) {
+  std::fprintf(file,
+               "    \"%s\": {\"avg_ms\": %.4f, \"p50_ms\": %.4f, \"p95_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f}%s\n",
+               name,
+               summary.avg_ms,
+               summary.p50_ms,
+               summary.p95_ms,
+               summary.p99_ms,
+               summary.max_ms,
+               last ? "" : ",");
+}
+
+} // namespace
+
+bool parse_benchmark_args(const int argc, char** argv, BenchmarkOptions* out_options, std::string* out_error) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg(argv[i]);
+    const size_t equals = arg.find('=');
+    const std::string_view name = arg.substr(0, equals);
+    const std::string_view value = equals == std::string_view::npos ? std::string_view{} : arg.substr(equals + 1U);
+
+    bool ok = true;
+    if (name == "--benchmark") {
+      ok = equals == std::string_view::npos;
+    } else if (name == "--entities") {
+      ok = parse_unsigned(value, &out_options->scene.entity_count);
+    } else if (name == "--depth") {
+      ok = parse_unsigned(value, &out_options->scene.hierarchy_depth);
+    } else if (name == "--meshes") {
+      ok = parse_unsigned(value, &out_options->scene.mesh_variety);
+    } else if (name == "--moving") {
+      ok = parse_float(value, &out_options->scene.moving_fraction);
+    } else if (name == "--frames") {
+      ok = parse_unsigned(value, &out_options->frames) && out_options->frames > 0U;
+    } else if (name == "--output") {
+      out_options->output_path = std::string(value);
+      ok = !value.empty();
+    } else {
+      if (out_error != nullptr) {
+        *out_error = "Unknown argument: " + std::string(arg);
+      }
+      return false;
+    }
+
+    if (!ok) {
+      if (out_error != nullptr) {
+        *out_error = "Invalid value for " + std::string(name) + ": '" + std::string(value) + "'";
+      }
+      return false;
+    }
+    out_options->enabled = true;
+  }
+  return true;
+}
+
+TimingSummary summarize_timings(std::vector<double> samples_ms) {
+  TimingSummary summary;
+  if (samples_ms.empty()) {
+    return summary;
+  }
+
+  std::sort(samples_ms.begin(), samples_ms.end());
+  double total_ms = 0.0;
+  for (const double sample : samples_ms) {
+    total_ms += sample;
+  }
+  const auto percentile = [&samples_ms](const double p) {
+    return samples_ms[static_cast<size_t>(p * static_cast<double>(samples_ms.size() - 1U))];
+  };
+  summary.avg_ms = total_ms / static_cast<double>(samples_ms.size());
+  summary.p50_ms = percentile(0.50);
+  summary.p95_ms = percentile(0.95);
+  summary.p99_ms = percentile(0.99);
+  summary.max_ms = samples_ms.back();
+  return summary;
+}
+
+ProcessMemory query_process_memory() {
+  ProcessMemory memory;
+#if defined(__linux__)
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    const auto kilobytes = [&line] { return static_cast<size_t>(std::strtoull(line.c_str() + 6, nullptr, 10)) * 1024U; };
+    if (line.starts_with("VmRSS:")) {
+      memory.resident_bytes = kilobytes();
+    } else if (line.starts_with("VmHWM:")) {
+      memory.peak_resident_bytes = kilobytes();
+    }
+  }
+#endif
+  return memory;
+}
+
+BenchmarkRecorder::BenchmarkRecorder(const uint32_t frames) {
+  for (std::vector<double>& samples : phase_ms_) {
+    samples.reserve(frames);
+  }
+  frame_ms_.reserve(frames);
+  render_begin_ms_.reserve(frames);
+  render_submit_ms_.reserve(frames);
+  render_end_ms_.reserve(frames);
+}
+
+void BenchmarkRecorder::begin_frame() {
+  current_ms_.fill(0.0);
+  frame_start_ = clock::now();
+  last_mark_ = frame_start_;
+}
+
+void BenchmarkRecorder::mark(const BenchmarkPhase phase) {
+  const clock::time_point now = clock::now();
+  current_ms_[static_cast<size_t>(phase)] += std::chrono::duration<double, std::milli>(now - last_mark_).count();
+  last_mark_ = now;
+}
+
+void BenchmarkRecorder::end_frame(const uint32_t draw_count, const engine::renderer::RenderStats& render_stats) {
+  for (size_t i = 0; i < benchmark_phase_count; ++i) {
+    phase_ms_[i].push_back(current_ms_[i]);
+  }
+  frame_ms_.push_back(std::chrono::duration<double, std::milli>(clock::now() - frame_start_).count());
+  draw_total_ += draw_count;
+  for (size_t i = 0; i < engine::renderer::render_pass_count; ++i) {
+    render_pass_totals_[i].accumulate(render_stats.passes[i]);
+  }
+  render_begin_ms_.push_back(render_stats.begin_ms);
+  render_submit_ms_.push_back(render_stats.submit_ms);
+  render_end_ms_.push_back(render_stats.end_ms);
+}
+
+uint32_t BenchmarkRecorder::frames_recorded() const {
+  return static_cast<uint32_t>(frame_ms_.size());
+}
+
+bool BenchmarkRecorder::write_json(const std::string& path,
+                                   const BenchmarkOptions& options,
+                                   const BenchmarkSetup& setup,
+                                   const engine::assets::AssetStats& asset_stats,
+                                   std::string* out_error) const {
+  std::FILE* file = std::fopen(path.c_str(), "w");
+  if (file == nullptr) {
+    if (out_error != nullptr) {
+      *out_error = "Failed to create benchmark report: " + path;
+    }
+    return false;
+  }
+
+  const ProcessMemory memory = query_process_memory();
+  const double frames = std::max(1.0, static_cast<double>(frame_ms_.size()));
+
+  std::fprintf(file, "{\n");
+  std::fprintf(file,
+               "  \"scene\": {\"entities\": %u, \"chains\": %u, \"hierarchy_depth\": %u, \"meshes\": %u, "
+               "\"moving_fraction\": %.4f, \"moving_chains\": %u},\n",
+               setup.entity_count,
+               setup.chain_count,
+               options.scene.hierarchy_depth,
+               setup.mesh_count,
+               static_cast<double>(options.scene.moving_fraction),
+               setup.moving_chains);
+  std::fprintf(file, "  \"frames\": %u,\n", frames_recorded());
+  std::fprintf(file, "  \"scene_build_ms\": %.3f,\n", setup.scene_build_ms);
+  std::fprintf(file, "  \"draws_per_frame\": %.1f,\n", static_cast<double>(draw_total_) / frames);
+  std::fprintf(file, "  \"phases\": {\n");
+  for (size_t i = 0; i < benchmark_phase_count; ++i) {
+    write_summary(file, phase_names[i], summarize_timings(phase_ms_[i]), false);
+  }
+  write_summary(file, "frame", summarize_timings(frame_ms_), true);
+  std::fprintf(file, "  },\n");
+  std::fprintf(file, "  \"render\": {\n");
+  std::fprintf(file, "    \"passes\": {\n");
+  for (size_t i = 0; i < engine::renderer::render_pass_count; ++i) {
+    const engine::renderer::RenderPassStats& pass = render_pass_totals_[i];
+    std::fprintf(file,
+                 "      \"%s\": {\"draws_per_frame\": %.1f, \"instances_per_frame\": %.1f, "
+                 "\"triangles_per_frame\": %.1f, \"vertices_per_frame\": %.1f, \"culled_per_frame\": %.1f, "
+                 "\"bytes_uploaded_per_frame\": %.1f, \"state_changes_per_frame\": %.1f, "
+                 "\"cpu_ms_per_frame\": %.4f}%s\n",
+                 engine::renderer::render_pass_name(static_cast<engine::renderer::RenderPass>(i)),
+                 static_cast<double>(pass.draws) / frames,
+                 static_cast<double>(pass.instances) / frames,
+                 static_cast<double>(pass.triangles) / frames,
+                 static_cast<double>(pass.vertices) / frames,
+                 static_cast<double>(pass.culled) / frames,
+                 static_cast<double>(pass.bytes_uploaded) / frames,
+                 static_cast<double>(pass.state_changes) / frames,
+                 pass.cpu_ms / frames,
+                 i + 1U < engine::renderer::render_pass_count ? "," : "");
+  }
+  std::fprintf(file, "    },\n");
+  write_summary(file, "cpu_begin", summarize_timings(render_begin_ms_), false);
+  write_summary(file, "cpu_submit", summarize_timings(render_submit_ms_), false);
+  write_summary(file, "cpu_end", summarize_timings(render_end_ms_), true);
+  std::fprintf(file, "  },\n");
+  std::fprintf(file,
+               "  \"memory\": {\"process_resident_bytes\": %zu, \"process_peak_bytes\": %zu, "
+               "\"asset_resident_bytes\": %zu, \"asset_peak_bytes\": %zu}\n",
+               memory.resident_bytes,
+               memory.peak_resident_bytes,
+               asset_stats.resident_bytes,
+               asset_stats.peak_resident_bytes);
+  std::fprintf(file, "}\n");
+
+  const bool ok = std::ferror(file) == 0;
+  std::fclose(file);
+  if (!ok && out_error != nullptr) {
+    *out_error = "Failed to write benchmark report: " + path;
+  }
+  return ok;
+}
+
+} // namespace sandbox
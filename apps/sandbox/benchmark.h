@@ -0,0 +1,100 @@
+#pragma once
+
+#include "stress_scene.h"
+
+#include "engine/assets/asset_manager.h"
+#include "engine/renderer/render_stats.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sandbox {
+
+struct BenchmarkOptions {
+  bool enabled = false;
+  uint32_t frames = 600U;
+  std::string output_path = "benchmark.json";
+  StressSceneOptions scene;
+};
+
+// Recognizes --benchmark, --entities=N, --depth=N, --meshes=N, --moving=F, --frames=N and
+// --output=PATH; any of the scene or output flags also enables benchmark mode.
+bool parse_benchmark_args(int argc, char** argv, BenchmarkOptions* out_options, std::string* out_error);
+
+struct TimingSummary {
+  double avg_ms = 0.0;
+  double p50_ms = 0.0;
+  double p95_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+TimingSummary summarize_timings(std::vector<double> samples_ms);
+
+// Process-wide resident memory; zero where the platform does not report it.
+struct ProcessMemory {
+  size_t resident_bytes = 0;
+  size_t peak_resident_bytes = 0;
+};
+
+ProcessMemory query_process_memory();
+
+enum class BenchmarkPhase : uint8_t {
+  Events,
+  Simulation,
+  DrawCollection,
+  Occlusion,
+  Visibility,
+  Render,
+  Count, // not a phase; keep last
+};
+
+inline constexpr size_t benchmark_phase_count = static_cast<size_t>(BenchmarkPhase::Count);
+
+struct BenchmarkSetup {
+  double scene_build_ms = 0.0;
+  uint32_t entity_count = 0;
+  uint32_t chain_count = 0;
+  uint32_t moving_chains = 0;
+  uint32_t mesh_count = 0;
+};
+
+// Collects per-phase wall time for every frame. Phases are marked in order;
+// each mark charges the time since the previous one.
+class BenchmarkRecorder {
+public:
+  explicit BenchmarkRecorder(uint32_t frames);
+
+  void begin_frame();
+  void mark(BenchmarkPhase phase);
+  // render_stats is the renderer's last completed frame.
+  void end_frame(uint32_t draw_count, const engine::renderer::RenderStats& render_stats);
+
+  uint32_t frames_recorded() const;
+
+  bool write_json(const std::string& path,
+                  const BenchmarkOptions& options,
+                  const BenchmarkSetup& setup,
+                  const engine::assets::AssetStats& asset_stats,
+                  std::string* out_error = nullptr) const;
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  std::array<std::vector<double>, benchmark_phase_count> phase_ms_;
+  std::array<double, benchmark_phase_count> current_ms_{};
+  std::vector<double> frame_ms_;
+  uint64_t draw_total_ = 0;
+  std::array<engine::renderer::RenderPassStats, engine::renderer::render_pass_count> render_pass_totals_{};
+  std::vector<double> render_begin_ms_;
+  std::vector<double> render_submit_ms_;
+  std::vector<double> render_end_ms_;
+  clock::time_point frame_start_;
+  clock::time_point last_mark_;
+};
+
+} // namespace sandbox
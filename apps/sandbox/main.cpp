@@ -1,13 +1,33 @@
 #include "engine/assets/asset_manager.h"
+#include "engine/assets/hot_reloader.h"
 #include "engine/core/logger.h"
+#include "engine/core/memory_tracker.h"
+#include "engine/core/string_id.h"
+#include "engine/core/thread_pool.h"
 #include "engine/engine.h"
+#include "engine/input/input_event.h"
+#include "engine/input/input_latency.h"
+#include "engine/input/input_recording.h"
 #include "engine/input/input_state.h"
+#include "engine/io/async_file_io.h"
+#include "engine/io/vfs.h"
 #include "engine/math/mat4.h"
 #include "engine/renderer/basic_renderer.h"
+#include "engine/renderer/frame_packet.h"
+#include "engine/renderer/occlusion_culler.h"
+#include "engine/renderer/render_capture.h"
+#include "engine/renderer/render_thread.h"
 #include "engine/runtime/camera.h"
+#include "engine/runtime/lod_selector.h"
 #include "engine/runtime/scene.h"
+#include "engine/runtime/static_draw_cache.h"
+#include "engine/time/fixed_timestep.h"
+#include "engine/time/frame_pacer.h"
 #include "engine/time/frame_timer.h"
 
+#include "benchmark.h"
+#include "stress_scene.h"
+
 #include "SDL.h"
 #include "SDL_syswm.h"
 
@@ -15,8 +35,15 @@
 #include <bgfx/bgfx.h>
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -51,6 +78,53 @@ engine::input::Key map_sdl_key(const SDL_Keycode keycode) {
   }
 }
 
+// Rebases an SDL event timestamp (SDL_GetTicks() milliseconds) onto event_clock_ns().
+uint64_t sdl_event_time_ns(const Uint32 timestamp_ms) {
+  const uint64_t now_ns = engine::input::event_clock_ns();
+  if (timestamp_ms == 0U) {
+    return now_ns;
+  }
+  // Unsigned subtraction keeps the age right across the 49-day tick wrap.
+  const uint64_t age_ns = static_cast<uint64_t>(SDL_GetTicks() - timestamp_ms) * 1000000ULL;
+  return age_ns < now_ns ? now_ns - age_ns : now_ns;
+}
+
+// SDL event watch. It runs on the main thread whenever SDL pumps the window system and queues an
+// event; the event keeps SDL's own timestamp, taken at that point, with millisecond resolution.
+// The frame pacer pumps between its sleep slices, so events that arrive while it waits are stamped
+// within about a slice of arrival instead of at the next SDL_PollEvent.
+int capture_input_event(void* userdata, SDL_Event* event) {
+  auto* ring = static_cast<engine::input::InputEventRing*>(userdata);
+  engine::input::InputEvent input_event;
+  input_event.timestamp_ns = sdl_event_time_ns(event->common.timestamp);
+  switch (event->type) {
+  case SDL_KEYDOWN:
+    if (event->key.repeat != 0) {
+      return 0;
+    }
+    input_event.type = engine::input::InputEventType::KeyDown;
+    input_event.key = map_sdl_key(event->key.keysym.sym);
+    break;
+  case SDL_KEYUP:
+    input_event.type = engine::input::InputEventType::KeyUp;
+    input_event.key = map_sdl_key(event->key.keysym.sym);
+    break;
+  case SDL_MOUSEMOTION:
+    input_event.type = engine::input::InputEventType::MouseMove;
+    input_event.x = static_cast<float>(event->motion.x);
+    input_event.y = static_cast<float>(event->motion.y);
+    break;
+  case SDL_MOUSEWHEEL:
+    input_event.type = engine::input::InputEventType::Scroll;
+    input_event.y = static_cast<float>(event->wheel.preciseY);
+    break;
+  default:
+    return 0;
+  }
+  ring->push(input_event);
+  return 0;
+}
+
 engine::renderer::NativeWindowData query_native_window_data(SDL_Window* window, engine::core::Logger& logger) {
   engine::renderer::NativeWindowData data{};
   data.sdl_window = window;
@@ -93,13 +167,11 @@ engine::renderer::NativeWindowData query_native_window_data(SDL_Window* window,
   return data;
 }
 
-void draw_overlay(const engine::time::FrameMetrics& metrics,
+// Runs on the render side: everything it shows comes from the frame packet, not the scene.
+void draw_overlay(const engine::renderer::OverlayData& overlay,
                   const engine::runtime::Camera& camera,
-                  const engine::renderer::BasicRenderer& renderer,
-                  const engine::runtime::Scene& scene,
-                  const engine::assets::AssetManager& assets,
-                  const bool show_overlay) {
-  if (!show_overlay || !renderer.enabled()) {
+                  const engine::renderer::BasicRenderer& renderer) {
+  if (!overlay.visible || !renderer.enabled()) {
     return;
   }
 
@@ -110,8 +182,17 @@ void draw_overlay(const engine::time::FrameMetrics& metrics,
 
   bgfx::dbgTextClear(0, false);
   bgfx::dbgTextPrintf(0, 0, 0x0f, "M2 Sandbox (F1 overlay)");
+  const engine::time::FrameMetrics& metrics = overlay.metrics;
   bgfx::dbgTextPrintf(0, 2, 0x0f, "FPS: %.2f", metrics.fps);
-  bgfx::dbgTextPrintf(0, 3, 0x0f, "Frame: %.3f ms", metrics.frame_ms);
+  bgfx::dbgTextPrintf(0,
+                      3,
+                      0x0f,
+                      "Frame: %.3f ms, sim %.0f Hz (%u steps, %llu dropped, alpha %.2f)",
+                      metrics.frame_ms,
+                      overlay.tick_rate_hz,
+                      overlay.fixed_step.steps_this_frame,
+                      static_cast<unsigned long long>(overlay.fixed_step.dropped_steps),
+                      overlay.fixed_step.alpha);
   bgfx::dbgTextPrintf(0,
                       4,
                       0x0f,
@@ -119,22 +200,182 @@ void draw_overlay(const engine::time::FrameMetrics& metrics,
                       camera.position.x,
                       camera.position.y,
                       camera.position.z);
-  bgfx::dbgTextPrintf(0, 5, 0x0f, "Entities: %u", scene.entity_count());
-  bgfx::dbgTextPrintf(0, 6, 0x0f, "Meshes: %u", assets.mesh_count());
-  bgfx::dbgTextPrintf(0, 7, 0x0f, "Draw Calls: %u", renderer.draw_calls());
+  bgfx::dbgTextPrintf(0, 5, 0x0f, "Entities: %u", overlay.entity_count);
+  bgfx::dbgTextPrintf(0, 6, 0x0f, "Meshes: %u", overlay.mesh_count);
+  const engine::renderer::RenderStats& render_stats = renderer.last_frame_stats();
+  const engine::renderer::RenderPassStats render_totals = render_stats.totals();
+  bgfx::dbgTextPrintf(0,
+                      7,
+                      0x0f,
+                      "Render: %u draws, %llu tris, %llu verts, %u culled, %.1f KB up, %u state, "
+                      "cpu %.3f/%.3f/%.3f ms",
+                      render_totals.draws,
+                      static_cast<unsigned long long>(render_totals.triangles),
+                      static_cast<unsigned long long>(render_totals.vertices),
+                      render_totals.culled,
+                      static_cast<double>(render_totals.bytes_uploaded) / 1024.0,
+                      render_totals.state_changes,
+                      render_stats.begin_ms,
+                      render_stats.submit_ms,
+                      render_stats.end_ms);
+
+  const engine::assets::AssetStats& asset_stats = overlay.asset_stats;
+  bgfx::dbgTextPrintf(0,
+                      8,
+                      0x0f,
+                      "Assets: %.1f KB resident (peak %.1f KB), %llu evictions, hit rate %.0f%%",
+                      static_cast<double>(asset_stats.resident_bytes) / 1024.0,
+                      static_cast<double>(asset_stats.peak_resident_bytes) / 1024.0,
+                      static_cast<unsigned long long>(asset_stats.evictions),
+                      asset_stats.hit_rate() * 100.0);
+  bgfx::dbgTextPrintf(0,
+                      9,
+                      0x0f,
+                      "Dedup: %llu shared loads, %.1f KB saved",
+                      static_cast<unsigned long long>(asset_stats.dedup_hits),
+                      static_cast<double>(asset_stats.deduplicated_bytes) / 1024.0);
+  bgfx::dbgTextPrintf(0,
+                      10,
+                      0x0f,
+                      "LOD: %u/%u/%u/%u (0/1/2/3), %u switches, %llu of %llu tris",
+                      overlay.lod_stats.selected_per_lod[0],
+                      overlay.lod_stats.selected_per_lod[1],
+                      overlay.lod_stats.selected_per_lod[2],
+                      overlay.lod_stats.selected_per_lod[3],
+                      overlay.lod_stats.transitions,
+                      static_cast<unsigned long long>(overlay.lod_stats.triangles_selected),
+                      static_cast<unsigned long long>(overlay.lod_stats.triangles_full_detail));
+  bgfx::dbgTextPrintf(0,
+                      11,
+                      0x0f,
+                      "Culling: %u tested, %u frustum, %u occluded, %u/%u occluders (%u tris), %.3f ms",
+                      overlay.occlusion_stats.tested,
+                      overlay.occlusion_stats.frustum_culled,
+                      overlay.occlusion_stats.occluded,
+                      overlay.occlusion_stats.occluders_rasterized,
+                      overlay.occlusion_stats.occluder_limit,
+                      overlay.occlusion_stats.occluder_triangles,
+                      overlay.occlusion_stats.total_ms());
+
+  const engine::renderer::ClusterCullStats& cluster_stats = renderer.cluster_stats();
+  bgfx::dbgTextPrintf(0,
+                      12,
+                      0x0f,
+                      "Clusters: %u tested, %u frustum, %u backface, %llu of %llu tris",
+                      cluster_stats.clusters_tested,
+                      cluster_stats.frustum_culled,
+                      cluster_stats.backface_culled,
+                      static_cast<unsigned long long>(cluster_stats.triangles_submitted),
+                      static_cast<unsigned long long>(cluster_stats.triangles_total));
+  bgfx::dbgTextPrintf(0,
+                      14,
+                      0x0f,
+                      "Pacing: cap %.0f fps, wake error %.3f ms avg / %.3f ms max, idle %.2f ms",
+                      overlay.pacer.target_fps,
+                      overlay.pacer.avg_wake_error_ms,
+                      overlay.pacer.max_wake_error_ms,
+                      overlay.pacer.last_idle_ms);
+  bgfx::dbgTextPrintf(0,
+                      15,
+                      0x0f,
+                      "Input latency: %.2f ms SDL queue to sim (p95 %.2f), %.2f ms to present (p95 %.2f), %llu dropped",
+                      overlay.input_consume_latency.avg_ms,
+                      overlay.input_consume_latency.p95_ms,
+                      overlay.input_present_latency.avg_ms,
+                      overlay.input_present_latency.p95_ms,
+                      static_cast<unsigned long long>(overlay.input_events_dropped));
+  for (size_t tag = 0; tag < engine::core::memory_tag_count; ++tag) {
+    const engine::core::MemoryTagStats& memory = overlay.memory[tag];
+    bgfx::dbgTextPrintf(0,
+                        static_cast<uint16_t>(16U + tag),
+                        memory.budget_bytes > 0U && memory.current_bytes > memory.budget_bytes ? 0x0c : 0x0f,
+                        "Memory %-8s %9.1f KB (peak %9.1f KB, budget %s), %llu live",
+                        engine::core::memory_tag_name(static_cast<engine::core::MemoryTag>(tag)),
+                        static_cast<double>(memory.current_bytes) / 1024.0,
+                        static_cast<double>(memory.peak_bytes) / 1024.0,
+                        memory.budget_bytes > 0U
+                            ? std::to_string(memory.budget_bytes / (1024U * 1024U)).append(" MB").c_str()
+                            : "none",
+                        static_cast<unsigned long long>(memory.live_allocations));
+  }
+  const engine::renderer::FrameAllocatorStats& frame_memory = renderer.frame_allocator().stats();
+  bgfx::dbgTextPrintf(0,
+                      static_cast<uint16_t>(16U + engine::core::memory_tag_count),
+                      0x0f,
+                      "Frame memory: %.0f%% of %.0f KB, peak %.0f KB, %llu overflows",
+                      frame_memory.utilization() * 100.0,
+                      static_cast<double>(frame_memory.capacity_bytes) / 1024.0,
+                      static_cast<double>(frame_memory.peak_used_bytes) / 1024.0,
+                      static_cast<unsigned long long>(frame_memory.total_overflows));
+  bgfx::dbgTextPrintf(0,
+                      static_cast<uint16_t>(17U + engine::core::memory_tag_count),
+                      0x0f,
+                      "Scene nodes: %.1f of %.1f KB pooled, %llu live, %llu upstream",
+                      static_cast<double>(overlay.scene_nodes.used_bytes) / 1024.0,
+                      static_cast<double>(overlay.scene_nodes.capacity_bytes) / 1024.0,
+                      static_cast<unsigned long long>(overlay.scene_nodes.live_allocations),
+                      static_cast<unsigned long long>(overlay.scene_nodes.fallback_allocations));
+  if (overlay.threaded_render) {
+    bgfx::dbgTextPrintf(0,
+                        13,
+                        0x0f,
+                        "Render thread: %.3f ms render, %.3f ms sim wait, %u frames in flight",
+                        overlay.render_ms,
+                        overlay.render_wait_ms,
+                        overlay.frames_in_flight);
+  }
 #else
-  (void)metrics;
+  (void)overlay;
   (void)camera;
   (void)renderer;
-  (void)scene;
-  (void)assets;
 #endif
 }
 
+// "scene=64,assets=256": per-tag budgets in MB. Going over only logs a warning.
+void apply_memory_budgets(const std::string& spec, engine::core::Logger& logger) {
+  size_t start = 0;
+  while (start < spec.size()) {
+    const size_t comma = std::min(spec.find(',', start), spec.size());
+    const std::string entry = spec.substr(start, comma - start);
+    start = comma + 1U;
+
+    const size_t equals = entry.find('=');
+    const std::string name = entry.substr(0, equals);
+    size_t tag = 0;
+    while (tag < engine::core::memory_tag_count &&
+           name != engine::core::memory_tag_name(static_cast<engine::core::MemoryTag>(tag))) {
+      ++tag;
+    }
+    if (equals == std::string::npos || tag == engine::core::memory_tag_count) {
+      logger.warn("Ignoring memory budget entry: '" + entry + "'");
+      continue;
+    }
+    const auto megabytes = static_cast<size_t>(std::strtoull(entry.c_str() + equals + 1U, nullptr, 10));
+    engine::core::memory_tracker().set_budget(static_cast<engine::core::MemoryTag>(tag), megabytes * 1024U * 1024U);
+  }
+}
+
+// Logs string id collisions for as long as the logger it is given lives.
+class StringTableLogging {
+public:
+  explicit StringTableLogging(engine::core::Logger* logger) { engine::core::set_string_table_logger(logger); }
+  ~StringTableLogging() { engine::core::set_string_table_logger(nullptr); }
+
+  StringTableLogging(const StringTableLogging&) = delete;
+  StringTableLogging& operator=(const StringTableLogging&) = delete;
+};
+
 } // namespace
 
-int main() {
+int main(int argc, char** argv) {
   engine::core::Logger logger;
+  const StringTableLogging string_table_logging(&logger);
+
+  sandbox::BenchmarkOptions benchmark;
+  if (std::string args_error; !sandbox::parse_benchmark_args(argc, argv, &benchmark, &args_error)) {
+    logger.error(args_error);
+    return 1;
+  }
 
   if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_EVENTS) != 0) {
     logger.error(std::string("SDL_Init failed: ") + SDL_GetError());
@@ -144,12 +385,16 @@ int main() {
   constexpr int initial_width = 1280;
   constexpr int initial_height = 720;
 
+  // ENGINE_HEADLESS=1 runs the full simulation and culling path without creating a renderer.
+  const char* headless_env = std::getenv("ENGINE_HEADLESS");
+  const bool headless = headless_env != nullptr && std::string(headless_env) == "1";
+
   SDL_Window* window = SDL_CreateWindow("Witcher Engine - M2",
                                         SDL_WINDOWPOS_CENTERED,
                                         SDL_WINDOWPOS_CENTERED,
                                         initial_width,
                                         initial_height,
-                                        SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+                                        (headless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN) | SDL_WINDOW_RESIZABLE);
   if (window == nullptr) {
     logger.error(std::string("SDL_CreateWindow failed: ") + SDL_GetError());
     SDL_Quit();
@@ -160,19 +405,148 @@ int main() {
   int height = initial_height;
 
   engine::renderer::BasicRenderer renderer;
+  // ENGINE_RENDER_CAPTURE=<file> records what is submitted to the renderer and saves it on exit for
+  // render_replay; ENGINE_RENDER_CAPTURE_FRAMES=<first>:<count> limits it to a frame range.
+  const char* render_capture_env = std::getenv("ENGINE_RENDER_CAPTURE");
+  engine::renderer::RenderCapture render_capture;
+  if (render_capture_env != nullptr) {
+    if (const char* range_env = std::getenv("ENGINE_RENDER_CAPTURE_FRAMES"); range_env != nullptr) {
+      char* end = nullptr;
+      const uint64_t first_frame = std::strtoull(range_env, &end, 10);
+      const uint64_t frame_count = *end == ':' ? std::strtoull(end + 1, nullptr, 10) : 0U;
+      render_capture.set_frame_range(std::max<uint64_t>(first_frame, 1U), frame_count);
+    }
+    renderer.set_capture(&render_capture);
+  }
+  int rendered_width = width;
+  int rendered_height = height;
+  engine::input::InputLatencyTracker input_latency;
+  // Copied out after every frame so the benchmark can read it while a render thread runs.
+  std::mutex presented_stats_mutex;
+  engine::renderer::RenderStats presented_stats;
+  const auto render_packet = [&renderer, &rendered_width, &rendered_height, &input_latency, &presented_stats_mutex,
+                              &presented_stats](const engine::renderer::FramePacket& packet) {
+    const engine::runtime::Camera& view = packet.camera;
+    if (view.viewport_width() != rendered_width || view.viewport_height() != rendered_height) {
+      rendered_width = view.viewport_width();
+      rendered_height = view.viewport_height();
+      renderer.resize(rendered_width, rendered_height);
+    }
+
+    renderer.begin_frame(packet.clear_color);
+    renderer.add_culled(packet.culled);
+    for (const engine::renderer::DrawCommand& draw : packet.draws) {
+      renderer.submit_mesh(draw.mesh, draw.world, view, draw.lod);
+    }
+    draw_overlay(packet.overlay, view, renderer);
+    renderer.end_frame();
+    {
+      const std::lock_guard<std::mutex> lock(presented_stats_mutex);
+      presented_stats = renderer.last_frame_stats();
+    }
+    if (packet.input_timestamp_ns != 0U) {
+      input_latency.record_presented(packet.input_timestamp_ns, engine::input::event_clock_ns());
+    }
+  };
+
+  // ENGINE_RENDER_THREAD=1 moves the renderer (including its initialization) to its own thread;
+  // simulation then runs up to ENGINE_FRAMES_IN_FLIGHT frames ahead of presentation. Only bgfx
+  // (outside macOS) can render off the window's thread; otherwise rendering stays on the main thread.
+  const char* render_thread_env = std::getenv("ENGINE_RENDER_THREAD");
+  const bool threaded_render = render_thread_env != nullptr && std::string(render_thread_env) == "1";
+  uint32_t frames_in_flight = 2U;
+  if (const char* in_flight_env = std::getenv("ENGINE_FRAMES_IN_FLIGHT"); in_flight_env != nullptr) {
+    frames_in_flight = static_cast<uint32_t>(std::strtoul(in_flight_env, nullptr, 10));
+  }
+  engine::renderer::RenderThread render_thread(frames_in_flight);
+  engine::renderer::FramePacket inline_packet;
+
   const engine::renderer::NativeWindowData native_window_data = query_native_window_data(window, logger);
-  if (!renderer.init(width, height, native_window_data)) {
+  bool renderer_ready = headless;
+  if (!headless && threaded_render) {
+    renderer_ready = render_thread.start([&] { return renderer.init(width, height, native_window_data, true); },
+                                         render_packet,
+                                         [&renderer] { renderer.shutdown(); });
+    if (!renderer_ready) {
+      logger.warn("ENGINE_RENDER_THREAD needs the bgfx backend; rendering on the main thread.");
+    }
+  }
+  if (!headless && !renderer_ready) {
+    renderer_ready = renderer.init(width, height, native_window_data);
+  }
+  if (!renderer_ready) {
     logger.error("Renderer failed to initialize.");
     SDL_DestroyWindow(window);
     SDL_Quit();
     return 1;
   }
+  // Set during initialization only, so reading it here does not race the render thread.
+  const bool renderer_enabled = renderer.enabled();
 
   engine::runtime::Camera camera;
   camera.set_viewport(width, height);
 
+  engine::io::Vfs vfs;
+  vfs.mount_directory(".");
+  if (const char* pak_env = std::getenv("ENGINE_PAK"); pak_env != nullptr) {
+    std::string pak_error;
+    if (vfs.mount_pak(pak_env, &pak_error)) {
+      logger.info(std::string("Mounted pak archive: ") + pak_env);
+    } else {
+      logger.warn(pak_error);
+    }
+  }
+
+  const char* async_io_env = std::getenv("ENGINE_ASYNC_IO");
+  engine::io::AsyncFileIo asset_io(128U, async_io_env != nullptr && std::string(async_io_env) == "threads");
+  logger.info(asset_io.backend() == engine::io::AsyncIoBackend::IoUring ? "Async asset I/O backend: io_uring"
+                                                                        : "Async asset I/O backend: thread pool");
+
+  engine::core::ThreadPool job_pool;
+
   engine::assets::AssetManager asset_manager(&logger);
-  const engine::assets::MeshHandle mesh_handle = asset_manager.load_mesh("assets/models/m2-triangle.gltf");
+  asset_manager.set_vfs(&vfs);
+  if (const char* lod_env = std::getenv("ENGINE_LOD_GENERATE"); lod_env != nullptr && std::string(lod_env) == "1") {
+    asset_manager.set_lod_generation({}, &job_pool);
+  }
+  const char* compression_env = std::getenv("ENGINE_VERTEX_COMPRESSION");
+  asset_manager.set_vertex_compression(compression_env == nullptr || std::string(compression_env) != "0");
+  asset_manager.set_async_io(&asset_io);
+  if (const char* budget_env = std::getenv("ENGINE_ASSET_BUDGET_MB"); budget_env != nullptr) {
+    asset_manager.set_memory_budget(static_cast<size_t>(std::strtoull(budget_env, nullptr, 10)) * 1024U * 1024U);
+  }
+  if (const char* memory_budget_env = std::getenv("ENGINE_MEMORY_BUDGETS"); memory_budget_env != nullptr) {
+    apply_memory_budgets(memory_budget_env, logger);
+  }
+  const engine::assets::MeshHandle mesh_handle =
+      asset_manager.request_mesh(engine::core::intern("assets/models/m2-triangle.gltf"));
+
+  engine::assets::AssetHotReloader hot_reloader(asset_manager, &logger);
+  if (const char* reload_env = std::getenv("ENGINE_HOT_RELOAD"); reload_env != nullptr) {
+    const std::string reload_mode(reload_env);
+    if (reload_mode == "1" || reload_mode == "poll") {
+      hot_reloader.start("assets", reload_mode == "poll");
+    }
+  }
+
+  engine::runtime::LodSelector lod_selector;
+  if (const char* lod_bias_env = std::getenv("ENGINE_LOD_BIAS"); lod_bias_env != nullptr) {
+    engine::runtime::LodSettings lod_settings = lod_selector.settings();
+    lod_settings.bias = std::strtof(lod_bias_env, nullptr);
+    lod_selector.set_settings(lod_settings);
+  }
+
+  if (const char* cluster_env = std::getenv("ENGINE_CLUSTER_CULL"); cluster_env != nullptr) {
+    renderer.set_cluster_culling(std::string(cluster_env) != "0");
+  }
+
+  engine::renderer::OcclusionCuller occlusion_culler(&job_pool);
+  bool occlusion_enabled = true;
+  if (const char* occlusion_env = std::getenv("ENGINE_OCCLUSION"); occlusion_env != nullptr) {
+    occlusion_enabled = std::string(occlusion_env) != "0";
+  }
+  engine::runtime::StaticDrawCache static_draws;
+  std::vector<engine::runtime::DrawPacket> dynamic_draws;
 
   engine::runtime::Scene scene;
   const engine::runtime::Entity e0 = scene.create_entity();
@@ -180,21 +554,94 @@ int main() {
   t0.position = {-0.4F, 0.0F, 0.0F};
   t0.scale = {1.0F, 1.0F, 1.0F};
   t0.mark_dirty();
-  scene.add_mesh_component(e0, engine::runtime::MeshComponent{mesh_handle});
+  scene.add_mesh_component(e0, engine::runtime::MeshComponent{engine::assets::MeshRef(asset_manager, mesh_handle)});
 
   const engine::runtime::Entity e1 = scene.create_entity();
   auto& t1 = scene.transform(e1);
   t1.position = {0.5F, 0.0F, -0.8F};
   t1.scale = {1.0F, 1.0F, 1.0F};
   t1.mark_dirty();
-  scene.add_mesh_component(e1, engine::runtime::MeshComponent{mesh_handle});
+  scene.add_mesh_component(e1, engine::runtime::MeshComponent{engine::assets::MeshRef(asset_manager, mesh_handle)});
+  scene.set_mobility(e1, engine::runtime::Mobility::Static);
+
+  // Benchmark mode adds a generated scene, runs a fixed number of unpaced frames and writes a JSON report.
+  sandbox::StressScene stress;
+  sandbox::BenchmarkSetup benchmark_setup;
+  if (benchmark.enabled) {
+    const auto build_start = std::chrono::steady_clock::now();
+    stress = sandbox::build_stress_scene(benchmark.scene, &scene, &asset_manager);
+    benchmark_setup.scene_build_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - build_start).count();
+    benchmark_setup.entity_count = stress.entity_count;
+    benchmark_setup.chain_count = stress.chain_count;
+    benchmark_setup.moving_chains = static_cast<uint32_t>(stress.moving_roots.size());
+    benchmark_setup.mesh_count = static_cast<uint32_t>(stress.meshes.size());
+    logger.info("Benchmark scene: " + std::to_string(stress.entity_count) + " entities in " +
+                std::to_string(stress.chain_count) + " chains, " + std::to_string(stress.meshes.size()) +
+                " meshes, built in " + std::to_string(benchmark_setup.scene_build_ms) + " ms");
+  }
+  sandbox::BenchmarkRecorder benchmark_recorder(benchmark.enabled ? benchmark.frames : 0U);
+  double simulation_seconds = 0.0;
 
   engine::Engine engine;
   engine.initialize();
 
   engine::time::FrameTimer timer;
   timer.set_max_delta(0.100);
+
+  // ENGINE_TICK_RATE sets the simulation rate; rendering interpolates between the last two steps.
+  engine::time::FixedStepSettings step_settings;
+  if (const char* tick_env = std::getenv("ENGINE_TICK_RATE"); tick_env != nullptr) {
+    step_settings.tick_rate_hz = std::strtod(tick_env, nullptr);
+  }
+  engine::time::FixedTimestep fixed_step(step_settings);
+
+  // ENGINE_TARGET_FPS caps the focused frame rate (0 = uncapped); unfocused, minimized and
+  // headless runs are throttled further.
+  engine::time::FramePacerSettings pacer_settings;
+  if (const char* fps_env = std::getenv("ENGINE_TARGET_FPS"); fps_env != nullptr) {
+    pacer_settings.target_fps = std::strtod(fps_env, nullptr);
+  }
+  if (const char* background_env = std::getenv("ENGINE_BACKGROUND_FPS"); background_env != nullptr) {
+    pacer_settings.unfocused_fps = std::strtod(background_env, nullptr);
+  }
+  engine::time::FramePacer pacer(pacer_settings);
+  // Keeps queueing (and stamping) input while the pacer sleeps; the queue is drained next frame.
+  const std::function<void()> pump_events = [] { SDL_PumpEvents(); };
+  if (!renderer_enabled) {
+    pacer.set_window_state(false, true);
+  }
+  bool window_focused = true;
+  bool window_minimized = false;
   engine::input::InputState input;
+  engine::input::InputEventRing input_events;
+  SDL_AddEventWatch(capture_input_event, &input_events);
+  std::vector<engine::input::InputEvent> frame_events;
+
+  // ENGINE_RECORD_INPUT=<file> saves every frame's input events and delta on exit.
+  // ENGINE_REPLAY_INPUT=<file> feeds them back instead of live input, then exits and logs frame times;
+  // ENGINE_REPLAY_SPEED=max runs as fast as possible, otherwise recorded frame times are kept.
+  const char* record_env = std::getenv("ENGINE_RECORD_INPUT");
+  const char* replay_env = std::getenv("ENGINE_REPLAY_INPUT");
+  const char* replay_speed_env = std::getenv("ENGINE_REPLAY_SPEED");
+  const bool replay_max_speed = replay_speed_env != nullptr && std::string(replay_speed_env) == "max";
+  engine::input::InputRecording input_recording;
+  bool replaying = false;
+  if (replay_env != nullptr) {
+    std::string replay_error;
+    if (input_recording.load(replay_env, &replay_error)) {
+      replaying = true;
+      logger.info(std::string("Replaying input: ") + replay_env + " (" +
+                  std::to_string(input_recording.frame_count()) + " frames, " +
+                  std::to_string(input_recording.duration_seconds()) + " s)");
+    } else {
+      logger.warn(replay_error);
+    }
+  }
+  const bool recording_input = !replaying && record_env != nullptr;
+  size_t replay_frame = 0;
+  std::vector<double> replay_frame_ms;
+  replay_frame_ms.reserve(input_recording.frame_count());
 
   bool running = true;
   bool show_overlay = true;
@@ -202,6 +649,14 @@ int main() {
   logger.info("M2 main loop started.");
 
   while (running) {
+    if (benchmark.enabled) {
+      if (benchmark_recorder.frames_recorded() == benchmark.frames) {
+        break;
+      }
+      benchmark_recorder.begin_frame();
+    }
+    asset_io.poll();
+    hot_reloader.update();
     input.begin_frame();
 
     SDL_Event event;
@@ -213,7 +668,6 @@ int main() {
       case SDL_KEYDOWN:
         if (event.key.repeat == 0) {
           const engine::input::Key key = map_sdl_key(event.key.keysym.sym);
-          input.on_key_down(key);
           if (key == engine::input::Key::Escape) {
             running = false;
           } else if (key == engine::input::Key::F1) {
@@ -221,21 +675,19 @@ int main() {
           }
         }
         break;
-      case SDL_KEYUP:
-        input.on_key_up(map_sdl_key(event.key.keysym.sym));
-        break;
-      case SDL_MOUSEMOTION:
-        input.on_mouse_move(static_cast<float>(event.motion.x), static_cast<float>(event.motion.y));
-        break;
-      case SDL_MOUSEWHEEL:
-        input.on_scroll(static_cast<float>(event.wheel.preciseY));
-        break;
       case SDL_WINDOWEVENT:
         if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
           width = event.window.data1;
           height = event.window.data2;
           camera.set_viewport(width, height);
-          renderer.resize(width, height);
+        } else if (event.window.event == SDL_WINDOWEVENT_FOCUS_GAINED) {
+          window_focused = true;
+        } else if (event.window.event == SDL_WINDOWEVENT_FOCUS_LOST) {
+          window_focused = false;
+        } else if (event.window.event == SDL_WINDOWEVENT_MINIMIZED) {
+          window_minimized = true;
+        } else if (event.window.event == SDL_WINDOWEVENT_RESTORED) {
+          window_minimized = false;
         }
         break;
       default:
@@ -243,66 +695,278 @@ int main() {
       }
     }
 
-    const engine::time::FrameMetrics metrics = timer.tick();
-
-    camera.update(static_cast<float>(metrics.delta_seconds), input);
+    frame_events.clear();
+    engine::input::InputEvent input_event;
+    while (input_events.pop(&input_event)) {
+      frame_events.push_back(input_event);
+    }
 
-    auto& player_transform = scene.transform(e0);
-    bool moved = false;
-    const float object_speed = 1.5F * static_cast<float>(metrics.delta_seconds);
-    if (input.isDown(engine::input::Key::Left)) {
-      player_transform.position.x -= object_speed;
-      moved = true;
+    const engine::time::FrameMetrics metrics = timer.tick();
+    double frame_delta = metrics.delta_seconds;
+    if (replaying) {
+      if (replay_frame == input_recording.frame_count()) {
+        break;
+      }
+      // Live input is discarded; the recording alone drives the camera and simulation.
+      const engine::input::RecordedFrame& recorded = input_recording.frame(replay_frame++);
+      frame_delta = recorded.delta_seconds;
+      const std::span<const engine::input::InputEvent> recorded_events = input_recording.events(recorded);
+      frame_events.assign(recorded_events.begin(), recorded_events.end());
+      replay_frame_ms.push_back(metrics.frame_ms);
+    } else if (recording_input) {
+      input_recording.add_frame(frame_delta, frame_events);
     }
-    if (input.isDown(engine::input::Key::Right)) {
-      player_transform.position.x += object_speed;
-      moved = true;
+
+    // Oldest event applied this frame; the render side reports when the frame built from it is presented.
+    uint64_t oldest_input_ns = 0;
+    const uint64_t input_consumed_ns = engine::input::event_clock_ns();
+    for (const engine::input::InputEvent& event : frame_events) {
+      input.apply(event);
+      if (event.timestamp_ns != 0U) {
+        input_latency.record_consumed(event.timestamp_ns, input_consumed_ns);
+        if (oldest_input_ns == 0U) {
+          oldest_input_ns = event.timestamp_ns;
+        }
+      }
     }
-    if (input.isDown(engine::input::Key::Up)) {
-      player_transform.position.y += object_speed;
-      moved = true;
+
+    if (benchmark.enabled) {
+      benchmark_recorder.mark(sandbox::BenchmarkPhase::Events);
     }
-    if (input.isDown(engine::input::Key::Down)) {
-      player_transform.position.y -= object_speed;
-      moved = true;
+
+    // The free-fly camera is the viewer, not simulation state: it follows the rendered frame rate so
+    // mouse look is never dropped or doubled when a frame runs zero or several steps.
+    camera.update(static_cast<float>(frame_delta), input);
+
+    const uint32_t steps = fixed_step.advance(frame_delta);
+    const auto step_seconds = static_cast<float>(fixed_step.step_seconds());
+    for (uint32_t step = 0; step < steps; ++step) {
+      scene.begin_simulation_step();
+
+      auto& player_transform = scene.transform(e0);
+      bool moved = false;
+      const float object_speed = 1.5F * step_seconds;
+      if (input.isDown(engine::input::Key::Left)) {
+        player_transform.position.x -= object_speed;
+        moved = true;
+      }
+      if (input.isDown(engine::input::Key::Right)) {
+        player_transform.position.x += object_speed;
+        moved = true;
+      }
+      if (input.isDown(engine::input::Key::Up)) {
+        player_transform.position.y += object_speed;
+        moved = true;
+      }
+      if (input.isDown(engine::input::Key::Down)) {
+        player_transform.position.y -= object_speed;
+        moved = true;
+      }
+      if (moved) {
+        player_transform.mark_dirty();
+      }
+
+      simulation_seconds += fixed_step.step_seconds();
+      sandbox::animate_stress_scene(stress, &scene, simulation_seconds);
+
+      engine.update(fixed_step.step_seconds());
     }
-    if (moved) {
-      player_transform.mark_dirty();
+    if (benchmark.enabled) {
+      benchmark_recorder.mark(sandbox::BenchmarkPhase::Simulation);
     }
+    const auto render_alpha = static_cast<float>(fixed_step.alpha());
 
-    engine.update(metrics.delta_seconds);
-
-    renderer.begin_frame();
+    lod_selector.begin_frame(camera);
 
-    for (const engine::runtime::Entity entity : scene.entities()) {
+    // Static packets are only rebuilt when a static entity or its mesh changed; only dynamic
+    // entities are walked every frame.
+    static_draws.update(scene, asset_manager);
+    dynamic_draws.clear();
+    for (const engine::runtime::Entity entity : scene.dynamic_entities()) {
       const engine::runtime::MeshComponent* mesh_component = scene.find_mesh_component(entity);
       if (mesh_component == nullptr) {
         continue;
       }
 
-      const engine::assets::MeshData* mesh = asset_manager.get_mesh(mesh_component->mesh);
-      engine::math::Mat4 world = engine::math::identity();
-      if (!scene.compute_world_matrix(entity, &world)) {
+      engine::runtime::DrawPacket packet;
+      if (!scene.compute_world_matrix(entity, &packet.world, render_alpha)) {
         continue;
       }
+      packet.entity = entity;
+      packet.mesh = mesh_component->mesh.handle();
+      packet.mesh_data = asset_manager.get_mesh(packet.mesh);
+      dynamic_draws.push_back(packet);
+    }
 
-      renderer.submit_mesh(mesh, world, camera);
+    if (benchmark.enabled) {
+      benchmark_recorder.mark(sandbox::BenchmarkPhase::DrawCollection);
     }
 
-    draw_overlay(metrics, camera, renderer, scene, asset_manager, show_overlay);
-    renderer.end_frame();
+    occlusion_culler.begin_frame(camera);
+    if (occlusion_enabled) {
+      for (const engine::runtime::DrawPacket& packet : static_draws.packets()) {
+        if (packet.mesh_data != nullptr) {
+          occlusion_culler.add_occluder(*packet.mesh_data, packet.world);
+        }
+      }
+      for (const engine::runtime::DrawPacket& packet : dynamic_draws) {
+        if (packet.mesh_data != nullptr) {
+          occlusion_culler.add_occluder(*packet.mesh_data, packet.world);
+        }
+      }
+      occlusion_culler.build();
+    }
+    if (benchmark.enabled) {
+      benchmark_recorder.mark(sandbox::BenchmarkPhase::Occlusion);
+    }
+
+    // Blocks only when the render thread is frames_in_flight packets behind.
+    engine::renderer::FramePacket& frame = render_thread.running() ? render_thread.acquire() : inline_packet;
+    frame.draws.clear();
+    frame.culled = 0;
+    frame.camera = camera;
+    frame.input_timestamp_ns = oldest_input_ns;
+
+    const auto emit_draw = [&](const engine::runtime::DrawPacket& packet) {
+      const uint32_t lod =
+          packet.mesh_data != nullptr ? lod_selector.select(packet.entity, *packet.mesh_data, packet.world) : 0U;
+      frame.draws.push_back({asset_manager.share_mesh(packet.mesh), packet.world, lod});
+    };
+    for (const engine::runtime::DrawPacket& packet : static_draws.packets()) {
+      if (packet.mesh_data != nullptr && occlusion_enabled && !occlusion_culler.is_visible(packet.world_bounds)) {
+        frame.culled += 1;
+        continue;
+      }
+      emit_draw(packet);
+    }
+    for (const engine::runtime::DrawPacket& packet : dynamic_draws) {
+      if (packet.mesh_data != nullptr && occlusion_enabled &&
+          !occlusion_culler.is_visible(packet.mesh_data->bounds, packet.world)) {
+        frame.culled += 1;
+        continue;
+      }
+      emit_draw(packet);
+    }
+
+    const auto frame_draws = static_cast<uint32_t>(frame.draws.size());
+    if (benchmark.enabled) {
+      benchmark_recorder.mark(sandbox::BenchmarkPhase::Visibility);
+    }
+
+    engine::renderer::OverlayData& overlay = frame.overlay;
+    overlay.visible = show_overlay;
+    overlay.metrics = metrics;
+    overlay.tick_rate_hz = fixed_step.settings().tick_rate_hz;
+    overlay.fixed_step = fixed_step.stats();
+    overlay.pacer = pacer.stats();
+    overlay.entity_count = scene.entity_count();
+    overlay.mesh_count = asset_manager.mesh_count();
+    overlay.asset_stats = asset_manager.stats();
+    overlay.lod_stats = lod_selector.stats();
+    overlay.occlusion_stats = occlusion_culler.stats();
+    overlay.input_consume_latency = input_latency.consume_latency();
+    overlay.input_present_latency = input_latency.present_latency();
+    overlay.input_events_dropped = input_events.dropped();
+    for (size_t tag = 0; tag < engine::core::memory_tag_count; ++tag) {
+      overlay.memory[tag] = engine::core::memory_tracker().stats(static_cast<engine::core::MemoryTag>(tag));
+    }
+    overlay.scene_nodes = scene.node_pool_stats();
+    if (const uint32_t exceeded = engine::core::memory_tracker().take_budget_exceeded(); exceeded != 0U) {
+      for (size_t tag = 0; tag < engine::core::memory_tag_count; ++tag) {
+        if ((exceeded & (1U << tag)) != 0U) {
+          const engine::core::MemoryTagStats& memory = overlay.memory[tag];
+          logger.warn(std::string("Memory budget exceeded for ") +
+                      engine::core::memory_tag_name(static_cast<engine::core::MemoryTag>(tag)) + ": " +
+                      std::to_string(memory.current_bytes) + " / " + std::to_string(memory.budget_bytes) + " bytes");
+        }
+      }
+    }
+    overlay.threaded_render = render_thread.running();
+    if (overlay.threaded_render) {
+      const engine::renderer::RenderThreadStats render_stats = render_thread.stats();
+      overlay.render_ms = render_stats.render_ms;
+      overlay.render_wait_ms = render_stats.acquire_wait_ms;
+      overlay.frames_in_flight = render_stats.frames_in_flight;
+      render_thread.submit();
+    } else {
+      render_packet(frame);
+    }
 
     engine.render();
 
-    if (!renderer.enabled()) {
-      SDL_Delay(1);
+    if (benchmark.enabled) {
+      benchmark_recorder.mark(sandbox::BenchmarkPhase::Render);
+      engine::renderer::RenderStats render_stats;
+      {
+        const std::lock_guard<std::mutex> lock(presented_stats_mutex);
+        render_stats = presented_stats;
+      }
+      benchmark_recorder.end_frame(frame_draws, render_stats);
+    } else if (replaying) {
+      if (!replay_max_speed) {
+        pacer.wait_interval(frame_delta, pump_events);
+      }
+    } else {
+      if (renderer_enabled) {
+        pacer.set_window_state(window_focused, window_minimized);
+      }
+      pacer.wait(pump_events);
     }
   }
 
   logger.info("M2 main loop ended.");
 
+  if (recording_input) {
+    std::string record_error;
+    if (input_recording.save(record_env, &record_error)) {
+      logger.info(std::string("Saved input recording: ") + record_env + " (" +
+                  std::to_string(input_recording.frame_count()) + " frames)");
+    } else {
+      logger.warn(record_error);
+    }
+  }
+  if (replaying && replay_frame_ms.size() > 1U) {
+    // The first frame has no measured delta.
+    const sandbox::TimingSummary replay_summary =
+        sandbox::summarize_timings({replay_frame_ms.begin() + 1, replay_frame_ms.end()});
+    logger.info("Replay frame times (ms): frames=" + std::to_string(replay_frame_ms.size() - 1U) +
+                " avg=" + std::to_string(replay_summary.avg_ms) + " p50=" + std::to_string(replay_summary.p50_ms) +
+                " p95=" + std::to_string(replay_summary.p95_ms) + " p99=" + std::to_string(replay_summary.p99_ms) +
+                " max=" + std::to_string(replay_summary.max_ms));
+  }
+  if (benchmark.enabled) {
+    std::string report_error;
+    if (benchmark_recorder.write_json(benchmark.output_path, benchmark, benchmark_setup, asset_manager.stats(),
+                                      &report_error)) {
+      logger.info("Wrote benchmark report: " + benchmark.output_path);
+    } else {
+      logger.warn(report_error);
+    }
+    sandbox::release_stress_scene(stress, &asset_manager);
+  }
+  SDL_DelEventWatch(capture_input_event, &input_events);
+
+  hot_reloader.stop();
+  asset_manager.release_mesh(mesh_handle);
+
   engine.shutdown();
-  renderer.shutdown();
+  if (render_thread.running()) {
+    render_thread.stop();
+  } else {
+    renderer.shutdown();
+  }
+
+  if (render_capture_env != nullptr) {
+    std::string capture_error;
+    if (render_capture.save(render_capture_env, &capture_error)) {
+      logger.info(std::string("Saved render capture: ") + render_capture_env + " (" +
+                  std::to_string(render_capture.frame_count()) + " frames, " +
+                  std::to_string(render_capture.draw_count()) + " draws, " +
+                  std::to_string(render_capture.mesh_count()) + " meshes)");
+    } else {
+      logger.warn(capture_error);
+    }
+  }
 
   SDL_DestroyWindow(window);
   SDL_Quit();
@@ -0,0 +1,129 @@
+#include "stress_scene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <string>
+
+namespace sandbox {
+
+namespace {
+
+constexpr float grid_spacing = 1.5F;
+constexpr float chain_link_offset = 0.6F;
+
+engine::assets::MeshData make_sphere_mesh(const uint32_t rings, const uint32_t segments) {
+  engine::assets::MeshData mesh{};
+  constexpr float pi = 3.14159265359F;
+  constexpr float radius = 0.4F;
+
+  for (uint32_t r = 0; r <= rings; ++r) {
+    const float v = static_cast<float>(r) / static_cast<float>(rings);
+    const float phi = v * pi;
+    for (uint32_t s = 0; s <= segments; ++s) {
+      const float u = static_cast<float>(s) / static_cast<float>(segments);
+      const float theta = u * 2.0F * pi;
+      const engine::math::Vec3 n{std::sin(phi) * std::cos(theta), std::cos(phi), std::sin(phi) * std::sin(theta)};
+      mesh.vertices.push_back(engine::assets::Vertex{n * radius});
+    }
+  }
+
+  const uint32_t stride = segments + 1U;
+  for (uint32_t r = 0; r < rings; ++r) {
+    for (uint32_t s = 0; s < segments; ++s) {
+      const uint32_t i0 = (r * stride) + s;
+      const uint32_t i1 = i0 + stride;
+      mesh.indices.push_back(i0);
+      mesh.indices.push_back(i1);
+      mesh.indices.push_back(i0 + 1U);
+      mesh.indices.push_back(i0 + 1U);
+      mesh.indices.push_back(i1);
+      mesh.indices.push_back(i1 + 1U);
+    }
+  }
+
+  mesh.bounds = engine::assets::compute_aabb(mesh.vertices);
+  return mesh;
+}
+
+} // namespace
+
+StressScene build_stress_scene(const StressSceneOptions& options,
+                               engine::runtime::Scene* scene,
+                               engine::assets::AssetManager* assets) {
+  StressScene stress;
+
+  // Every variant has a distinct tessellation, so the mesh store cannot deduplicate them.
+  const uint32_t mesh_variety = std::max(options.mesh_variety, 1U);
+  stress.meshes.reserve(mesh_variety);
+  for (uint32_t k = 0; k < mesh_variety; ++k) {
+    const engine::assets::MeshHandle handle = assets->create_mesh("generated/stress_sphere_" + std::to_string(k),
+                                                                  make_sphere_mesh(4U + (k % 12U), 6U + (k / 12U)));
+    if (handle.valid()) {
+      stress.meshes.push_back(handle);
+    }
+  }
+  if (stress.meshes.empty()) {
+    return stress;
+  }
+
+  const uint32_t depth = std::max(options.hierarchy_depth, 1U);
+  stress.chain_count = (options.entity_count + depth - 1U) / depth;
+  const auto columns = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(stress.chain_count))));
+  const float moving_fraction = std::clamp(options.moving_fraction, 0.0F, 1.0F);
+  const auto moving_chains =
+      static_cast<uint64_t>(std::llround(static_cast<double>(moving_fraction) * stress.chain_count));
+  stress.moving_roots.reserve(moving_chains);
+  stress.moving_origins.reserve(moving_chains);
+
+  uint32_t created = 0;
+  for (uint64_t chain = 0; chain < stress.chain_count; ++chain) {
+    // Spread moving chains evenly through the grid instead of bunching them in front.
+    const bool moving =
+        (chain * moving_chains) / stress.chain_count != ((chain + 1U) * moving_chains) / stress.chain_count;
+    const engine::runtime::Mobility mobility =
+        moving ? engine::runtime::Mobility::Dynamic : engine::runtime::Mobility::Static;
+
+    const engine::math::Vec3 origin{(static_cast<float>(chain % columns) - (static_cast<float>(columns) * 0.5F)) *
+                                        grid_spacing,
+                                    -1.0F,
+                                    -static_cast<float>(chain / columns) * grid_spacing};
+
+    std::optional<uint32_t> parent;
+    for (uint32_t link = 0; link < depth && created < options.entity_count; ++link, ++created) {
+      const engine::runtime::Entity entity = scene->create_entity(parent);
+      engine::runtime::Transform& transform = scene->transform(entity);
+      transform.position = link == 0U ? origin : engine::math::Vec3{0.0F, chain_link_offset, 0.0F};
+      transform.mark_dirty();
+      const engine::assets::MeshHandle mesh = stress.meshes[created % stress.meshes.size()];
+      scene->add_mesh_component(entity, {engine::assets::MeshRef(*assets, mesh)});
+      scene->set_mobility(entity, mobility);
+
+      if (link == 0U && moving) {
+        stress.moving_roots.push_back(entity);
+        stress.moving_origins.push_back(origin);
+      }
+      parent = entity.id;
+    }
+  }
+
+  stress.entity_count = created;
+  return stress;
+}
+
+void animate_stress_scene(const StressScene& stress, engine::runtime::Scene* scene, const double time_seconds) {
+  for (size_t i = 0; i < stress.moving_roots.size(); ++i) {
+    const auto phase = static_cast<float>(time_seconds + (static_cast<double>(i) * 0.37));
+    engine::runtime::Transform& transform = scene->transform(stress.moving_roots[i]);
+    transform.position = stress.moving_origins[i] + engine::math::Vec3{0.0F, 0.25F * std::sin(phase * 2.0F), 0.0F};
+    transform.mark_dirty();
+  }
+}
+
+void release_stress_scene(const StressScene& stress, engine::assets::AssetManager* assets) {
+  for (const engine::assets::MeshHandle handle : stress.meshes) {
+    assets->release_mesh(handle);
+  }
+}
+
+} // namespace sandbox
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "engine/assets/asset_manager.h"
+#include "engine/math/vec3.h"
+#include "engine/runtime/entity.h"
+#include "engine/runtime/scene.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace sandbox {
+
+struct StressSceneOptions {
+  uint32_t entity_count = 10000U;
+  uint32_t hierarchy_depth = 1U; // entities per parent chain; 1 = flat
+  uint32_t mesh_variety = 8U;    // distinct generated meshes
+  float moving_fraction = 0.1F;  // of chains; the rest are static
+};
+
+struct StressScene {
+  std::vector<engine::assets::MeshHandle> meshes;
+  std::vector<engine::runtime::Entity> moving_roots;
+  std::vector<engine::math::Vec3> moving_origins;
+  uint32_t entity_count = 0;
+  uint32_t chain_count = 0;
+};
+
+// Lays parent chains out on a grid in front of the default camera, far enough
+// that most of a large scene falls outside the view. A chain is static or moving
+// as a whole so moving parents never invalidate static draws.
+StressScene build_stress_scene(const StressSceneOptions& options,
+                               engine::runtime::Scene* scene,
+                               engine::assets::AssetManager* assets);
+
+// Moves every moving chain root; call once per simulation step.
+void animate_stress_scene(const StressScene& stress, engine::runtime::Scene* scene, double time_seconds);
+
+void release_stress_scene(const StressScene& stress, engine::assets::AssetManager* assets);
+
+} // namespace sandbox
@@ -1,43 +1,231 @@
 #pragma once
 
+#include "engine/assets/geometry_pool.h"
+#include "engine/assets/gltf_loader.h"
 #include "engine/assets/mesh_data.h"
+#include "engine/assets/mesh_simplifier.h"
+#include "engine/assets/mesh_store.h"
+#include "engine/assets/meshlet_builder.h"
+#include "engine/assets/model_data.h"
+#include "engine/assets/vertex_format.h"
+#include "engine/core/slot_map.h"
+#include "engine/core/string_id.h"
+#include "engine/core/task.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace engine::core {
 class Logger;
+class ThreadPool;
+}
+
+namespace engine::io {
+class AsyncFileIo;
+class Vfs;
+struct ReadCompletion;
 }
 
 namespace engine::assets {
 
 struct MeshHandle {
-  uint32_t value = 0;
+  uint32_t index = 0;
+  uint32_t generation = 0;
+
+  bool valid() const { return generation != 0; }
+};
+
+struct ModelHandle {
+  uint32_t index = 0;
+  uint32_t generation = 0;
+
+  bool valid() const { return generation != 0; }
+};
+
+struct AssetStats {
+  size_t resident_bytes = 0;
+  size_t peak_resident_bytes = 0;
+  size_t budget_bytes = 0; // 0 = unlimited
+  uint32_t resident_meshes = 0;
+  uint32_t unreferenced_meshes = 0;
+  uint64_t evictions = 0;
+  uint64_t cache_hits = 0;
+  uint64_t cache_misses = 0;
+  uint64_t dedup_hits = 0;
+  size_t deduplicated_bytes = 0; // bytes shared instead of loaded again, meshes and model geometry
+  size_t geometry_pool_bytes = 0;  // model geometry, not subject to eviction
 
-  bool valid() const { return value != 0; }
+  double hit_rate() const;
 };
 
 class AssetManager {
 public:
   explicit AssetManager(core::Logger* logger = nullptr);
 
-  MeshHandle load_mesh(const std::string& path);
+  // Source files are read through the VFS when one is set; the VFS must outlive the manager.
+  void set_vfs(const io::Vfs* vfs);
+
+  // Queue used by request_mesh; it must outlive the manager or be drained first.
+  void set_async_io(io::AsyncFileIo* async_io);
+
+  // Imported meshes without authored LODs get a simplified chain, one job per mesh on pool.
+  // Configure before the first load; process_import reads the settings from other threads.
+  void set_lod_generation(const LodChainOptions& options, core::ThreadPool* pool = nullptr);
+  // Large imported meshes are split into meshlets for cluster culling (on by default).
+  void set_meshlet_generation(bool enabled, const MeshletOptions& options = {});
+  // Mesh vertices are kept resident as quantized streams (MeshData::compressed) and decoded
+  // when drawn. Off by default; model geometry in the GeometryPool is not affected.
+  void set_vertex_compression(bool enabled, const VertexLayout& layout = {});
+  void process_import(GltfLoadResult* result) const;
+  // Reads path through the VFS and runs process_import. Touches no manager state, so it may
+  // run on any thread once the manager is configured.
+  GltfLoadResult import_file(const std::string& path) const;
+
+  // Every successful load_mesh adds one reference; pair it with release_mesh.
+  // Paths are ids returned by core::intern. Intern where the path is first known and keep
+  // the id, so repeated loads are a hash map lookup with no text hashing.
+  MeshHandle load_mesh(core::StringId path);
+  // Registers generated geometry under a virtual path (one reference, like load_mesh); later
+  // loads of that path share it. Fails if something is already loaded from the path.
+  MeshHandle create_mesh(std::string_view path, MeshData mesh);
   const MeshData* get_mesh(MeshHandle handle) const;
+  // Keeps the data alive past a reload or eviction, e.g. while a render thread still draws it.
+  std::shared_ptr<const MeshData> share_mesh(MeshHandle handle) const;
+  bool retain_mesh(MeshHandle handle);
+  bool release_mesh(MeshHandle handle);
+  // Frees an unreferenced mesh now instead of leaving it to eviction. Refuses (and warns)
+  // while references remain, since their holders would be left with a dead handle.
   bool unload_mesh(MeshHandle handle);
 
+  // Streaming variant of load_mesh: the handle is valid immediately and get_mesh
+  // returns nullptr until AsyncFileIo::poll() delivers the file. Falls back to a
+  // blocking load without an async queue or for files served from a mounted pak.
+  MeshHandle request_mesh(core::StringId path);
+  bool is_mesh_ready(MeshHandle handle) const;
+  uint32_t pending_mesh_loads() const;
+
+  // Bumped whenever the data behind an existing handle changes (stream completion, reload, unload).
+  uint64_t mesh_data_revision() const;
+
+  uint32_t mesh_ref_count(MeshHandle handle) const;
+  size_t mesh_memory_bytes(MeshHandle handle) const;
+
+  // Unreferenced meshes are evicted least-recently-used first while resident bytes exceed the budget.
+  void set_memory_budget(size_t budget_bytes);
+  AssetStats stats() const;
+
   uint32_t mesh_count() const;
 
+  // Models keep every mesh of a file, suballocated from one shared GeometryPool. Primitives
+  // identical to geometry already in the pool share its range.
+  ModelHandle load_model(core::StringId path);
+  const ModelData* get_model(ModelHandle handle) const;
+  bool release_model(ModelHandle handle);
+  uint32_t model_count() const;
+
+  const GeometryPool& geometry_pool() const;
+  void defragment_geometry();
+
+  // Replaces the data behind every handle loaded from path; handles stay valid.
+  // Call between frames only. Returns false if nothing was loaded from path or the import failed.
+  bool apply_reload(std::string_view path, GltfLoadResult result);
+  // Thread-safe: whether a mesh or model is currently loaded from path, so a hot reloader can
+  // skip files nothing uses.
+  bool is_loaded_path(std::string_view path) const;
+
 private:
+  struct MeshRecord {
+    std::shared_ptr<const MeshData> data;
+    core::StringId path;
+    size_t bytes = 0; // logical size; shared buffers count once in resident bytes
+    uint32_t ref_count = 0;
+    bool in_lru = false;
+    std::list<MeshHandle>::iterator lru_position;
+  };
+
+  struct ModelRecord {
+    ModelData data;
+    core::StringId path;
+    uint32_t ref_count = 0;
+  };
+
+  std::shared_ptr<const MeshData> acquire_mesh_data(MeshData mesh, const std::string& path);
+  // Suspends on the async queue until the file arrives, then resumes inside AsyncFileIo::poll().
+  core::DetachedTask stream_mesh(MeshHandle handle, std::string native_path);
+  void complete_streamed_mesh(MeshHandle handle, io::ReadCompletion& completion);
+  // Model geometry counts toward the budget but is never evicted; it only pushes unreferenced meshes out.
+  void allocate_model_geometry(const std::vector<MeshData>& meshes, ModelRecord* record);
+  void free_model_geometry(ModelRecord* record);
+  void enforce_budget();
+  void erase_record(MeshHandle handle);
+  // Mirrors path_cache_ and model_path_cache_ membership into loaded_paths_.
+  void sync_loaded_path(core::StringId path);
+  // Resident mesh and model bytes are also reported to the Assets memory tag.
+  void add_resident_bytes(size_t bytes);
+  void remove_resident_bytes(size_t bytes);
+  static std::string path_string(core::StringId path);
+
   void log_info(const std::string& message) const;
   void log_warn(const std::string& message) const;
   void log_error(const std::string& message) const;
 
   core::Logger* logger_ = nullptr;
-  uint32_t next_handle_ = 1;
+  const io::Vfs* vfs_ = nullptr;
+  io::AsyncFileIo* async_io_ = nullptr;
+  bool generate_lods_ = false;
+  LodChainOptions lod_options_;
+  core::ThreadPool* lod_pool_ = nullptr;
+  bool generate_meshlets_ = true;
+  MeshletOptions meshlet_options_;
+  bool compress_vertices_ = false;
+  VertexLayout vertex_layout_;
+  uint32_t pending_mesh_loads_ = 0;
+  uint64_t mesh_data_revision_ = 0;
+  MeshStore store_;
+  std::unordered_map<core::StringId, MeshHandle, core::StringIdHash> path_cache_;
+  core::SlotMap<MeshRecord, MeshHandle> meshes_;
+  std::list<MeshHandle> lru_; // unreferenced meshes, least recently used first
+
+  GeometryPool geometry_pool_{4096U, 12288U};
+  std::unordered_map<core::StringId, ModelHandle, core::StringIdHash> model_path_cache_;
+  core::SlotMap<ModelRecord, ModelHandle> models_;
+
+  mutable std::mutex loaded_paths_mutex_; // frame thread -> hot reload worker
+  std::unordered_set<core::StringId, core::StringIdHash> loaded_paths_;
 
-  std::unordered_map<std::string, MeshHandle> path_cache_;
-  std::unordered_map<uint32_t, MeshData> meshes_;
+  AssetStats stats_;
+  bool over_budget_warned_ = false;
+};
+
+// One mesh reference owned by a long-lived holder such as a scene component: retained
+// on construction and copy, released on destruction. The caller keeps any reference it
+// already had. The manager must outlive every MeshRef.
+class MeshRef {
+public:
+  MeshRef() = default;
+  MeshRef(AssetManager& assets, MeshHandle handle);
+  ~MeshRef();
+
+  MeshRef(const MeshRef& other);
+  MeshRef& operator=(const MeshRef& other);
+  MeshRef(MeshRef&& other) noexcept;
+  MeshRef& operator=(MeshRef&& other) noexcept;
+
+  // Invalid if the handle could not be retained.
+  MeshHandle handle() const { return handle_; }
+  void reset();
+
+private:
+  AssetManager* assets_ = nullptr;
+  MeshHandle handle_;
 };
 
 } // namespace engine::assets
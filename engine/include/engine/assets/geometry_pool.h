@@ -0,0 +1,117 @@
+#pragma once
+
+#include "engine/assets/mesh_data.h"
+#include "engine/core/slot_map.h"
+#include "engine/math/vec2.h"
+#include "engine/math/vec3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::assets {
+
+struct GeometryAllocation {
+  uint32_t index = 0;
+  uint32_t generation = 0;
+
+  bool valid() const { return generation != 0; }
+};
+
+// Indices inside a range are relative to vertex_offset (base vertex).
+struct GeometryRange {
+  uint32_t vertex_offset = 0;
+  uint32_t vertex_count = 0;
+  uint32_t index_offset = 0;
+  uint32_t index_count = 0;
+};
+
+// Pool storage a range occupies across all vertex streams and the index buffer.
+size_t geometry_range_bytes(const GeometryRange& range);
+
+struct GeometryPoolStats {
+  uint32_t allocations = 0;
+  uint32_t vertex_capacity = 0;
+  uint32_t vertex_used = 0;
+  uint32_t index_capacity = 0;
+  uint32_t index_used = 0;
+  uint32_t free_vertex_blocks = 0;
+  uint32_t free_index_blocks = 0;
+  uint32_t largest_free_vertex_block = 0;
+  uint32_t largest_free_index_block = 0;
+  uint64_t defragmentations = 0;
+  uint64_t dedup_hits = 0;
+  size_t bytes_saved = 0; // storage shared instead of allocated again, for live references
+};
+
+// Shared vertex/index storage for many submeshes. Vertex attributes are parallel
+// streams that share offsets. revision() changes whenever existing data moves
+// (growth or defragmentation) so GPU mirrors know to re-upload. Nothing is
+// allocated until the first allocate(), which starts at the initial capacities.
+// Ranges are content-addressed: allocating geometry identical to a live range
+// returns that range again, reference counted per allocate().
+class GeometryPool {
+public:
+  explicit GeometryPool(uint32_t initial_vertex_capacity = 64U * 1024U,
+                        uint32_t initial_index_capacity = 192U * 1024U);
+
+  GeometryAllocation allocate(const MeshData& mesh, bool* out_shared = nullptr);
+  // Drops one reference. Returns the bytes released, which is zero while other references
+  // still share the range (or the allocation is not live).
+  size_t free(GeometryAllocation allocation);
+  const GeometryRange* range(GeometryAllocation allocation) const;
+
+  void defragment();
+
+  const std::vector<Vertex>& vertices() const;
+  const std::vector<math::Vec3>& normals() const;
+  const std::vector<math::Vec2>& uvs() const;
+  const std::vector<uint32_t>& indices() const;
+
+  uint64_t revision() const;
+  GeometryPoolStats stats() const;
+  size_t memory_bytes() const;
+
+private:
+  struct FreeBlock {
+    uint32_t offset = 0;
+    uint32_t count = 0;
+  };
+
+  struct Entry {
+    GeometryRange range;
+    uint64_t hash = 0;
+    uint32_t ref_count = 0;
+  };
+
+  uint32_t allocate_vertices(uint32_t count);
+  uint32_t allocate_indices(uint32_t count);
+  void grow_vertices(uint32_t min_count);
+  void grow_indices(uint32_t min_count);
+
+  bool range_matches(const GeometryRange& range, const MeshData& mesh) const;
+
+  static bool take_first_fit(std::vector<FreeBlock>* blocks, uint32_t count, uint32_t* out_offset);
+  static void release_block(std::vector<FreeBlock>* blocks, uint32_t offset, uint32_t count);
+
+  uint32_t initial_vertex_capacity_;
+  uint32_t initial_index_capacity_;
+  core::SlotMap<Entry, GeometryAllocation> ranges_;
+  std::unordered_map<uint64_t, std::vector<GeometryAllocation>> ranges_by_hash_;
+
+  std::vector<Vertex> vertices_;
+  std::vector<math::Vec3> normals_;
+  std::vector<math::Vec2> uvs_;
+  std::vector<uint32_t> indices_;
+
+  std::vector<FreeBlock> free_vertices_; // sorted by offset, coalesced
+  std::vector<FreeBlock> free_indices_;
+
+  uint64_t revision_ = 0;
+  uint64_t defragmentations_ = 0;
+  uint64_t dedup_hits_ = 0;
+  size_t bytes_saved_ = 0;
+};
+
+} // namespace engine::assets
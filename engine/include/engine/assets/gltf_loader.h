@@ -2,9 +2,15 @@
 
 #include "engine/assets/mesh_data.h"
 
+#include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
+namespace engine::io {
+class Vfs;
+}
+
 namespace engine::assets {
 
 struct GltfLoadResult {
@@ -16,6 +22,8 @@ struct GltfLoadResult {
 class GltfLoader {
 public:
   static GltfLoadResult load(const std::string& path);
+  static GltfLoadResult load(const std::string& path, const io::Vfs& vfs);
+  static GltfLoadResult load_from_memory(const std::string& path, std::span<const uint8_t> bytes);
 };
 
 } // namespace engine::assets
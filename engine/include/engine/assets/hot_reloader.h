@@ -0,0 +1,71 @@
+#pragma once
+
+#include "engine/assets/gltf_loader.h"
+#include "engine/io/file_watcher.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace engine::core {
+class Logger;
+}
+
+namespace engine::assets {
+
+class AssetManager;
+
+struct HotReloadStats {
+  uint64_t changes_detected = 0;
+  uint64_t reimports = 0;
+  uint64_t swaps_applied = 0;
+  uint64_t failures = 0;
+};
+
+// Watches a directory and re-imports changed assets on a background thread.
+// Results are swapped into the AssetManager only from update(), which the
+// owner calls at a frame boundary, so existing handles stay valid and no
+// frame ever observes a half-replaced asset.
+class AssetHotReloader {
+public:
+  explicit AssetHotReloader(AssetManager& assets, core::Logger* logger = nullptr);
+  ~AssetHotReloader();
+
+  AssetHotReloader(const AssetHotReloader&) = delete;
+  AssetHotReloader& operator=(const AssetHotReloader&) = delete;
+
+  bool start(const std::string& root, bool force_polling = false);
+  void stop();
+
+  uint32_t update();
+
+  bool running() const;
+  io::FileWatchBackend backend() const;
+  HotReloadStats stats() const;
+
+private:
+  struct Reimport {
+    std::string path;
+    GltfLoadResult result;
+  };
+
+  void worker_main();
+
+  AssetManager& assets_;
+  core::Logger* logger_ = nullptr;
+
+  io::FileWatcher watcher_;
+  std::thread worker_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stop_requested_ = false;
+  std::vector<Reimport> completed_;
+
+  HotReloadStats stats_;
+};
+
+} // namespace engine::assets
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "engine/math/vec2.h"
 #include "engine/math/vec3.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 namespace engine::assets {
@@ -16,12 +19,62 @@ struct Vertex {
   math::Vec3 position;
 };
 
+// Coarser index list over the same vertices. error is the object-space
+// distance the surface may deviate from LOD 0.
+struct MeshLod {
+  std::vector<uint32_t> indices;
+  float error = 0.0F;
+};
+
+inline constexpr uint32_t max_mesh_lods = 8U;
+
+// Cluster of LOD 0 triangles. Triangles are three bytes each in
+// MeshData::meshlet_triangles, indexing the meshlet's slice of
+// MeshData::meshlet_vertices, which holds indices into MeshData::vertices.
+// The normal cone faces away from any camera for which
+// dot(normalize(cone_apex - camera), cone_axis) >= cone_cutoff; a cutoff
+// above one never culls.
+struct Meshlet {
+  uint32_t vertex_offset = 0;
+  uint32_t triangle_offset = 0;
+  uint32_t vertex_count = 0;
+  uint32_t triangle_count = 0;
+  math::Vec3 center;
+  float radius = 0.0F;
+  math::Vec3 cone_apex;
+  math::Vec3 cone_axis;
+  float cone_cutoff = 2.0F;
+};
+
+inline constexpr uint32_t max_meshlet_vertices = 64U;
+inline constexpr uint32_t max_meshlet_triangles = 124U;
+
+struct CompressedMesh; // vertex_format.h
+
 struct MeshData {
   std::vector<Vertex> vertices;
+  // Optional, one per vertex. Nothing at runtime reads them yet, so loaders leave them empty;
+  // vertex_format.h compresses them when they are present.
+  std::vector<math::Vec3> normals;
+  std::vector<math::Vec2> uvs;
   std::vector<uint32_t> indices;
+  std::vector<MeshLod> lods; // optional LOD 1..n, coarsest last; indices is LOD 0
+  std::vector<Meshlet> meshlets; // optional clusters over LOD 0
+  std::vector<uint32_t> meshlet_vertices;
+  std::vector<uint8_t> meshlet_triangles;
   Aabb bounds;
+  // Quantized vertex streams (see compress_vertex_streams); when set, vertices, normals and uvs
+  // are empty and positions come from mesh_positions().
+  std::shared_ptr<const CompressedMesh> compressed;
 };
 
 Aabb compute_aabb(const std::vector<Vertex>& vertices);
+Aabb merge_aabb(const Aabb& a, const Aabb& b);
+
+size_t mesh_memory_bytes(const MeshData& mesh);
+
+uint32_t mesh_lod_count(const MeshData& mesh);
+const std::vector<uint32_t>& mesh_lod_indices(const MeshData& mesh, uint32_t lod);
+float mesh_lod_error(const MeshData& mesh, uint32_t lod);
 
 } // namespace engine::assets
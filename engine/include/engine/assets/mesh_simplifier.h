@@ -0,0 +1,46 @@
+#pragma once
+
+#include "engine/assets/mesh_data.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine::core {
+class ThreadPool;
+}
+
+namespace engine::assets {
+
+struct SimplifyOptions {
+  float target_ratio = 0.5F;    // of the source triangle count
+  float max_error = 1.0e30F;    // object-space; collapses above it are not taken
+  bool lock_borders = true;     // open edges and attribute seams keep their vertices
+};
+
+struct SimplifyResult {
+  std::vector<uint32_t> indices; // into the source vertex array
+  float error = 0.0F;            // object-space deviation bound from the quadric metric
+  uint32_t collapses = 0;
+};
+
+// Quadric error metric edge-collapse simplifier. Vertices are collapsed onto
+// existing neighbours, so the result is an index list over the unchanged
+// vertex buffer and can be stored directly as a MeshLod.
+SimplifyResult simplify_mesh(const MeshData& mesh, const SimplifyOptions& options = {});
+
+struct LodChainOptions {
+  std::vector<float> triangle_ratios{0.5F, 0.25F, 0.125F};
+  float max_error = 1.0e30F;
+  bool lock_borders = true;
+  // A level that keeps more than this fraction of the previous level's triangles ends the chain.
+  float min_reduction = 0.9F;
+};
+
+// Replaces mesh->lods with a generated chain (capped at max_mesh_lods levels).
+void generate_lod_chain(MeshData* mesh, const LodChainOptions& options = {});
+
+// Generates chains for every mesh that has no LODs yet, one job per mesh on pool (inline if null).
+void generate_missing_lod_chains(std::span<MeshData> meshes, const LodChainOptions& options, core::ThreadPool* pool);
+
+} // namespace engine::assets
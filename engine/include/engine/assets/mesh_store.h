@@ -0,0 +1,47 @@
+#pragma once
+
+#include "engine/assets/mesh_data.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::assets {
+
+struct MeshStoreStats {
+  uint32_t unique_meshes = 0;
+  uint32_t shared_references = 0;
+  uint64_t dedup_hits = 0;
+  size_t unique_bytes = 0;
+  size_t bytes_saved = 0;
+};
+
+uint64_t hash_mesh_content(const MeshData& mesh);
+bool mesh_content_equal(const MeshData& a, const MeshData& b);
+
+// Immutable, content-addressed mesh buffers. Identical geometry acquired from any
+// number of sources resolves to one resident copy, reference counted per acquire.
+class MeshStore {
+public:
+  std::shared_ptr<const MeshData> acquire(MeshData mesh, bool* out_deduplicated = nullptr);
+
+  // Returns the bytes freed, which is zero while other references still share the buffer.
+  size_t release(const std::shared_ptr<const MeshData>& mesh);
+
+  MeshStoreStats stats() const;
+
+private:
+  struct Entry {
+    std::shared_ptr<const MeshData> data;
+    size_t bytes = 0;
+    uint32_t ref_count = 0;
+  };
+
+  std::unordered_map<uint64_t, std::vector<Entry>> buckets_;
+  std::unordered_map<const MeshData*, uint64_t> hash_by_buffer_;
+  MeshStoreStats stats_;
+};
+
+} // namespace engine::assets
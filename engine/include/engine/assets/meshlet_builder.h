@@ -0,0 +1,25 @@
+#pragma once
+
+#include "engine/assets/mesh_data.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::assets {
+
+struct MeshletOptions {
+  uint32_t max_vertices = max_meshlet_vertices;
+  uint32_t max_triangles = max_meshlet_triangles;
+  // Smaller meshes are drawn whole; one or two clusters cannot save anything.
+  uint32_t min_source_triangles = 512U;
+};
+
+// Splits LOD 0 into meshlets, replacing any existing ones. Triangles are
+// grown greedily across shared vertices so clusters stay spatially compact.
+// Returns the number of meshlets built (0 when the mesh is below the threshold).
+uint32_t build_meshlets(MeshData* mesh, const MeshletOptions& options = {});
+
+// Appends a meshlet's triangles to out_indices as indices into mesh.vertices.
+void append_meshlet_indices(const MeshData& mesh, const Meshlet& meshlet, std::vector<uint32_t>* out_indices);
+
+} // namespace engine::assets
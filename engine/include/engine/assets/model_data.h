@@ -0,0 +1,21 @@
+#pragma once
+
+#include "engine/assets/geometry_pool.h"
+#include "engine/assets/mesh_data.h"
+
+#include <vector>
+
+namespace engine::assets {
+
+struct Submesh {
+  GeometryAllocation geometry;
+  Aabb bounds;
+};
+
+// Every mesh/primitive of a source file, with geometry suballocated from a GeometryPool.
+struct ModelData {
+  std::vector<Submesh> submeshes;
+  Aabb bounds;
+};
+
+} // namespace engine::assets
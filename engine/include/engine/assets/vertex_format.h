@@ -0,0 +1,96 @@
+#pragma once
+
+#include "engine/assets/mesh_data.h"
+#include "engine/math/vec2.h"
+#include "engine/math/vec3.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::assets {
+
+enum class PositionEncoding : uint8_t {
+  Float32,
+  Unorm16, // normalized to the mesh Aabb, 4 x uint16 (w unused)
+};
+
+enum class NormalEncoding : uint8_t {
+  None,
+  Float32,
+  Octahedral8,  // 2 x int8
+  Octahedral16, // 2 x int16
+};
+
+enum class UvEncoding : uint8_t {
+  None,
+  Float32,
+  Half16,
+};
+
+enum class IndexFormat : uint8_t {
+  Uint16,
+  Uint32,
+};
+
+struct VertexLayout {
+  PositionEncoding position = PositionEncoding::Unorm16;
+  NormalEncoding normal = NormalEncoding::Octahedral16;
+  UvEncoding uv = UvEncoding::Half16;
+  bool allow_16bit_indices = true;
+};
+
+uint32_t position_stride(const VertexLayout& layout);
+uint32_t attribute_stride(const VertexLayout& layout);
+
+// Positions live in their own stream so depth/shadow passes only touch position data.
+struct CompressedMesh {
+  VertexLayout layout;
+  IndexFormat index_format = IndexFormat::Uint32;
+  uint32_t vertex_count = 0;
+  uint32_t index_count = 0;
+  Aabb bounds;
+
+  std::vector<uint8_t> position_stream;
+  std::vector<uint8_t> attribute_stream;
+  std::vector<uint8_t> index_stream;
+};
+
+size_t compressed_memory_bytes(const CompressedMesh& mesh);
+
+CompressedMesh compress_mesh(const MeshData& mesh, const VertexLayout& layout = {});
+MeshData decompress_mesh(const CompressedMesh& mesh);
+
+void decode_positions(const CompressedMesh& mesh, std::vector<math::Vec3>* out_positions);
+void decode_normals(const CompressedMesh& mesh, std::vector<math::Vec3>* out_normals);
+void decode_uvs(const CompressedMesh& mesh, std::vector<math::Vec2>* out_uvs);
+uint32_t read_index(const CompressedMesh& mesh, uint32_t i);
+
+// Moves the vertex streams of mesh into mesh->compressed and empties vertices, normals and uvs.
+// Indices stay 32-bit in mesh->indices, shared with LODs, meshlets and occluders.
+void compress_vertex_streams(MeshData* mesh, const VertexLayout& layout = {});
+// Restores the float vertex streams, e.g. before serializing or editing the mesh.
+void decompress_vertex_streams(MeshData* mesh);
+
+uint32_t mesh_vertex_count(const MeshData& mesh);
+// Float positions of mesh; compressed meshes are decoded into scratch.
+const math::Vec3* mesh_positions(const MeshData& mesh, std::vector<math::Vec3>* scratch);
+
+uint16_t float_to_half(float value);
+float half_to_float(uint16_t value);
+
+struct QuantizationReport {
+  size_t source_bytes = 0;
+  size_t compressed_bytes = 0;
+  float max_position_error = 0.0F;
+  float mean_position_error = 0.0F;
+  float max_normal_error_degrees = 0.0F;
+  float max_uv_error = 0.0F;
+  double decode_ns_per_vertex = 0.0;
+};
+
+QuantizationReport measure_quantization(const MeshData& mesh,
+                                        const VertexLayout& layout = {},
+                                        uint32_t decode_iterations = 16);
+
+} // namespace engine::assets
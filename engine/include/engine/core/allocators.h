@@ -0,0 +1,170 @@
+#pragma once
+
+#include "engine/core/memory_tracker.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace engine::core {
+
+struct AllocatorStats {
+  size_t capacity_bytes = 0; // reserved from upstream
+  size_t used_bytes = 0;
+  size_t peak_used_bytes = 0;
+  size_t free_bytes = 0;
+  size_t largest_free_bytes = 0;
+  size_t overhead_bytes = 0; // neither used nor free: block headers, unusable chunk tails
+  uint64_t live_allocations = 0;
+  uint64_t fallback_allocations = 0; // requests the allocator could not serve and passed upstream
+  // used_bytes + free_bytes + overhead_bytes == capacity_bytes; fallbacks are in none of them.
+
+  // 0 when all free memory is one block, approaching 1 as it splinters.
+  double fragmentation() const;
+};
+
+// Forwards to upstream and accounts every byte to a tag.
+class TrackedResource : public std::pmr::memory_resource {
+public:
+  explicit TrackedResource(MemoryTag tag,
+                           std::pmr::memory_resource* upstream = std::pmr::new_delete_resource(),
+                           MemoryTracker* tracker = &memory_tracker());
+
+  MemoryTag tag() const;
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  MemoryTag tag_;
+  std::pmr::memory_resource* upstream_;
+  MemoryTracker* tracker_;
+};
+
+// Fixed-size blocks from chunks of upstream memory with an intrusive free list;
+// larger or over-aligned requests go upstream. Not thread-safe.
+class PoolResource : public std::pmr::memory_resource {
+public:
+  PoolResource(size_t block_size,
+               size_t blocks_per_chunk = 256U,
+               std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+  ~PoolResource() override;
+
+  PoolResource(const PoolResource&) = delete;
+  PoolResource& operator=(const PoolResource&) = delete;
+
+  size_t block_size() const;
+  AllocatorStats stats() const;
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  void add_chunk();
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  size_t block_size_;
+  size_t blocks_per_chunk_;
+  std::pmr::memory_resource* upstream_;
+  std::vector<void*> chunks_;
+  FreeBlock* free_list_ = nullptr;
+  AllocatorStats stats_;
+};
+
+// Bump allocator: deallocate is a no-op and reset() frees everything at once,
+// keeping the first chunk for reuse. Not thread-safe.
+class ArenaResource : public std::pmr::memory_resource {
+public:
+  explicit ArenaResource(size_t chunk_size = 64U * 1024U,
+                         std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+  ~ArenaResource() override;
+
+  ArenaResource(const ArenaResource&) = delete;
+  ArenaResource& operator=(const ArenaResource&) = delete;
+
+  void reset();
+  AllocatorStats stats() const;
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  struct Chunk {
+    std::byte* data;
+    size_t size;
+  };
+
+  void release_chunks(size_t keep);
+
+  size_t chunk_size_;
+  std::pmr::memory_resource* upstream_;
+  std::vector<Chunk> chunks_;
+  size_t offset_ = 0; // into chunks_.back()
+  AllocatorStats stats_;
+};
+
+// Two-level segregated fit allocator over one upstream region: O(1) allocate
+// and free with immediate coalescing. When the region cannot satisfy a request
+// (or it needs more than 16-byte alignment) it falls back to upstream and
+// counts it, so a fixed capacity acts as a soft cap. Not thread-safe.
+class TlsfResource : public std::pmr::memory_resource {
+public:
+  explicit TlsfResource(size_t capacity_bytes,
+                        std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+  ~TlsfResource() override;
+
+  TlsfResource(const TlsfResource&) = delete;
+  TlsfResource& operator=(const TlsfResource&) = delete;
+
+  AllocatorStats stats() const;
+
+private:
+  static constexpr size_t block_alignment = 16U;
+  static constexpr uint32_t second_level_log2 = 4U;
+  static constexpr uint32_t second_level_count = 1U << second_level_log2;
+  static constexpr uint32_t first_level_shift = second_level_log2 + 4U; // + log2(block_alignment)
+  static constexpr uint32_t first_level_count = 64U - first_level_shift + 1U;
+  static constexpr size_t small_block_size = size_t{1} << first_level_shift;
+
+  struct Block {
+    Block* prev_physical;
+    size_t size; // payload bytes; bit 0 set while free
+    Block* next_free; // free blocks only, overlaps the payload
+    Block* prev_free;
+  };
+
+  static constexpr size_t header_size = 2U * sizeof(void*);
+  static constexpr size_t min_block_size = 2U * sizeof(void*);
+
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  static size_t block_size(const Block* block);
+  static bool is_free(const Block* block);
+  static Block* next_physical(const Block* block);
+  static void mapping(size_t size, uint32_t* out_first, uint32_t* out_second);
+
+  Block* find_free(size_t size);
+  void insert_free(Block* block);
+  void remove_free(Block* block);
+  bool owns(const void* pointer) const;
+
+  std::pmr::memory_resource* upstream_;
+  std::byte* region_ = nullptr;
+  size_t region_size_ = 0;
+  uint64_t first_level_bitmap_ = 0;
+  std::array<uint32_t, first_level_count> second_level_bitmap_{};
+  std::array<std::array<Block*, second_level_count>, first_level_count> free_heads_{};
+  AllocatorStats stats_;
+};
+
+} // namespace engine::core
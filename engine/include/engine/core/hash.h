@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace engine::core {
+
+inline constexpr uint64_t fnv1a_64_offset_basis = 14695981039346656037ULL;
+inline constexpr uint64_t fnv1a_64_prime = 1099511628211ULL;
+
+constexpr uint64_t fnv1a_64(const std::string_view text, uint64_t hash = fnv1a_64_offset_basis) {
+  for (const char c : text) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= fnv1a_64_prime;
+  }
+  return hash;
+}
+
+inline uint64_t fnv1a_64(const void* data, const size_t size, uint64_t hash = fnv1a_64_offset_basis) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= fnv1a_64_prime;
+  }
+  return hash;
+}
+
+} // namespace engine::core
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace engine::core {
+
+enum class MemoryTag : uint8_t {
+  Scene,
+  Assets,
+  Renderer,
+  Logging,
+  Count, // not a tag; keep last
+};
+
+inline constexpr size_t memory_tag_count = static_cast<size_t>(MemoryTag::Count);
+
+const char* memory_tag_name(MemoryTag tag);
+
+struct MemoryTagStats {
+  size_t current_bytes = 0;
+  size_t peak_bytes = 0;
+  size_t budget_bytes = 0; // 0 = unlimited
+  uint64_t live_allocations = 0;
+  uint64_t total_allocations = 0;
+  uint64_t budget_overruns = 0; // times current_bytes went over the budget
+};
+
+// Lock-free per-subsystem byte counters. Budgets only warn; capping is up to
+// the allocator a subsystem is given.
+class MemoryTracker {
+public:
+  void record_allocation(MemoryTag tag, size_t bytes);
+  void record_deallocation(MemoryTag tag, size_t bytes);
+
+  void set_budget(MemoryTag tag, size_t budget_bytes);
+  MemoryTagStats stats(MemoryTag tag) const;
+
+  // Tags that went over budget since the last call, one bit per tag. Polled instead of
+  // called back because an allocation site cannot safely log.
+  uint32_t take_budget_exceeded();
+
+private:
+  struct alignas(64) Counters {
+    std::atomic<size_t> current_bytes{0};
+    std::atomic<size_t> peak_bytes{0};
+    std::atomic<size_t> budget_bytes{0};
+    std::atomic<uint64_t> live_allocations{0};
+    std::atomic<uint64_t> total_allocations{0};
+    std::atomic<uint64_t> budget_overruns{0};
+  };
+
+  std::array<Counters, memory_tag_count> counters_;
+  std::atomic<uint32_t> budget_exceeded_{0};
+};
+
+MemoryTracker& memory_tracker();
+
+// Global heap, accounted to tag in memory_tracker(). Default resource of engine containers.
+std::pmr::memory_resource* tagged_resource(MemoryTag tag);
+
+} // namespace engine::core
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace engine::core {
+
+// Dense storage addressed through generation-checked handles.
+// Handle must expose `uint32_t index` and `uint32_t generation`; generation 0 is never issued,
+// so a default-constructed handle is always invalid. Erasing swaps the last value into the hole,
+// which keeps values contiguous but invalidates pointers to the moved element.
+template <typename T, typename Handle>
+class SlotMap {
+public:
+  Handle insert(T value) {
+    uint32_t slot_index = 0;
+    if (free_head_ != invalid_index) {
+      slot_index = free_head_;
+      free_head_ = slots_[slot_index].dense_index;
+    } else {
+      slot_index = static_cast<uint32_t>(slots_.size());
+      slots_.push_back(Slot{});
+    }
+
+    Slot& slot = slots_[slot_index];
+    slot.dense_index = static_cast<uint32_t>(values_.size());
+    values_.push_back(std::move(value));
+    dense_to_slot_.push_back(slot_index);
+
+    Handle handle{};
+    handle.index = slot_index;
+    handle.generation = slot.generation;
+    return handle;
+  }
+
+  T* get(const Handle handle) {
+    if (handle.index >= slots_.size() || slots_[handle.index].generation != handle.generation) {
+      return nullptr;
+    }
+    return &values_[slots_[handle.index].dense_index];
+  }
+
+  const T* get(const Handle handle) const {
+    if (handle.index >= slots_.size() || slots_[handle.index].generation != handle.generation) {
+      return nullptr;
+    }
+    return &values_[slots_[handle.index].dense_index];
+  }
+
+  bool contains(const Handle handle) const { return get(handle) != nullptr; }
+
+  bool erase(const Handle handle) {
+    if (!contains(handle)) {
+      return false;
+    }
+
+    Slot& slot = slots_[handle.index];
+    const uint32_t dense_index = slot.dense_index;
+    const uint32_t last_index = static_cast<uint32_t>(values_.size() - 1U);
+    if (dense_index != last_index) {
+      values_[dense_index] = std::move(values_[last_index]);
+      dense_to_slot_[dense_index] = dense_to_slot_[last_index];
+      slots_[dense_to_slot_[dense_index]].dense_index = dense_index;
+    }
+    values_.pop_back();
+    dense_to_slot_.pop_back();
+
+    slot.generation += 1U;
+    if (slot.generation == 0U) {
+      slot.generation = 1U;
+    }
+    slot.dense_index = free_head_;
+    free_head_ = handle.index;
+    return true;
+  }
+
+  void clear() {
+    for (const uint32_t slot_index : dense_to_slot_) {
+      Slot& slot = slots_[slot_index];
+      slot.generation += 1U;
+      if (slot.generation == 0U) {
+        slot.generation = 1U;
+      }
+      slot.dense_index = free_head_;
+      free_head_ = slot_index;
+    }
+    values_.clear();
+    dense_to_slot_.clear();
+  }
+
+  void reserve(const size_t capacity) {
+    values_.reserve(capacity);
+    dense_to_slot_.reserve(capacity);
+    slots_.reserve(capacity);
+  }
+
+  // Handle of the value stored at a dense position, for iteration alongside values().
+  Handle handle_at(const size_t dense_index) const {
+    Handle handle{};
+    handle.index = dense_to_slot_[dense_index];
+    handle.generation = slots_[handle.index].generation;
+    return handle;
+  }
+
+  std::vector<T>& values() { return values_; }
+  const std::vector<T>& values() const { return values_; }
+
+  size_t size() const { return values_.size(); }
+  bool empty() const { return values_.empty(); }
+
+private:
+  static constexpr uint32_t invalid_index = 0xFFFFFFFFU;
+
+  struct Slot {
+    uint32_t dense_index = 0; // next free slot while the slot is unused
+    uint32_t generation = 1;
+  };
+
+  std::vector<T> values_;
+  std::vector<uint32_t> dense_to_slot_;
+  std::vector<Slot> slots_;
+  uint32_t free_head_ = invalid_index;
+};
+
+} // namespace engine::core
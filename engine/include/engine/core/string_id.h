@@ -0,0 +1,66 @@
+#pragma once
+
+#include "engine/core/hash.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace engine::core {
+
+class Logger;
+
+// 64-bit FNV-1a hash of a string. Comparing and hashing ids is an integer
+// operation; the text is only kept in the global intern table for debugging
+// and for the few places that need the original string back.
+class StringId {
+public:
+  constexpr StringId() = default;
+  constexpr explicit StringId(const uint64_t value)
+      : value_(value) {}
+  constexpr explicit StringId(const std::string_view text)
+      : value_(fnv1a_64(text)) {}
+
+  constexpr uint64_t value() const { return value_; }
+  constexpr bool valid() const { return value_ != 0; }
+
+  friend constexpr bool operator==(StringId a, StringId b) = default;
+  friend constexpr bool operator<(const StringId a, const StringId b) { return a.value_ < b.value_; }
+
+private:
+  uint64_t value_ = 0;
+};
+
+struct StringIdHash {
+  size_t operator()(const StringId id) const { return static_cast<size_t>(id.value()); }
+};
+
+struct StringTableStats {
+  uint32_t strings = 0;
+  size_t bytes = 0;
+  uint64_t collisions = 0; // different strings that hashed to the same id; the first one wins
+};
+
+// Thread safe. Interned text lives until process exit, so the views stay valid.
+StringId intern(std::string_view text);
+std::string_view string_id_text(StringId id); // empty if the id was never interned
+StringTableStats string_table_stats();
+// Collisions are logged as errors to logger (nullptr: only counted). It must stay alive
+// until it is replaced or cleared.
+void set_string_table_logger(Logger* logger);
+
+namespace literals {
+
+consteval StringId operator""_sid(const char* text, const size_t length) {
+  return StringId(std::string_view(text, length));
+}
+
+} // namespace literals
+
+} // namespace engine::core
+
+template <>
+struct std::hash<engine::core::StringId> {
+  size_t operator()(const engine::core::StringId id) const { return static_cast<size_t>(id.value()); }
+};
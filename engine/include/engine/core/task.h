@@ -0,0 +1,20 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+
+namespace engine::core {
+
+// Fire-and-forget coroutine. Runs eagerly until its first suspension and frees
+// itself on completion; whoever resumes it (e.g. AsyncFileIo::poll) drives it.
+struct DetachedTask {
+  struct promise_type {
+    DetachedTask get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+} // namespace engine::core
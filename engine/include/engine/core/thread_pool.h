@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::core {
+
+// Fixed set of worker threads draining a FIFO job queue.
+class ThreadPool {
+public:
+  // 0 picks hardware_concurrency - 1 (at least one worker).
+  explicit ThreadPool(uint32_t thread_count = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void submit(std::function<void()> job);
+
+  // Blocks until the queue is empty and no job is running.
+  void wait_idle();
+
+  uint32_t thread_count() const;
+
+private:
+  void worker_main();
+
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable job_ready_;
+  std::condition_variable idle_;
+  std::deque<std::function<void()>> jobs_;
+  uint32_t active_jobs_ = 0;
+  bool stopping_ = false;
+};
+
+} // namespace engine::core
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "engine/input/input_state.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine::input {
+
+enum class InputEventType : uint8_t {
+  KeyDown,
+  KeyUp,
+  MouseMove, // x, y: absolute position
+  Scroll,    // y: wheel delta
+};
+
+struct InputEvent {
+  uint64_t timestamp_ns = 0; // on the event_clock_ns() clock; when the platform layer queued the event
+  InputEventType type = InputEventType::KeyDown;
+  Key key = Key::Unknown;
+  float x = 0.0F;
+  float y = 0.0F;
+};
+
+// Monotonic nanoseconds shared by event timestamps and latency measurements.
+uint64_t event_clock_ns();
+
+// Lock-free single-producer/single-consumer queue of input events. The
+// producer may be an event-pump thread; the simulation thread drains it.
+// A full ring drops new events and counts them.
+class InputEventRing {
+public:
+  // Capacity is rounded up to a power of two.
+  explicit InputEventRing(size_t capacity = 1024U);
+
+  bool push(const InputEvent& event);
+  bool pop(InputEvent* out_event);
+
+  uint64_t dropped() const;
+
+private:
+  std::vector<InputEvent> events_;
+  size_t mask_ = 0;
+  alignas(64) std::atomic<size_t> head_{0}; // next write, owned by the producer
+  alignas(64) std::atomic<size_t> tail_{0}; // next read, owned by the consumer
+  alignas(64) std::atomic<uint64_t> dropped_{0};
+};
+
+} // namespace engine::input
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+namespace engine::input {
+
+struct LatencySummary {
+  uint32_t samples = 0; // within the window
+  double avg_ms = 0.0;
+  double p95_ms = 0.0;
+  double max_ms = 0.0;
+};
+
+// Input latency over a sliding window of recent samples, in two stages: event
+// timestamp to the simulation frame that consumes it, and event timestamp to
+// the present of the frame built from it. The timestamp is only as early as the
+// event source provides; time spent in the OS before that is not included. The
+// stages may be reported from different threads.
+class InputLatencyTracker {
+public:
+  static constexpr uint32_t window_size = 256U;
+
+  void record_consumed(uint64_t event_ns, uint64_t consumed_ns);
+  void record_presented(uint64_t event_ns, uint64_t presented_ns);
+
+  LatencySummary consume_latency() const;
+  LatencySummary present_latency() const;
+
+private:
+  struct Window {
+    std::array<float, window_size> samples_ms{};
+    uint32_t count = 0;
+    uint32_t next = 0;
+
+    void add(uint64_t from_ns, uint64_t to_ns);
+    LatencySummary summarize() const;
+  };
+
+  mutable std::mutex mutex_;
+  Window consumed_;
+  Window presented_;
+};
+
+} // namespace engine::input
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "engine/input/input_event.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace engine::input {
+
+// On-disk layout (little endian):
+//   InputRecordingHeader | per frame: f64 delta_seconds, u32 event_count, packed events
+// A packed event is type (u8) and key (u8), followed by x, y (f32) for MouseMove or y (f32) for Scroll.
+// Capture timestamps are not stored; replayed frames are driven by delta_seconds alone.
+inline constexpr uint32_t input_recording_magic = 0x43524E49U; // "INRC"
+inline constexpr uint32_t input_recording_version = 1U;
+
+struct InputRecordingHeader {
+  uint32_t magic = input_recording_magic;
+  uint32_t version = input_recording_version;
+  uint32_t frame_count = 0;
+  uint32_t event_count = 0;
+};
+
+static_assert(sizeof(InputRecordingHeader) == 16);
+
+struct RecordedFrame {
+  double delta_seconds = 0.0;
+  uint32_t first_event = 0;
+  uint32_t event_count = 0;
+};
+
+// Per-frame input events and frame deltas, so a session can be replayed with
+// the same camera path and simulation steps regardless of how fast it runs.
+class InputRecording {
+public:
+  void clear();
+  void add_frame(double delta_seconds, std::span<const InputEvent> events);
+
+  size_t frame_count() const;
+  const RecordedFrame& frame(size_t index) const;
+  std::span<const InputEvent> events(const RecordedFrame& frame) const;
+  double duration_seconds() const;
+
+  bool save(const std::string& path, std::string* out_error = nullptr) const;
+  bool load(const std::string& path, std::string* out_error = nullptr);
+
+private:
+  std::vector<RecordedFrame> frames_;
+  std::vector<InputEvent> events_;
+};
+
+} // namespace engine::input
@@ -2,11 +2,13 @@
 
 #include "engine/math/vec2.h"
 
-#include <unordered_set>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
 
 namespace engine::input {
 
-enum class Key {
+enum class Key : uint8_t {
   Unknown,
   Escape,
   F1,
@@ -20,7 +22,12 @@ enum class Key {
   Right,
   Up,
   Down,
+  Count, // not a key; keep last
 };
+
+inline constexpr size_t key_count = static_cast<size_t>(Key::Count);
+
+struct InputEvent;
 
 class InputState {
 public:
@@ -30,6 +37,7 @@ public:
   void on_key_up(Key key);
   void on_mouse_move(float x, float y);
   void on_scroll(float delta_y);
+  void apply(const InputEvent& event);
 
   bool is_down(Key key) const;
   bool was_pressed(Key key) const;
@@ -46,9 +54,9 @@ public:
   float scrollDelta() const;
 
 private:
-  std::unordered_set<Key> down_;
-  std::unordered_set<Key> pressed_;
-  std::unordered_set<Key> released_;
+  std::bitset<key_count> down_;
+  std::bitset<key_count> pressed_;
+  std::bitset<key_count> released_;
 
   math::Vec2 mouse_position_{};
   math::Vec2 mouse_delta_{};
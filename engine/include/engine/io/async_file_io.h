@@ -0,0 +1,148 @@
+#pragma once
+
+#include "engine/core/thread_pool.h"
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace engine::io {
+
+enum class AsyncIoBackend {
+  None,
+  IoUring,
+  ThreadPool,
+};
+
+struct ReadRequest {
+  std::string path;
+  uint64_t offset = 0;
+  uint64_t size = 0; // 0 = to the end of the file
+};
+
+struct ReadCompletion {
+  uint64_t id = 0;
+  bool ok = false;
+  std::string path;
+  std::string error;
+  std::vector<uint8_t> bytes;
+};
+
+using ReadCallback = std::function<void(ReadCompletion& completion)>;
+
+struct AsyncIoStats {
+  uint64_t submitted = 0;
+  uint64_t completed = 0;
+  uint64_t failed = 0;
+  uint64_t bytes_read = 0;
+  uint64_t submit_batches = 0; // io_uring_enter calls / thread pool flushes
+  uint32_t queued = 0;
+  uint32_t in_flight = 0;
+  uint32_t peak_in_flight = 0;
+};
+
+class AsyncFileIo;
+
+// co_await io.read_async({path}) suspends the coroutine until poll() sees the
+// read finish, then resumes it on the polling thread. If the queue is destroyed
+// first, the suspended coroutine is destroyed without being resumed.
+class ReadAwaitable {
+public:
+  ReadAwaitable(AsyncFileIo& io, ReadRequest request);
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  ReadCompletion await_resume();
+
+private:
+  AsyncFileIo* io_ = nullptr;
+  ReadRequest request_;
+  ReadCompletion result_;
+};
+
+// Batched asynchronous whole-file / ranged reads. On Linux the requests go to an
+// io_uring submission queue, so many reads stay in flight without a blocked
+// thread per request; elsewhere (or when io_uring is unavailable) blocking reads
+// run on a small thread pool. Not thread safe: read/submit/poll belong to one
+// thread, normally the frame loop, and callbacks run inside poll().
+class AsyncFileIo {
+public:
+  explicit AsyncFileIo(uint32_t queue_depth = 128U, bool force_thread_pool = false);
+  ~AsyncFileIo();
+
+  AsyncFileIo(const AsyncFileIo&) = delete;
+  AsyncFileIo& operator=(const AsyncFileIo&) = delete;
+
+  // Queues a read; nothing reaches the kernel until submit() or poll().
+  uint64_t read(ReadRequest request, ReadCallback callback);
+  ReadAwaitable read_async(ReadRequest request);
+
+  // Pushes queued reads as one batch, up to the queue depth.
+  void submit();
+
+  // Non-blocking. Submits queued reads, reaps completions and runs their callbacks.
+  uint32_t poll();
+
+  // Blocks until every queued and in-flight read has completed.
+  void wait_all();
+
+  AsyncIoBackend backend() const;
+  AsyncIoStats stats() const;
+  uint32_t pending() const;
+
+private:
+  struct Ring;
+
+  struct Slot {
+    uint64_t id = 0;
+    ReadRequest request;
+    ReadCallback callback;
+    std::vector<uint8_t> bytes;
+    uint64_t done = 0;
+    int fd = -1;
+    bool in_use = false;
+  };
+  // io_uring reads target Slot::bytes directly; slots_ never relocates a slot, and moving one
+  // (e.g. to recycle it) must keep the buffer where it is.
+  static_assert(std::is_nothrow_move_constructible_v<Slot>);
+
+  struct Finished {
+    uint32_t slot = 0;
+    bool ok = false;
+    std::string error;
+    std::vector<uint8_t> bytes; // thread pool backend only; io_uring reads into the slot
+  };
+
+  uint32_t acquire_slot();
+  void push_finished(Finished finished);
+  void start_uring(uint32_t slot);
+  bool queue_uring_read(uint32_t slot);
+  bool reap_uring(bool wait);
+  void start_thread_pool(uint32_t slot);
+  uint32_t finish();
+
+  uint32_t queue_depth_ = 0;
+  AsyncIoBackend backend_ = AsyncIoBackend::None;
+  std::unique_ptr<Ring> ring_;
+  std::unique_ptr<core::ThreadPool> pool_;
+
+  uint64_t next_id_ = 1;
+  std::deque<Slot> slots_; // stable addresses while reads are in flight
+  std::vector<uint32_t> free_slots_;
+  std::vector<uint32_t> queued_;
+  std::vector<uint32_t> resubmit_; // short reads waiting for ring space
+  uint32_t in_flight_ = 0;
+
+  std::mutex finished_mutex_; // thread pool workers -> poll()
+  std::vector<Finished> finished_;
+
+  AsyncIoStats stats_;
+};
+
+} // namespace engine::io
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::io {
+
+enum class FileWatchBackend {
+  None,
+  Inotify,
+  Polling,
+};
+
+// Recursive directory watcher. Uses inotify on Linux and falls back to periodic
+// timestamp scans elsewhere (or when inotify is unavailable / forced off).
+class FileWatcher {
+public:
+  FileWatcher() = default;
+  ~FileWatcher();
+
+  FileWatcher(const FileWatcher&) = delete;
+  FileWatcher& operator=(const FileWatcher&) = delete;
+
+  bool watch_directory(const std::string& root, bool force_polling = false);
+  void stop();
+
+  // Non-blocking. Appends each changed file path once (generic format, rooted at the watched directory).
+  void poll(std::vector<std::string>* out_changed_paths);
+
+  void set_poll_interval(double seconds);
+  FileWatchBackend backend() const;
+
+private:
+  struct FileStamp {
+    std::filesystem::file_time_type write_time{};
+    uintmax_t size = 0;
+  };
+
+  bool start_inotify();
+  void add_inotify_watch(const std::filesystem::path& directory);
+  void poll_inotify(std::vector<std::string>* out_changed_paths);
+
+  void scan(std::unordered_map<std::string, FileStamp>* out_stamps) const;
+  void poll_scan(std::vector<std::string>* out_changed_paths);
+
+  std::filesystem::path root_;
+  FileWatchBackend backend_ = FileWatchBackend::None;
+
+  int inotify_fd_ = -1;
+  std::unordered_map<int, std::filesystem::path> watch_dirs_;
+
+  std::unordered_map<std::string, FileStamp> stamps_;
+  std::chrono::steady_clock::duration poll_interval_ = std::chrono::milliseconds(500);
+  std::chrono::steady_clock::time_point last_scan_{};
+};
+
+} // namespace engine::io
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace engine::io {
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool open(const std::string& path);
+  void close();
+
+  // Hints the OS to read the range ahead of use.
+  void prefetch(size_t offset, size_t size) const;
+
+  bool is_open() const;
+  const uint8_t* data() const;
+  size_t size() const;
+
+private:
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+#if defined(_WIN32)
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#else
+  int fd_ = -1;
+#endif
+};
+
+} // namespace engine::io
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "engine/io/mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::io {
+
+enum class PakCompression : uint32_t {
+  None = 0,
+  Lz4 = 1,
+  Zstd = 2,
+};
+
+// On-disk layout, in host byte order since the header and table of contents are used in place from
+// the mapping (paks are built for the platform that ships them):
+//   PakHeader | entry data (each aligned) | PakEntry[entry_count] sorted by path_hash | path names
+inline constexpr uint32_t pak_magic = 0x4B415041U; // "APAK"
+inline constexpr uint32_t pak_version = 1U;
+// Largest decompressed entry open() accepts, so a corrupt size cannot force a huge allocation.
+inline constexpr uint64_t pak_max_entry_size = 1ULL << 30U;
+
+struct PakHeader {
+  uint32_t magic = pak_magic;
+  uint32_t version = pak_version;
+  uint32_t entry_count = 0;
+  uint32_t alignment = 0;
+  uint64_t toc_offset = 0;
+  uint64_t names_offset = 0;
+};
+
+struct PakEntry {
+  uint64_t path_hash = 0;
+  uint64_t offset = 0;
+  uint64_t stored_size = 0;
+  uint64_t size = 0;
+  uint32_t compression = 0;
+  uint32_t name_offset = 0; // into the names block, null terminated
+};
+
+static_assert(sizeof(PakHeader) == 32);
+static_assert(sizeof(PakEntry) == 40);
+
+std::string normalize_virtual_path(std::string_view path);
+uint64_t hash_virtual_path(std::string_view path);
+
+bool pak_compression_supported(PakCompression compression);
+const char* pak_compression_name(PakCompression compression);
+
+class PakArchive {
+public:
+  bool open(const std::string& path, std::string* out_error = nullptr);
+  void close();
+
+  const PakEntry* find(std::string_view virtual_path) const;
+  std::string_view entry_name(const PakEntry& entry) const;
+
+  // Zero-copy view of the stored bytes; for compressed entries this is the compressed payload.
+  std::span<const uint8_t> stored_bytes(const PakEntry& entry) const;
+  bool decompress(const PakEntry& entry, std::vector<uint8_t>* out_bytes, std::string* out_error = nullptr) const;
+  void prefetch(const PakEntry& entry) const;
+
+  std::span<const PakEntry> entries() const;
+  bool is_open() const;
+  const std::string& path() const;
+
+private:
+  MappedFile file_;
+  std::string path_;
+  const PakHeader* header_ = nullptr;
+  const PakEntry* entries_ = nullptr;
+  const char* names_ = nullptr;
+  size_t names_size_ = 0;
+};
+
+class PakWriter {
+public:
+  explicit PakWriter(uint32_t alignment = 16U);
+
+  // Falls back to storing uncompressed when the codec is unavailable or does not shrink the data.
+  bool add_file(std::string_view virtual_path,
+                std::span<const uint8_t> bytes,
+                PakCompression compression = PakCompression::None,
+                std::string* out_error = nullptr);
+
+  bool write(const std::string& path, std::string* out_error = nullptr) const;
+
+  size_t entry_count() const;
+
+private:
+  struct PendingEntry {
+    std::string name;
+    uint64_t path_hash = 0;
+    uint64_t size = 0;
+    PakCompression compression = PakCompression::None;
+    std::vector<uint8_t> stored;
+  };
+
+  uint32_t alignment_ = 16U;
+  std::vector<PendingEntry> entries_;
+};
+
+} // namespace engine::io
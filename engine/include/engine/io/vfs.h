@@ -0,0 +1,66 @@
+#pragma once
+
+#include "engine/io/pak_archive.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace engine::io {
+
+// Result of a VFS read. Uncompressed pak entries are returned as a view into the
+// archive mapping (valid while the Vfs is alive); everything else owns its bytes.
+struct FileData {
+  bool ok = false;
+  std::string error;
+
+  std::span<const uint8_t> bytes() const;
+  bool zero_copy() const;
+
+  std::span<const uint8_t> view;
+  std::vector<uint8_t> storage;
+};
+
+struct VfsStats {
+  uint64_t pak_reads = 0;
+  uint64_t zero_copy_reads = 0;
+  uint64_t directory_reads = 0;
+  uint64_t misses = 0;
+};
+
+// Mounts are searched newest first. Mounting is not thread safe; reads are.
+class Vfs {
+public:
+  bool mount_pak(const std::string& pak_path, std::string* out_error = nullptr);
+  void mount_directory(const std::string& root);
+  void unmount_all();
+
+  FileData read(std::string_view virtual_path) const;
+  bool exists(std::string_view virtual_path) const;
+  void prefetch(std::string_view virtual_path) const;
+
+  // Filesystem path when the newest mount providing virtual_path is a directory,
+  // empty when it comes from a pak (already mapped) or does not exist.
+  std::string native_path(std::string_view virtual_path) const;
+
+  VfsStats stats() const;
+
+private:
+  struct Mount {
+    std::unique_ptr<PakArchive> pak;
+    std::string directory;
+  };
+
+  std::vector<Mount> mounts_;
+
+  mutable std::atomic<uint64_t> pak_reads_{0};
+  mutable std::atomic<uint64_t> zero_copy_reads_{0};
+  mutable std::atomic<uint64_t> directory_reads_{0};
+  mutable std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace engine::io
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "engine/math/mat4.h"
+#include "engine/math/vec3.h"
+
+#include <array>
+#include <cmath>
+
+namespace engine::math {
+
+// n . p + d >= 0 is inside.
+struct Plane {
+  Vec3 normal;
+  float d = 0.0F;
+};
+
+struct Frustum {
+  std::array<Plane, 6> planes{}; // left, right, bottom, top, near, far
+};
+
+// Gribb/Hartmann extraction from a column-major view-projection matrix.
+inline Frustum frustum_from_matrix(const Mat4& m) {
+  const auto row = [&m](const int r) { return Vec4{m.m[r], m.m[4 + r], m.m[8 + r], m.m[12 + r]}; };
+  const Vec4 r0 = row(0);
+  const Vec4 r1 = row(1);
+  const Vec4 r2 = row(2);
+  const Vec4 r3 = row(3);
+
+  const auto make = [](const Vec4& a, const Vec4& b, const float sign) {
+    Plane plane{{a.x + (sign * b.x), a.y + (sign * b.y), a.z + (sign * b.z)}, a.w + (sign * b.w)};
+    const float len = length(plane.normal);
+    if (len > 0.000001F) {
+      plane.normal = plane.normal * (1.0F / len);
+      plane.d /= len;
+    }
+    return plane;
+  };
+
+  Frustum out{};
+  out.planes[0] = make(r3, r0, 1.0F);
+  out.planes[1] = make(r3, r0, -1.0F);
+  out.planes[2] = make(r3, r1, 1.0F);
+  out.planes[3] = make(r3, r1, -1.0F);
+  out.planes[4] = make(r3, r2, 1.0F);
+  out.planes[5] = make(r3, r2, -1.0F);
+  return out;
+}
+
+inline bool sphere_in_frustum(const Frustum& frustum, const Vec3& center, const float radius) {
+  for (const Plane& plane : frustum.planes) {
+    if (dot(plane.normal, center) + plane.d < -radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool aabb_in_frustum(const Frustum& frustum, const Vec3& min, const Vec3& max) {
+  for (const Plane& plane : frustum.planes) {
+    // Farthest corner along the plane normal.
+    const Vec3 p{
+        plane.normal.x >= 0.0F ? max.x : min.x,
+        plane.normal.y >= 0.0F ? max.y : min.y,
+        plane.normal.z >= 0.0F ? max.z : min.z,
+    };
+    if (dot(plane.normal, p) + plane.d < 0.0F) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// World-space AABB of a transformed local AABB (Arvo).
+inline void transform_aabb(const Mat4& m, const Vec3& min, const Vec3& max, Vec3* out_min, Vec3* out_max) {
+  const Vec3 center = (min + max) * 0.5F;
+  const Vec3 extent = (max - min) * 0.5F;
+  const Vec3 world_center = multiply_point(m, center);
+  const Vec3 world_extent{
+      (std::fabs(m.m[0]) * extent.x) + (std::fabs(m.m[4]) * extent.y) + (std::fabs(m.m[8]) * extent.z),
+      (std::fabs(m.m[1]) * extent.x) + (std::fabs(m.m[5]) * extent.y) + (std::fabs(m.m[9]) * extent.z),
+      (std::fabs(m.m[2]) * extent.x) + (std::fabs(m.m[6]) * extent.y) + (std::fabs(m.m[10]) * extent.z),
+  };
+  *out_min = world_center - world_extent;
+  *out_max = world_center + world_extent;
+}
+
+} // namespace engine::math
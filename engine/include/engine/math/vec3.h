@@ -46,4 +46,8 @@ inline Vec3 normalize(const Vec3& v) {
   return {v.x / len, v.y / len, v.z / len};
 }
 
+inline Vec3 lerp(const Vec3& a, const Vec3& b, const float t) {
+  return a + ((b - a) * t);
+}
+
 } // namespace engine::math
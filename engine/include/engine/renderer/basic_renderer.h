@@ -1,11 +1,24 @@
 #pragma once
 
+#include "engine/assets/geometry_pool.h"
 #include "engine/assets/mesh_data.h"
+#include "engine/assets/model_data.h"
+#include "engine/assets/vertex_format.h"
+#include "engine/core/memory_tracker.h"
 #include "engine/math/mat4.h"
+#include "engine/renderer/cluster_culler.h"
+#include "engine/renderer/frame_allocator.h"
+#include "engine/renderer/render_capture.h"
+#include "engine/renderer/render_stats.h"
+#include "engine/renderer/vertex_projection.h"
 #include "engine/runtime/camera.h"
 #include "engine/runtime/transform.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
 
 namespace engine::renderer {
 
@@ -15,28 +28,83 @@ struct NativeWindowData {
   void* sdl_window = nullptr;
 };
 
+enum class HeadlessBackend : uint8_t {
+  Software, // SDL's software rasterizer drawing into an off-screen surface
+  BgfxNoop, // bgfx with its no-op renderer; needs a bgfx build
+};
+
 class BasicRenderer {
 public:
-  bool init(int width, int height, NativeWindowData native_window_data);
+  // With off_window_thread, init runs on a thread other than the one that created the window and
+  // only backends that allow it are tried: bgfx, except on macOS. SDL's render API has to stay on
+  // the window's thread on several platforms, so init then fails instead of falling back to SDL.
+  bool init(int width, int height, NativeWindowData native_window_data, bool off_window_thread = false);
+  // Renders without a window, e.g. to replay captures.
+  bool init_headless(int width, int height, HeadlessBackend backend);
   void shutdown();
 
   void resize(int width, int height);
 
   void begin_frame(uint32_t clear_color_rgba = 0x1e1e28ffU);
-  void submit_mesh(const assets::MeshData* mesh, const math::Mat4& world_matrix, const runtime::Camera& camera);
+  void submit_mesh(const std::shared_ptr<const assets::MeshData>& mesh,
+                   const math::Mat4& world_matrix,
+                   const runtime::Camera& camera,
+                   uint32_t lod = 0);
+  void submit_model(const assets::ModelData* model,
+                    const assets::GeometryPool& pool,
+                    const math::Mat4& world_matrix,
+                    const runtime::Camera& camera);
+  // Objects the caller culled before submission this frame; counted in the geometry pass.
+  void add_culled(uint32_t count);
   void end_frame();
 
   bool enabled() const;
   bool using_bgfx_backend() const;
+  // Draws submitted so far this frame, across all passes.
   uint32_t draw_calls() const;
+  // Complete statistics of the last frame that reached end_frame().
+  const RenderStats& last_frame_stats() const;
+
+  // Per-frame memory for dynamic geometry the backend consumes within the frame, shared by every pass.
+  // Allocate between begin_frame() and end_frame(); allocations last until the next begin_frame().
+  FrameAllocator& frame_allocator();
+  const FrameAllocator& frame_allocator() const;
+
+  // Frames, submit_mesh and add_culled calls are also recorded into capture (nullptr stops), whether
+  // or not the renderer is enabled. submit_model is not captured.
+  void set_capture(RenderCapture* capture);
+
+  // LOD 0 submissions of meshes with meshlets only draw clusters that pass frustum and cone tests.
+  void set_cluster_culling(bool enabled);
+  const ClusterCullStats& cluster_stats() const;
 
 private:
+  void record_draw(const void* geometry, size_t vertex_count, size_t index_count);
+  // Returns false when nothing was drawn (out-of-range indices).
+  bool draw_indexed(const math::Vec3* vertices,
+                    size_t vertex_count,
+                    const uint32_t* indices,
+                    size_t index_count,
+                    const math::Mat4& world_matrix,
+                    const runtime::Camera& camera);
+
   int width_ = 1;
   int height_ = 1;
   bool enabled_ = false;
   bool using_bgfx_ = false;
   void* sdl_renderer_ = nullptr;
-  uint32_t draw_calls_ = 0;
+  void* sdl_surface_ = nullptr; // headless software target
+  RenderCapture* capture_ = nullptr;
+  RenderStats frame_stats_;
+  RenderStats last_frame_stats_;
+  const void* bound_geometry_ = nullptr;
+  bool cluster_culling_ = true;
+  ClusterCuller cluster_culler_;
+  std::vector<uint32_t> cluster_indices_;
+  std::vector<math::Vec3> decoded_positions_;
+  FrameAllocator frame_allocator_;
+  std::pmr::vector<ScreenVertex> projected_vertices_{core::tagged_resource(core::MemoryTag::Renderer)};
+  std::pmr::vector<uint8_t> overflow_vertices_{core::tagged_resource(core::MemoryTag::Renderer)};
 };
 
 } // namespace engine::renderer
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "engine/assets/mesh_data.h"
+#include "engine/math/frustum.h"
+#include "engine/math/mat4.h"
+#include "engine/runtime/camera.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::renderer {
+
+struct ClusterCullStats {
+  uint32_t meshes = 0;
+  uint32_t clusters_tested = 0;
+  uint32_t frustum_culled = 0;
+  uint32_t backface_culled = 0;
+  uint64_t triangles_submitted = 0;
+  uint64_t triangles_total = 0;
+};
+
+// Per-meshlet frustum and normal-cone culling. Surviving meshlets are
+// expanded into one compacted index list over the mesh's vertex buffer.
+class ClusterCuller {
+public:
+  void reset_stats();
+  const ClusterCullStats& stats() const;
+
+  // Returns false when the mesh has no meshlets; out_indices is then untouched.
+  bool cull(const assets::MeshData& mesh,
+            const math::Mat4& world,
+            const runtime::Camera& camera,
+            std::vector<uint32_t>* out_indices);
+
+private:
+  void update_camera(const runtime::Camera& camera);
+
+  ClusterCullStats stats_;
+  math::Mat4 view_projection_;
+  math::Frustum frustum_;
+  math::Vec3 camera_position_;
+  bool has_camera_ = false;
+};
+
+} // namespace engine::renderer
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "engine/core/memory_tracker.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace engine::renderer {
+
+// Valid until the next begin_frame().
+struct FrameAllocation {
+  uint8_t* data = nullptr;
+  uint32_t offset = 0; // from the start of this frame's block, e.g. to bind a sub-range
+  uint32_t size = 0;
+
+  explicit operator bool() const { return data != nullptr; }
+};
+
+struct FrameAllocatorSettings {
+  uint32_t bytes_per_frame = 4U * 1024U * 1024U;
+};
+
+struct FrameAllocatorStats {
+  uint32_t capacity_bytes = 0;
+  uint32_t used_bytes = 0; // last frame
+  uint32_t peak_used_bytes = 0;
+  uint32_t overflows = 0; // last frame
+  uint64_t total_overflows = 0;
+
+  double utilization() const;
+};
+
+// Per-frame linear allocator for dynamic vertices and indices the backend reads
+// once. begin_frame() rewinds its single block, so everything allocated must have
+// been consumed by then; the CPU backends copy it during the draw call. A request
+// that does not fit fails and is counted, and callers fall back to their own memory.
+// Not thread-safe.
+class FrameAllocator {
+public:
+  explicit FrameAllocator(const FrameAllocatorSettings& settings = {},
+                          std::pmr::memory_resource* resource = core::tagged_resource(core::MemoryTag::Renderer));
+  ~FrameAllocator();
+
+  FrameAllocator(const FrameAllocator&) = delete;
+  FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+  const FrameAllocatorSettings& settings() const;
+
+  void begin_frame();
+  FrameAllocation allocate(size_t bytes, size_t alignment = 16U);
+  void end_frame();
+
+  const FrameAllocatorStats& stats() const;
+
+private:
+  FrameAllocatorSettings settings_;
+  std::pmr::memory_resource* resource_;
+  uint8_t* data_ = nullptr; // allocated on first use
+  uint32_t used_ = 0;
+  uint32_t overflows_ = 0;
+  FrameAllocatorStats stats_;
+};
+
+} // namespace engine::renderer
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "engine/assets/asset_manager.h"
+#include "engine/assets/mesh_data.h"
+#include "engine/core/allocators.h"
+#include "engine/core/memory_tracker.h"
+#include "engine/input/input_latency.h"
+#include "engine/math/mat4.h"
+#include "engine/renderer/occlusion_culler.h"
+#include "engine/runtime/camera.h"
+#include "engine/runtime/lod_selector.h"
+#include "engine/time/fixed_timestep.h"
+#include "engine/time/frame_pacer.h"
+#include "engine/time/frame_timer.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace engine::renderer {
+
+struct DrawCommand {
+  // Owning, so a hot reload or eviction on the simulation side cannot free data still queued for drawing.
+  std::shared_ptr<const assets::MeshData> mesh;
+  math::Mat4 world;
+  uint32_t lod = 0;
+};
+
+struct OverlayData {
+  bool visible = false;
+  time::FrameMetrics metrics;
+  double tick_rate_hz = 0.0;
+  time::FixedStepStats fixed_step;
+  time::FramePacerStats pacer;
+  uint32_t entity_count = 0;
+  uint32_t mesh_count = 0;
+  assets::AssetStats asset_stats;
+  runtime::LodStats lod_stats;
+  OcclusionStats occlusion_stats;
+  bool threaded_render = false;
+  double render_ms = 0.0;
+  double render_wait_ms = 0.0;
+  uint32_t frames_in_flight = 0;
+  input::LatencySummary input_consume_latency;
+  input::LatencySummary input_present_latency;
+  uint64_t input_events_dropped = 0;
+  std::array<core::MemoryTagStats, core::memory_tag_count> memory{};
+  core::AllocatorStats scene_nodes;
+};
+
+// Everything the renderer needs for one frame, copied out of simulation state
+// so the render side never reads the scene or the asset manager.
+struct FramePacket {
+  uint64_t frame_index = 0;
+  runtime::Camera camera; // matrices and viewport as of the end of simulation
+  uint32_t clear_color = 0x1e1e28ffU;
+  std::vector<DrawCommand> draws; // visible draws only, already culled and LOD-selected
+  uint32_t culled = 0;            // draws dropped by frustum and occlusion culling
+  OverlayData overlay;
+  uint64_t input_timestamp_ns = 0; // oldest input event applied this frame, 0 if none
+};
+
+} // namespace engine::renderer
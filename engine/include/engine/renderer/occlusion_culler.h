@@ -0,0 +1,132 @@
+#pragma once
+
+#include "engine/assets/mesh_data.h"
+#include "engine/core/allocators.h"
+#include "engine/core/memory_tracker.h"
+#include "engine/math/frustum.h"
+#include "engine/math/mat4.h"
+#include "engine/math/vec4.h"
+#include "engine/runtime/camera.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace engine::core {
+class ThreadPool;
+}
+
+namespace engine::renderer {
+
+struct OcclusionSettings {
+  uint32_t width = 256U;
+  uint32_t height = 128U;
+  uint32_t max_occluders = 32U;
+  float min_occluder_screen_fraction = 0.01F; // projected bounding sphere area / screen area
+  double budget_ms = 1.0;
+};
+
+struct OcclusionStats {
+  uint32_t occluder_candidates = 0;
+  uint32_t occluders_rasterized = 0;
+  uint32_t occluder_triangles = 0;
+  uint32_t occluder_limit = 0; // adapted to stay within budget_ms
+  uint32_t tested = 0;
+  uint32_t frustum_culled = 0;
+  uint32_t occluded = 0;
+  double raster_ms = 0.0;
+  double pyramid_ms = 0.0;
+  double test_ms = 0.0;
+
+  double total_ms() const { return raster_ms + pyramid_ms + test_ms; }
+};
+
+struct OcclusionQuery {
+  assets::Aabb bounds; // local space
+  math::Mat4 world;
+};
+
+// Software occlusion culling. Large occluders are rasterized into a low
+// resolution depth buffer (SSE when available, banded across the job pool),
+// reduced to a max-depth hierarchical-Z pyramid, and candidates' projected
+// bounds are then tested against the pyramid level their footprint fits in.
+// Depth is NDC z, smaller is nearer; uncovered texels stay at the far plane.
+class OcclusionCuller {
+public:
+  explicit OcclusionCuller(core::ThreadPool* pool = nullptr, const OcclusionSettings& settings = {});
+
+  void set_settings(const OcclusionSettings& settings);
+  const OcclusionSettings& settings() const;
+
+  void begin_frame(const runtime::Camera& camera);
+  // Candidates are ranked by projected size; build() keeps the largest ones.
+  void add_occluder(const assets::MeshData& mesh, const math::Mat4& world);
+  void build();
+
+  // Frustum test, then conservative HiZ test. Call after build().
+  bool is_visible(const assets::Aabb& local_bounds, const math::Mat4& world);
+  bool is_visible(const assets::Aabb& world_bounds);
+  // Same test for many candidates, split across the job pool; out_visible gets 1 per visible query.
+  void test(std::span<const OcclusionQuery> queries, std::vector<uint8_t>* out_visible);
+
+  const OcclusionStats& stats() const;
+
+  // Level 0 is the full resolution depth buffer.
+  uint32_t pyramid_levels() const;
+  const float* pyramid_level(uint32_t level, uint32_t* out_width, uint32_t* out_height) const;
+
+private:
+  struct Occluder {
+    const assets::MeshData* mesh = nullptr;
+    math::Mat4 world;
+    float screen_fraction = 0.0F;
+  };
+
+  // Screen-space triangle: x, y in pixels, z in NDC depth.
+  struct ScreenTriangle {
+    math::Vec3 v[3];
+    float min_y = 0.0F;
+    float max_y = 0.0F;
+  };
+
+  struct Level {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<float> depth;
+  };
+
+  enum class Visibility : uint8_t {
+    Visible,
+    FrustumCulled,
+    Occluded,
+  };
+
+  Visibility classify(const assets::Aabb& local_bounds, const math::Mat4& world) const;
+  template <typename Job>
+  void run_parallel(uint32_t job_count, const Job& job);
+
+  void transform_occluders();
+  void rasterize_rows(uint32_t row_begin, uint32_t row_end);
+  void build_pyramid();
+  void resize_levels();
+
+  core::ThreadPool* pool_ = nullptr;
+  OcclusionSettings settings_;
+  OcclusionStats stats_;
+  uint32_t occluder_limit_ = 0;
+
+  math::Mat4 view_projection_;
+  math::Frustum frustum_;
+  math::Vec3 camera_position_;
+  float tan_half_fov_ = 1.0F;
+
+  std::vector<Occluder> candidates_;
+  std::vector<ScreenTriangle> triangles_;
+  // Per-build scratch such as clip-space vertices, rewound by transform_occluders().
+  core::ArenaResource scratch_{256U * 1024U, core::tagged_resource(core::MemoryTag::Renderer)};
+  std::vector<math::Vec3> decoded_positions_;
+  std::vector<Level> levels_;
+  bool built_ = false;
+};
+
+} // namespace engine::renderer
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "engine/assets/mesh_data.h"
+#include "engine/math/mat4.h"
+#include "engine/math/vec3.h"
+#include "engine/runtime/camera.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace engine::renderer {
+
+// On-disk layout, in host byte order since structs are stored as they are in memory (captures
+// are meant to be replayed on the kind of machine that recorded them):
+//   RenderCaptureHeader | meshes | cameras (CapturedCamera) | per frame: u32 clear_color, u32 culled,
+//   u32 draw_count, draws (CapturedDraw)
+// A mesh is u32-counted arrays of vertex positions, indices, LODs (f32 error + indices), meshlets,
+// meshlet vertices and meshlet triangles, then its bounds. Normals and UVs are not drawn and not stored.
+inline constexpr uint32_t render_capture_magic = 0x50414352U; // "RCAP"
+inline constexpr uint32_t render_capture_version = 2U;
+inline constexpr uint32_t captured_no_mesh = 0xFFFFFFFFU; // submit_mesh(nullptr): the fallback triangle
+
+struct RenderCaptureHeader {
+  uint32_t magic = render_capture_magic;
+  uint32_t version = render_capture_version;
+  uint32_t mesh_count = 0;
+  uint32_t camera_count = 0;
+  uint32_t frame_count = 0;
+  uint32_t draw_count = 0;
+};
+
+static_assert(sizeof(RenderCaptureHeader) == 24);
+
+struct CapturedCamera {
+  math::Vec3 position;
+  math::Vec3 forward;
+  math::Mat4 view;
+  math::Mat4 projection;
+  int32_t viewport_width = 1;
+  int32_t viewport_height = 1;
+};
+
+struct CapturedDraw {
+  uint32_t mesh = captured_no_mesh;
+  uint32_t camera = 0;
+  uint32_t lod = 0;
+  math::Mat4 world;
+};
+
+struct CapturedFrame {
+  uint32_t clear_color = 0;
+  uint32_t culled = 0;
+  uint32_t first_draw = 0;
+  uint32_t draw_count = 0;
+};
+
+// Everything submitted to a BasicRenderer over a range of frames, with copies
+// of the meshes it referenced, so the stream can be replayed without the scene
+// or asset manager that produced it.
+class RenderCapture {
+public:
+  // Frames are numbered by BasicRenderer from 1; frame_count 0 captures until stopped.
+  void set_frame_range(uint64_t first_frame, uint64_t frame_count);
+  void clear();
+
+  // Called by BasicRenderer; calls outside the frame range are ignored.
+  void begin_frame(uint64_t frame_index, uint32_t clear_color);
+  void add_mesh(const std::shared_ptr<const assets::MeshData>& mesh,
+                const math::Mat4& world,
+                const runtime::Camera& camera,
+                uint32_t lod);
+  void add_culled(uint32_t count);
+
+  // True once the last frame of a bounded range has been captured.
+  bool complete() const;
+
+  size_t frame_count() const;
+  const CapturedFrame& frame(size_t index) const;
+  std::span<const CapturedDraw> draws(const CapturedFrame& frame) const;
+  size_t draw_count() const;
+  size_t mesh_count() const;
+  uint32_t camera_count() const;
+  // Null for captured_no_mesh.
+  const std::shared_ptr<const assets::MeshData>& mesh(uint32_t index) const;
+  const CapturedCamera& camera(uint32_t index) const;
+  runtime::Camera make_camera(uint32_t index) const;
+
+  bool save(const std::string& path, std::string* out_error = nullptr) const;
+  bool load(const std::string& path, std::string* out_error = nullptr);
+
+private:
+  uint64_t first_frame_ = 1;
+  uint64_t frame_limit_ = 0;
+  bool recording_ = false;
+  std::vector<CapturedFrame> frames_;
+  std::vector<CapturedDraw> draws_;
+  std::vector<CapturedCamera> cameras_;
+  std::vector<std::shared_ptr<const assets::MeshData>> meshes_;
+  // Keys hold a reference, so a mesh freed by a hot reload or eviction cannot hand its address to
+  // a different mesh while the capture still maps it.
+  std::unordered_map<std::shared_ptr<const assets::MeshData>, uint32_t> mesh_index_;
+};
+
+} // namespace engine::renderer
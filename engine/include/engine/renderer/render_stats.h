@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace engine::renderer {
+
+enum class RenderPass : uint8_t {
+  Clear,
+  Geometry,
+  Count, // not a pass; keep last
+};
+
+inline constexpr size_t render_pass_count = static_cast<size_t>(RenderPass::Count);
+
+const char* render_pass_name(RenderPass pass);
+
+// Counted the same way on every backend: one draw per submitted index range,
+// whatever the backend turns it into.
+struct RenderPassStats {
+  uint32_t draws = 0;
+  uint32_t instances = 0;
+  uint64_t triangles = 0;
+  uint64_t vertices = 0;
+  uint32_t culled = 0;          // objects culled before submission (add_culled) or rejected by the renderer
+  uint64_t bytes_uploaded = 0;  // vertex and index data copied to the backend this frame
+  uint32_t state_changes = 0;   // clear colour and geometry source switches
+  double cpu_ms = 0.0;
+
+  void accumulate(const RenderPassStats& other);
+};
+
+struct RenderStats {
+  uint64_t frame_index = 0;
+  std::array<RenderPassStats, render_pass_count> passes{};
+  double begin_ms = 0.0;  // begin_frame()
+  double submit_ms = 0.0; // all submit_* calls
+  double end_ms = 0.0;    // end_frame(), including present
+
+  const RenderPassStats& pass(RenderPass pass) const { return passes[static_cast<size_t>(pass)]; }
+  RenderPassStats& pass(RenderPass pass) { return passes[static_cast<size_t>(pass)]; }
+  RenderPassStats totals() const;
+  double cpu_ms() const { return begin_ms + submit_ms + end_ms; }
+};
+
+} // namespace engine::renderer
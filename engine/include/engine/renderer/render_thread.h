@@ -0,0 +1,80 @@
+#pragma once
+
+#include "engine/renderer/frame_packet.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::renderer {
+
+struct RenderThreadStats {
+  uint64_t frames_submitted = 0;
+  uint64_t frames_rendered = 0;
+  uint32_t frames_in_flight = 0;
+  double acquire_wait_ms = 0.0; // last acquire: simulation blocked on the render thread
+  double render_ms = 0.0;       // last packet rendered
+};
+
+// Runs rendering on its own thread. Simulation fills a FramePacket from a
+// small ring and submits it; at most frames_in_flight packets are queued or
+// rendering at once, so acquire() blocks instead of letting latency grow.
+class RenderThread {
+public:
+  using StartFn = std::function<bool()>;
+  using RenderFn = std::function<void(const FramePacket&)>;
+  using StopFn = std::function<void()>;
+
+  explicit RenderThread(uint32_t frames_in_flight = 2);
+  ~RenderThread();
+
+  RenderThread(const RenderThread&) = delete;
+  RenderThread& operator=(const RenderThread&) = delete;
+
+  // on_start runs on the new thread, since graphics contexts belong to the
+  // thread that creates them. Returns its result; the thread exits on false.
+  bool start(StartFn on_start, RenderFn render, StopFn on_stop);
+  // Renders everything already submitted, runs on_stop and joins.
+  void stop();
+  bool running() const;
+
+  // The returned packet has its draws cleared and stays valid until submit().
+  FramePacket& acquire();
+  void submit();
+
+  RenderThreadStats stats() const;
+
+private:
+  enum class SlotState : uint8_t {
+    Free,
+    Writing,
+    Queued,
+    Rendering,
+  };
+
+  void thread_main(const StartFn& on_start, std::promise<bool>* started);
+
+  uint32_t frames_in_flight_ = 2;
+  std::vector<FramePacket> packets_;
+  std::vector<SlotState> states_;
+  std::deque<uint32_t> queue_;
+  uint32_t writing_ = 0;
+  uint64_t next_frame_index_ = 0;
+
+  RenderFn render_;
+  StopFn on_stop_;
+  std::thread thread_;
+  mutable std::mutex mutex_;
+  std::condition_variable queued_;
+  std::condition_variable released_;
+  bool started_ = false;
+  bool stopping_ = false;
+  RenderThreadStats stats_;
+};
+
+} // namespace engine::renderer
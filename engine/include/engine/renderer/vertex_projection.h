@@ -0,0 +1,24 @@
+#pragma once
+
+#include "engine/math/mat4.h"
+#include "engine/math/vec3.h"
+
+#include <cstddef>
+
+namespace engine::renderer {
+
+struct ScreenVertex {
+  float x = 0.0F; // pixels, origin top left
+  float y = 0.0F;
+  float depth = 0.0F; // 0 (near) to 1 (far)
+};
+
+// CPU vertex transform of the software renderer: object space through mvp to window pixels.
+void project_vertices(const math::Vec3* vertices,
+                      size_t count,
+                      const math::Mat4& mvp,
+                      int width,
+                      int height,
+                      ScreenVertex* out_vertices);
+
+} // namespace engine::renderer
@@ -26,6 +26,8 @@ public:
 
   void update(float dt_seconds, const input::InputState& input);
   void set_viewport(int width, int height);
+  int viewport_width() const;
+  int viewport_height() const;
 
 private:
   void update_orientation(const input::InputState& input);
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "engine/assets/mesh_data.h"
+#include "engine/math/mat4.h"
+#include "engine/runtime/camera.h"
+#include "engine/runtime/entity.h"
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+namespace engine::runtime {
+
+struct LodSettings {
+  float max_screen_error_pixels = 1.0F;
+  // Global scale knob: each +1 doubles the tolerated error (coarser LODs), -1 halves it.
+  float bias = 0.0F;
+  // A coarser LOD is only taken once its error drops this fraction below the
+  // threshold; going finer happens as soon as the threshold is exceeded.
+  float hysteresis = 0.25F;
+};
+
+struct LodStats {
+  std::array<uint32_t, assets::max_mesh_lods> selected_per_lod{};
+  uint32_t selections = 0;
+  uint32_t transitions = 0;
+  uint64_t triangles_selected = 0;
+  uint64_t triangles_full_detail = 0;
+};
+
+// Picks, per entity and frame, the coarsest LOD whose geometric error projects
+// to fewer than max_screen_error_pixels on screen.
+class LodSelector {
+public:
+  void set_settings(const LodSettings& settings);
+  const LodSettings& settings() const;
+
+  // Caches the projection scale and resets the per-frame stats.
+  void begin_frame(const Camera& camera);
+  uint32_t select(Entity entity, const assets::MeshData& mesh, const math::Mat4& world);
+
+  const LodStats& stats() const;
+
+private:
+  struct History {
+    uint32_t lod = 0;
+    uint64_t last_frame = 0;
+  };
+
+  float projected_error(float world_error, float distance) const;
+
+  LodSettings settings_;
+  LodStats stats_;
+
+  math::Vec3 camera_position_;
+  float near_plane_ = 0.1F;
+  float pixels_per_unit_at_one_ = 1.0F; // viewport height / (2 tan(fov / 2))
+  float threshold_ = 1.0F;
+
+  uint64_t frame_ = 0;
+  std::unordered_map<uint32_t, History> history_;
+};
+
+} // namespace engine::runtime
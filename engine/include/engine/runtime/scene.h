@@ -1,32 +1,61 @@
 #pragma once
 
 #include "engine/assets/asset_manager.h"
+#include "engine/core/allocators.h"
+#include "engine/core/memory_tracker.h"
 #include "engine/math/mat4.h"
 #include "engine/runtime/camera.h"
 #include "engine/runtime/entity.h"
 #include "engine/runtime/transform.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <optional>
 #include <unordered_map>
 #include <vector>
 
 namespace engine::runtime {
 
+// Holds a reference on the mesh for as long as the component exists.
 struct MeshComponent {
-  assets::MeshHandle mesh;
+  assets::MeshRef mesh;
 };
 
 struct CameraComponent {
   bool primary = false;
 };
 
+// Static entities are expected not to move; their draws are cached (see StaticDrawCache).
+enum class Mobility : uint8_t {
+  Dynamic,
+  Static,
+};
+
 class Scene {
 public:
+  // Every container in the scene allocates from resource; per-entity map nodes come from pools
+  // carved out of it.
+  explicit Scene(std::pmr::memory_resource* resource = core::tagged_resource(core::MemoryTag::Scene));
+
+  Scene(const Scene&) = delete;
+  Scene& operator=(const Scene&) = delete;
+
   Entity create_entity(std::optional<uint32_t> parent_id = std::nullopt);
 
+  // For static entities (and parents of static entities) every call counts as an edit and
+  // bumps static_revision(); do not hold the reference across frames to move them.
   Transform& transform(Entity entity);
   const Transform* find_transform(Entity entity) const;
 
+  void set_mobility(Entity entity, Mobility mobility);
+  Mobility mobility(Entity entity) const;
+  const std::pmr::vector<Entity>& static_entities() const;
+  const std::pmr::vector<Entity>& dynamic_entities() const;
+  // Changes whenever anything a static entity's draw depends on may have changed.
+  uint64_t static_revision() const;
+
+  // The scene must be destroyed before the AssetManager its mesh components reference.
   void add_mesh_component(Entity entity, MeshComponent mesh);
   const MeshComponent* find_mesh_component(Entity entity) const;
 
@@ -35,22 +64,41 @@ public:
 
   std::vector<Entity> entities() const;
 
-  bool compute_world_matrix(Entity entity, math::Mat4* out_world) const;
+  // alpha < 1 blends every transform in the chain from its previous step (see begin_simulation_step).
+  bool compute_world_matrix(Entity entity, math::Mat4* out_world, float alpha = 1.0F) const;
+
+  // Saves the current transform of every dynamic entity as its previous state.
+  void begin_simulation_step();
 
   uint32_t entity_count() const;
   uint32_t mesh_component_count() const;
+  // Both node pools combined.
+  core::AllocatorStats node_pool_stats() const;
 
 private:
   struct Node {
     Entity entity;
     std::optional<uint32_t> parent_id;
+    Mobility mobility = Mobility::Dynamic;
+    bool has_static_descendant = false;
   };
 
+  Node* find_node(uint32_t id);
+  const Node* find_node(uint32_t id) const;
+
+  // Declared before the containers that allocate from them.
+  core::PoolResource transform_nodes_;
+  core::PoolResource small_nodes_; // node index, mesh and camera components
+
   uint32_t next_entity_id_ = 1;
-  std::vector<Node> nodes_;
-  std::unordered_map<uint32_t, Transform> transforms_;
-  std::unordered_map<uint32_t, MeshComponent> mesh_components_;
-  std::unordered_map<uint32_t, CameraComponent> camera_components_;
+  std::pmr::vector<Node> nodes_;
+  std::pmr::unordered_map<uint32_t, size_t> node_index_;
+  std::pmr::vector<Entity> static_entities_;
+  std::pmr::vector<Entity> dynamic_entities_;
+  uint64_t static_revision_ = 0;
+  std::pmr::unordered_map<uint32_t, Transform> transforms_;
+  std::pmr::unordered_map<uint32_t, MeshComponent> mesh_components_;
+  std::pmr::unordered_map<uint32_t, CameraComponent> camera_components_;
 };
 
 } // namespace engine::runtime
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "engine/assets/asset_manager.h"
+#include "engine/assets/mesh_data.h"
+#include "engine/math/mat4.h"
+#include "engine/runtime/entity.h"
+#include "engine/runtime/scene.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace engine::runtime {
+
+struct DrawPacket {
+  Entity entity;
+  assets::MeshHandle mesh;
+  const assets::MeshData* mesh_data = nullptr; // null while the mesh is still streaming
+  math::Mat4 world;
+  assets::Aabb world_bounds;
+  uint64_t sort_key = 0; // mesh slot, then entity id: draws of one mesh are adjacent
+};
+
+// Draw packets for the scene's static entities, rebuilt only when the scene's
+// static revision or the asset manager's mesh data revision moves.
+class StaticDrawCache {
+public:
+  // Returns true when the packets were rebuilt.
+  bool update(const Scene& scene, const assets::AssetManager& assets);
+  void invalidate();
+
+  const std::vector<DrawPacket>& packets() const;
+  uint64_t rebuild_count() const;
+
+private:
+  std::vector<DrawPacket> packets_;
+  uint64_t scene_revision_ = 0;
+  uint64_t asset_revision_ = 0;
+  uint64_t rebuild_count_ = 0;
+  bool valid_ = false;
+};
+
+} // namespace engine::runtime
@@ -15,8 +15,16 @@ public:
   void mark_dirty();
   void update_matrix();
 
+  // Snapshot taken before a simulation step; rendering blends towards the current state.
+  void save_previous();
+  math::Mat4 interpolated_matrix(float alpha) const;
+
 private:
   bool dirty_ = true;
+  bool has_previous_ = false;
+  math::Vec3 previous_position_;
+  math::Vec3 previous_rotation_;
+  math::Vec3 previous_scale_;
 };
 
 } // namespace engine::runtime
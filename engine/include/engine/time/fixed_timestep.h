@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+namespace engine::time {
+
+struct FixedStepSettings {
+  double tick_rate_hz = 60.0;
+  // Spiral-of-death guard: time beyond this many steps in one frame is dropped, not carried over.
+  uint32_t max_steps_per_frame = 5U;
+};
+
+struct FixedStepStats {
+  uint64_t total_steps = 0;
+  uint32_t steps_this_frame = 0;
+  uint64_t dropped_steps = 0;
+  double alpha = 0.0;
+};
+
+// Accumulates frame time and hands it out in whole simulation steps. alpha()
+// is how far the renderer is between the previous and the current step.
+class FixedTimestep {
+public:
+  explicit FixedTimestep(const FixedStepSettings& settings = {});
+
+  void set_settings(const FixedStepSettings& settings);
+  const FixedStepSettings& settings() const;
+
+  // Returns the number of steps of step_seconds() to simulate this frame.
+  uint32_t advance(double frame_seconds);
+
+  double step_seconds() const;
+  double alpha() const;
+  const FixedStepStats& stats() const;
+
+private:
+  FixedStepSettings settings_;
+  FixedStepStats stats_;
+  double step_seconds_ = 1.0 / 60.0;
+  double accumulator_ = 0.0;
+};
+
+} // namespace engine::time
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace engine::time {
+
+struct FramePacerSettings {
+  double target_fps = 0.0;     // 0 = uncapped while focused
+  double unfocused_fps = 30.0; // 0 = same as focused
+  double minimized_fps = 5.0;  // also used for headless runs
+  // Sleep until this close to the deadline, then spin. Grows automatically when
+  // the OS oversleeps by more than this.
+  double spin_threshold_ms = 1.0;
+  // Longest stretch slept without calling the pump callback passed to wait().
+  double pump_interval_ms = 1.0;
+};
+
+struct FramePacerStats {
+  uint64_t paced_frames = 0;
+  double target_fps = 0.0;         // currently active cap, 0 = uncapped
+  double last_wake_error_ms = 0.0; // positive = woke late
+  double avg_wake_error_ms = 0.0;  // exponential moving average of |error|
+  double max_wake_error_ms = 0.0;
+  double sleep_overshoot_ms = 0.0; // moving average of how late sleep_for returns
+  double last_idle_ms = 0.0;       // time spent waiting in the last wait()
+};
+
+// Caps the frame rate with a hybrid sleep + spin wait against absolute
+// deadlines, and drops to lower rates when the window is unfocused or
+// minimized so idle instances burn little CPU.
+class FramePacer {
+public:
+  explicit FramePacer(const FramePacerSettings& settings = {});
+
+  void set_settings(const FramePacerSettings& settings);
+  const FramePacerSettings& settings() const;
+
+  void set_window_state(bool focused, bool minimized);
+
+  // Call once per frame after presenting; returns immediately when uncapped. When pump is
+  // set the sleep is cut into pump_interval_ms slices and pump runs between them, so the
+  // caller can drain OS input while idle (e.g. SDL_PumpEvents) and stamp it on arrival.
+  void wait(const std::function<void()>& pump = {});
+  // Like wait(), but for a caller-chosen frame interval instead of the cap, e.g. to
+  // replay recorded frame times in real time. Window throttling does not apply.
+  void wait_interval(double interval_seconds, const std::function<void()>& pump = {});
+
+  const FramePacerStats& stats() const;
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  double active_target_fps() const;
+  void wait_period(double period_seconds, const std::function<void()>& pump);
+
+  FramePacerSettings settings_;
+  FramePacerStats stats_;
+  bool focused_ = true;
+  bool minimized_ = false;
+  bool has_deadline_ = false;
+  clock::time_point deadline_;
+};
+
+} // namespace engine::time
@@ -2,72 +2,523 @@
 
 #include "engine/assets/gltf_loader.h"
 #include "engine/core/logger.h"
+#include "engine/core/memory_tracker.h"
+#include "engine/io/async_file_io.h"
+#include "engine/io/vfs.h"
+
+#include <algorithm>
+#include <utility>
 
 namespace engine::assets {
 
+double AssetStats::hit_rate() const {
+  const uint64_t total = cache_hits + cache_misses;
+  return total > 0 ? static_cast<double>(cache_hits) / static_cast<double>(total) : 0.0;
+}
+
 AssetManager::AssetManager(core::Logger* logger)
     : logger_(logger) {}
 
-MeshHandle AssetManager::load_mesh(const std::string& path) {
+void AssetManager::set_vfs(const io::Vfs* vfs) {
+  vfs_ = vfs;
+}
+
+void AssetManager::set_async_io(io::AsyncFileIo* async_io) {
+  async_io_ = async_io;
+}
+
+void AssetManager::set_lod_generation(const LodChainOptions& options, core::ThreadPool* pool) {
+  generate_lods_ = true;
+  lod_options_ = options;
+  lod_pool_ = pool;
+}
+
+void AssetManager::set_meshlet_generation(const bool enabled, const MeshletOptions& options) {
+  generate_meshlets_ = enabled;
+  meshlet_options_ = options;
+}
+
+void AssetManager::set_vertex_compression(const bool enabled, const VertexLayout& layout) {
+  compress_vertices_ = enabled;
+  vertex_layout_ = layout;
+}
+
+void AssetManager::process_import(GltfLoadResult* result) const {
+  if (!result->ok) {
+    return;
+  }
+  if (generate_lods_) {
+    generate_missing_lod_chains(result->meshes, lod_options_, lod_pool_);
+  }
+  if (generate_meshlets_) {
+    for (MeshData& mesh : result->meshes) {
+      if (mesh.meshlets.empty()) {
+        build_meshlets(&mesh, meshlet_options_);
+      }
+    }
+  }
+}
+
+MeshHandle AssetManager::load_mesh(const core::StringId path) {
   if (const auto it = path_cache_.find(path); it != path_cache_.end()) {
-    log_info("Asset cache hit for mesh: " + path);
+    stats_.cache_hits += 1;
+    retain_mesh(it->second);
     return it->second;
   }
 
-  const GltfLoadResult load_result = GltfLoader::load(path);
+  stats_.cache_misses += 1;
+
+  const std::string path_text = path_string(path);
+  if (path_text.empty()) {
+    log_error("Cannot load mesh from a path id that was never interned: " + std::to_string(path.value()));
+    return {};
+  }
+
+  GltfLoadResult load_result = import_file(path_text);
   if (!load_result.ok || load_result.meshes.empty()) {
-    log_error("Failed to load mesh '" + path + "': " + load_result.error);
+    log_error("Failed to load mesh '" + path_text + "': " + load_result.error);
     return {};
   }
 
-  const MeshHandle handle{next_handle_++};
-  meshes_[handle.value] = load_result.meshes[0];
+  MeshRecord record{};
+  record.data = acquire_mesh_data(std::move(load_result.meshes[0]), path_text);
+  record.path = path;
+  record.bytes = assets::mesh_memory_bytes(*record.data);
+  record.ref_count = 1;
+
+  const MeshHandle handle = meshes_.insert(std::move(record));
   path_cache_[path] = handle;
+  sync_loaded_path(path);
 
-  log_info("Loaded mesh from path: " + path);
+  log_info("Loaded mesh from path: " + path_text);
+  enforce_budget();
+  return handle;
+}
+
+MeshHandle AssetManager::create_mesh(const std::string_view path, MeshData mesh) {
+  const core::StringId path_id = core::intern(path);
+  if (path_cache_.contains(path_id)) {
+    log_error("Cannot create mesh, path already loaded: " + std::string(path));
+    return {};
+  }
+
+  GltfLoadResult import_result;
+  import_result.ok = true;
+  import_result.meshes.push_back(std::move(mesh));
+  process_import(&import_result);
+
+  MeshRecord record{};
+  record.data = acquire_mesh_data(std::move(import_result.meshes[0]), std::string(path));
+  record.path = path_id;
+  record.bytes = assets::mesh_memory_bytes(*record.data);
+  record.ref_count = 1;
+
+  const MeshHandle handle = meshes_.insert(std::move(record));
+  path_cache_[path_id] = handle;
+  sync_loaded_path(path_id);
+  enforce_budget();
   return handle;
 }
 
 const MeshData* AssetManager::get_mesh(const MeshHandle handle) const {
-  if (!handle.valid()) {
-    return nullptr;
+  const MeshRecord* record = meshes_.get(handle);
+  return record != nullptr ? record->data.get() : nullptr;
+}
+
+std::shared_ptr<const MeshData> AssetManager::share_mesh(const MeshHandle handle) const {
+  const MeshRecord* record = meshes_.get(handle);
+  return record != nullptr ? record->data : nullptr;
+}
+
+bool AssetManager::retain_mesh(const MeshHandle handle) {
+  MeshRecord* record = meshes_.get(handle);
+  if (record == nullptr) {
+    return false;
+  }
+
+  if (record->in_lru) {
+    lru_.erase(record->lru_position);
+    record->in_lru = false;
+  }
+  record->ref_count += 1;
+  return true;
+}
+
+bool AssetManager::release_mesh(const MeshHandle handle) {
+  MeshRecord* record = meshes_.get(handle);
+  if (record == nullptr) {
+    return false;
   }
 
-  const auto it = meshes_.find(handle.value);
-  if (it == meshes_.end()) {
-    return nullptr;
+  if (record->ref_count == 0) {
+    log_warn("Mesh released more times than it was acquired: " + path_string(record->path));
+    return false;
   }
 
-  return &it->second;
+  record->ref_count -= 1;
+  if (record->ref_count == 0) {
+    record->lru_position = lru_.insert(lru_.end(), handle);
+    record->in_lru = true;
+    enforce_budget();
+  }
+  return true;
 }
 
 bool AssetManager::unload_mesh(const MeshHandle handle) {
-  if (!handle.valid()) {
+  const MeshRecord* record = meshes_.get(handle);
+  if (record == nullptr) {
     return false;
   }
 
-  const auto it = meshes_.find(handle.value);
-  if (it == meshes_.end()) {
+  if (record->ref_count > 0) {
+    log_warn("Not unloading mesh still referenced " + std::to_string(record->ref_count) +
+             " time(s): " + path_string(record->path));
     return false;
   }
+  erase_record(handle);
+  return true;
+}
 
-  meshes_.erase(it);
+MeshHandle AssetManager::request_mesh(const core::StringId path) {
+  if (path_cache_.contains(path)) {
+    return load_mesh(path);
+  }
 
-  for (auto path_it = path_cache_.begin(); path_it != path_cache_.end();) {
-    if (path_it->second.value == handle.value) {
-      path_it = path_cache_.erase(path_it);
-    } else {
-      ++path_it;
-    }
+  std::string native_path = path_string(path);
+  if (vfs_ != nullptr) {
+    native_path = vfs_->native_path(native_path);
+  }
+  if (async_io_ == nullptr || native_path.empty()) {
+    return load_mesh(path);
   }
 
-  return true;
+  stats_.cache_misses += 1;
+
+  MeshRecord record{};
+  record.path = path;
+  record.ref_count = 1;
+  const MeshHandle handle = meshes_.insert(std::move(record));
+  path_cache_[path] = handle;
+  sync_loaded_path(path);
+  pending_mesh_loads_ += 1;
+
+  stream_mesh(handle, std::move(native_path));
+  return handle;
+}
+
+bool AssetManager::is_mesh_ready(const MeshHandle handle) const {
+  return get_mesh(handle) != nullptr;
+}
+
+uint32_t AssetManager::pending_mesh_loads() const {
+  return pending_mesh_loads_;
+}
+
+uint64_t AssetManager::mesh_data_revision() const {
+  return mesh_data_revision_;
+}
+
+uint32_t AssetManager::mesh_ref_count(const MeshHandle handle) const {
+  const MeshRecord* record = meshes_.get(handle);
+  return record != nullptr ? record->ref_count : 0U;
+}
+
+size_t AssetManager::mesh_memory_bytes(const MeshHandle handle) const {
+  const MeshRecord* record = meshes_.get(handle);
+  return record != nullptr ? record->bytes : 0U;
+}
+
+void AssetManager::set_memory_budget(const size_t budget_bytes) {
+  stats_.budget_bytes = budget_bytes;
+  over_budget_warned_ = false;
+  enforce_budget();
+}
+
+AssetStats AssetManager::stats() const {
+  AssetStats out = stats_;
+  out.resident_meshes = static_cast<uint32_t>(meshes_.size());
+  out.unreferenced_meshes = static_cast<uint32_t>(lru_.size());
+
+  const MeshStoreStats store_stats = store_.stats();
+  const GeometryPoolStats pool_stats = geometry_pool_.stats();
+  out.dedup_hits = store_stats.dedup_hits + pool_stats.dedup_hits;
+  out.deduplicated_bytes = store_stats.bytes_saved + pool_stats.bytes_saved;
+  out.geometry_pool_bytes = geometry_pool_.memory_bytes();
+  return out;
 }
 
 uint32_t AssetManager::mesh_count() const {
   return static_cast<uint32_t>(meshes_.size());
 }
 
+ModelHandle AssetManager::load_model(const core::StringId path) {
+  if (const auto it = model_path_cache_.find(path); it != model_path_cache_.end()) {
+    stats_.cache_hits += 1;
+    models_.get(it->second)->ref_count += 1;
+    return it->second;
+  }
+
+  stats_.cache_misses += 1;
+
+  const std::string path_text = path_string(path);
+  if (path_text.empty()) {
+    log_error("Cannot load model from a path id that was never interned: " + std::to_string(path.value()));
+    return {};
+  }
+
+  const GltfLoadResult load_result = import_file(path_text);
+  if (!load_result.ok || load_result.meshes.empty()) {
+    log_error("Failed to load model '" + path_text + "': " + load_result.error);
+    return {};
+  }
+
+  ModelRecord record{};
+  record.path = path;
+  record.ref_count = 1;
+
+  allocate_model_geometry(load_result.meshes, &record);
+
+  const ModelHandle handle = models_.insert(std::move(record));
+  model_path_cache_[path] = handle;
+  sync_loaded_path(path);
+
+  log_info("Loaded model from path: " + path_text + " (" + std::to_string(load_result.meshes.size()) + " submeshes)");
+  enforce_budget();
+  return handle;
+}
+
+const ModelData* AssetManager::get_model(const ModelHandle handle) const {
+  const ModelRecord* record = models_.get(handle);
+  return record != nullptr ? &record->data : nullptr;
+}
+
+bool AssetManager::release_model(const ModelHandle handle) {
+  ModelRecord* record = models_.get(handle);
+  if (record == nullptr || record->ref_count == 0) {
+    return false;
+  }
+
+  record->ref_count -= 1;
+  if (record->ref_count > 0) {
+    return true;
+  }
+
+  free_model_geometry(record);
+  const core::StringId path = record->path;
+  model_path_cache_.erase(path);
+  models_.erase(handle);
+  sync_loaded_path(path);
+  return true;
+}
+
+uint32_t AssetManager::model_count() const {
+  return static_cast<uint32_t>(models_.size());
+}
+
+const GeometryPool& AssetManager::geometry_pool() const {
+  return geometry_pool_;
+}
+
+void AssetManager::defragment_geometry() {
+  geometry_pool_.defragment();
+}
+
+bool AssetManager::apply_reload(const std::string_view path, GltfLoadResult result) {
+  const core::StringId path_id(path);
+  const auto mesh_it = path_cache_.find(path_id);
+  const auto model_it = model_path_cache_.find(path_id);
+  if (mesh_it == path_cache_.end() && model_it == model_path_cache_.end()) {
+    return false;
+  }
+
+  if (!result.ok || result.meshes.empty()) {
+    log_warn("Hot reload of '" + std::string(path) + "' failed, keeping previous data: " + result.error);
+    return false;
+  }
+
+  if (model_it != model_path_cache_.end()) {
+    ModelRecord* record = models_.get(model_it->second);
+    free_model_geometry(record);
+    allocate_model_geometry(result.meshes, record);
+  }
+
+  if (mesh_it != path_cache_.end()) {
+    MeshRecord* record = meshes_.get(mesh_it->second);
+
+    std::shared_ptr<const MeshData> replacement = acquire_mesh_data(std::move(result.meshes[0]), std::string(path));
+    remove_resident_bytes(store_.release(record->data));
+
+    record->data = std::move(replacement);
+    record->bytes = assets::mesh_memory_bytes(*record->data);
+    mesh_data_revision_ += 1;
+  }
+
+  log_info("Hot reloaded asset: " + std::string(path));
+  enforce_budget();
+  return true;
+}
+
+bool AssetManager::is_loaded_path(const std::string_view path) const {
+  const std::lock_guard<std::mutex> lock(loaded_paths_mutex_);
+  return loaded_paths_.contains(core::StringId(path));
+}
+
+GltfLoadResult AssetManager::import_file(const std::string& path) const {
+  GltfLoadResult result = vfs_ != nullptr ? GltfLoader::load(path, *vfs_) : GltfLoader::load(path);
+  process_import(&result);
+  return result;
+}
+
+std::shared_ptr<const MeshData> AssetManager::acquire_mesh_data(MeshData mesh, const std::string& path) {
+  if (compress_vertices_) {
+    compress_vertex_streams(&mesh, vertex_layout_);
+  }
+
+  bool deduplicated = false;
+  std::shared_ptr<const MeshData> data = store_.acquire(std::move(mesh), &deduplicated);
+  if (deduplicated) {
+    log_info("Mesh content already resident, sharing buffers: " + path);
+  } else {
+    add_resident_bytes(assets::mesh_memory_bytes(*data));
+  }
+  stats_.peak_resident_bytes = std::max(stats_.peak_resident_bytes, stats_.resident_bytes);
+  return data;
+}
+
+core::DetachedTask AssetManager::stream_mesh(const MeshHandle handle, std::string native_path) {
+  // Named rather than a temporary: GCC 12 destroys temporaries of a co_await full-expression twice.
+  io::ReadAwaitable read = async_io_->read_async(io::ReadRequest{std::move(native_path)});
+  io::ReadCompletion completion = co_await read;
+  complete_streamed_mesh(handle, completion);
+}
+
+void AssetManager::complete_streamed_mesh(const MeshHandle handle, io::ReadCompletion& completion) {
+  pending_mesh_loads_ -= 1;
+
+  // The mesh may have been unloaded, evicted or hot reloaded while the read was in flight.
+  MeshRecord* record = meshes_.get(handle);
+  if (record == nullptr || record->data != nullptr) {
+    return;
+  }
+
+  if (!completion.ok) {
+    log_error("Failed to stream mesh '" + path_string(record->path) + "': " + completion.error);
+    erase_record(handle);
+    return;
+  }
+
+  const std::string path_text = path_string(record->path);
+  GltfLoadResult load_result = GltfLoader::load_from_memory(path_text, completion.bytes);
+  process_import(&load_result);
+  if (!load_result.ok || load_result.meshes.empty()) {
+    log_error("Failed to load mesh '" + path_text + "': " + load_result.error);
+    erase_record(handle);
+    return;
+  }
+
+  record->data = acquire_mesh_data(std::move(load_result.meshes[0]), path_text);
+  record->bytes = assets::mesh_memory_bytes(*record->data);
+  mesh_data_revision_ += 1;
+
+  log_info("Streamed mesh from path: " + path_text);
+  enforce_budget();
+}
+
+void AssetManager::allocate_model_geometry(const std::vector<MeshData>& meshes, ModelRecord* record) {
+  ModelData& model = record->data;
+  model = {};
+  for (const MeshData& mesh : meshes) {
+    bool shared = false;
+    const GeometryAllocation geometry = geometry_pool_.allocate(mesh, &shared);
+    if (!geometry.valid()) {
+      continue;
+    }
+
+    // Shared ranges are already counted, like deduplicated meshes.
+    if (!shared) {
+      add_resident_bytes(geometry_range_bytes(*geometry_pool_.range(geometry)));
+    }
+    model.bounds = model.submeshes.empty() ? mesh.bounds : merge_aabb(model.bounds, mesh.bounds);
+    model.submeshes.push_back(Submesh{geometry, mesh.bounds});
+  }
+  stats_.peak_resident_bytes = std::max(stats_.peak_resident_bytes, stats_.resident_bytes);
+}
+
+void AssetManager::free_model_geometry(ModelRecord* record) {
+  for (const Submesh& submesh : record->data.submeshes) {
+    remove_resident_bytes(geometry_pool_.free(submesh.geometry));
+  }
+  record->data.submeshes.clear();
+}
+
+void AssetManager::enforce_budget() {
+  if (stats_.budget_bytes == 0) {
+    return;
+  }
+
+  while (stats_.resident_bytes > stats_.budget_bytes && !lru_.empty()) {
+    const MeshHandle victim = lru_.front();
+    log_info("Evicting unreferenced mesh: " + path_string(meshes_.get(victim)->path));
+    erase_record(victim);
+    stats_.evictions += 1;
+  }
+
+  if (stats_.resident_bytes > stats_.budget_bytes) {
+    if (!over_budget_warned_) {
+      log_warn("Asset memory budget exceeded by referenced meshes and models: " +
+               std::to_string(stats_.resident_bytes) + " / " + std::to_string(stats_.budget_bytes) + " bytes");
+      over_budget_warned_ = true;
+    }
+  } else {
+    over_budget_warned_ = false;
+  }
+}
+
+void AssetManager::erase_record(const MeshHandle handle) {
+  const MeshRecord* record = meshes_.get(handle);
+  if (record == nullptr) {
+    return;
+  }
+
+  if (record->in_lru) {
+    lru_.erase(record->lru_position);
+  }
+  const core::StringId path = record->path;
+  path_cache_.erase(path);
+  remove_resident_bytes(store_.release(record->data));
+  meshes_.erase(handle);
+  sync_loaded_path(path);
+  mesh_data_revision_ += 1;
+}
+
+void AssetManager::sync_loaded_path(const core::StringId path) {
+  const bool loaded = path_cache_.contains(path) || model_path_cache_.contains(path);
+  const std::lock_guard<std::mutex> lock(loaded_paths_mutex_);
+  if (loaded) {
+    loaded_paths_.insert(path);
+  } else {
+    loaded_paths_.erase(path);
+  }
+}
+
+void AssetManager::add_resident_bytes(const size_t bytes) {
+  stats_.resident_bytes += bytes;
+  core::memory_tracker().record_allocation(core::MemoryTag::Assets, bytes);
+}
+
+void AssetManager::remove_resident_bytes(const size_t bytes) {
+  // Zero while the data is still shared with another record.
+  if (bytes == 0U) {
+    return;
+  }
+  stats_.resident_bytes -= bytes;
+  core::memory_tracker().record_deallocation(core::MemoryTag::Assets, bytes);
+}
+
+std::string AssetManager::path_string(const core::StringId path) {
+  return std::string(core::string_id_text(path));
+}
+
 void AssetManager::log_info(const std::string& message) const {
   if (logger_ != nullptr) {
     logger_->info(message);
@@ -86,4 +537,51 @@ void AssetManager::log_error(const std::string& message) const {
   }
 }
 
+MeshRef::MeshRef(AssetManager& assets, const MeshHandle handle) {
+  if (assets.retain_mesh(handle)) {
+    assets_ = &assets;
+    handle_ = handle;
+  }
+}
+
+MeshRef::~MeshRef() {
+  reset();
+}
+
+MeshRef::MeshRef(const MeshRef& other) {
+  if (other.assets_ != nullptr && other.assets_->retain_mesh(other.handle_)) {
+    assets_ = other.assets_;
+    handle_ = other.handle_;
+  }
+}
+
+MeshRef& MeshRef::operator=(const MeshRef& other) {
+  if (this != &other) {
+    MeshRef copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+MeshRef::MeshRef(MeshRef&& other) noexcept
+    : assets_(std::exchange(other.assets_, nullptr)),
+      handle_(std::exchange(other.handle_, {})) {}
+
+MeshRef& MeshRef::operator=(MeshRef&& other) noexcept {
+  if (this != &other) {
+    reset();
+    assets_ = std::exchange(other.assets_, nullptr);
+    handle_ = std::exchange(other.handle_, {});
+  }
+  return *this;
+}
+
+void MeshRef::reset() {
+  if (assets_ != nullptr) {
+    assets_->release_mesh(handle_);
+  }
+  assets_ = nullptr;
+  handle_ = {};
+}
+
 } // namespace engine::assets
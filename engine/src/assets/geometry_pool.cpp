@@ -0,0 +1,331 @@
+#include "engine/assets/geometry_pool.h"
+
+#include "engine/core/hash.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace engine::assets {
+
+namespace {
+
+template <typename T>
+void move_down(std::vector<T>* stream, const uint32_t from, const uint32_t to, const uint32_t count) {
+  if (from == to || count == 0U) {
+    return;
+  }
+  std::copy(stream->begin() + from, stream->begin() + from + count, stream->begin() + to);
+}
+
+// Attribute streams that do not match the vertex count are stored as zeros.
+template <typename T>
+uint64_t hash_stream(const std::vector<T>& stream, const size_t vertex_count, const uint64_t hash) {
+  if (stream.size() != vertex_count || stream.empty()) {
+    return hash;
+  }
+  return core::fnv1a_64(stream.data(), stream.size() * sizeof(T), hash);
+}
+
+uint64_t hash_geometry(const MeshData& mesh) {
+  const uint64_t counts[2] = {mesh.vertices.size(), mesh.indices.size()};
+  uint64_t hash = core::fnv1a_64(counts, sizeof(counts));
+  hash = hash_stream(mesh.vertices, mesh.vertices.size(), hash);
+  hash = hash_stream(mesh.normals, mesh.vertices.size(), hash);
+  hash = hash_stream(mesh.uvs, mesh.vertices.size(), hash);
+  return hash_stream(mesh.indices, mesh.indices.size(), hash);
+}
+
+template <typename T>
+bool stream_matches(const std::vector<T>& pool,
+                    const uint32_t offset,
+                    const uint32_t count,
+                    const std::vector<T>& source) {
+  if (source.size() == count) {
+    return count == 0U || std::memcmp(pool.data() + offset, source.data(), count * sizeof(T)) == 0;
+  }
+  const T zero{};
+  return std::all_of(pool.begin() + offset, pool.begin() + offset + count, [&zero](const T& value) {
+    return std::memcmp(&value, &zero, sizeof(T)) == 0;
+  });
+}
+
+} // namespace
+
+size_t geometry_range_bytes(const GeometryRange& range) {
+  return (static_cast<size_t>(range.vertex_count) * (sizeof(Vertex) + sizeof(math::Vec3) + sizeof(math::Vec2))) +
+         (static_cast<size_t>(range.index_count) * sizeof(uint32_t));
+}
+
+GeometryPool::GeometryPool(const uint32_t initial_vertex_capacity, const uint32_t initial_index_capacity)
+    : initial_vertex_capacity_(std::max(1U, initial_vertex_capacity)),
+      initial_index_capacity_(std::max(1U, initial_index_capacity)) {}
+
+GeometryAllocation GeometryPool::allocate(const MeshData& mesh, bool* out_shared) {
+  const uint32_t vertex_count = static_cast<uint32_t>(mesh.vertices.size());
+  const uint32_t index_count = static_cast<uint32_t>(mesh.indices.size());
+  if (out_shared != nullptr) {
+    *out_shared = false;
+  }
+  if (vertex_count == 0U) {
+    return {};
+  }
+
+  const uint64_t hash = hash_geometry(mesh);
+  std::vector<GeometryAllocation>& bucket = ranges_by_hash_[hash];
+  for (const GeometryAllocation existing : bucket) {
+    Entry* entry = ranges_.get(existing);
+    if (range_matches(entry->range, mesh)) {
+      entry->ref_count += 1;
+      dedup_hits_ += 1;
+      bytes_saved_ += geometry_range_bytes(entry->range);
+      if (out_shared != nullptr) {
+        *out_shared = true;
+      }
+      return existing;
+    }
+  }
+
+  GeometryRange range{};
+  range.vertex_count = vertex_count;
+  range.index_count = index_count;
+  range.vertex_offset = allocate_vertices(vertex_count);
+  range.index_offset = index_count > 0U ? allocate_indices(index_count) : 0U;
+
+  std::copy(mesh.vertices.begin(), mesh.vertices.end(), vertices_.begin() + range.vertex_offset);
+  if (mesh.normals.size() == mesh.vertices.size()) {
+    std::copy(mesh.normals.begin(), mesh.normals.end(), normals_.begin() + range.vertex_offset);
+  } else {
+    std::fill_n(normals_.begin() + range.vertex_offset, vertex_count, math::Vec3{});
+  }
+  if (mesh.uvs.size() == mesh.vertices.size()) {
+    std::copy(mesh.uvs.begin(), mesh.uvs.end(), uvs_.begin() + range.vertex_offset);
+  } else {
+    std::fill_n(uvs_.begin() + range.vertex_offset, vertex_count, math::Vec2{});
+  }
+  std::copy(mesh.indices.begin(), mesh.indices.end(), indices_.begin() + range.index_offset);
+
+  const GeometryAllocation allocation = ranges_.insert(Entry{range, hash, 1U});
+  bucket.push_back(allocation);
+  return allocation;
+}
+
+size_t GeometryPool::free(const GeometryAllocation allocation) {
+  Entry* entry = ranges_.get(allocation);
+  if (entry == nullptr) {
+    return 0;
+  }
+
+  const GeometryRange range = entry->range;
+  const size_t bytes = geometry_range_bytes(range);
+  entry->ref_count -= 1;
+  if (entry->ref_count > 0U) {
+    bytes_saved_ -= bytes;
+    return 0;
+  }
+
+  const auto bucket_it = ranges_by_hash_.find(entry->hash);
+  std::vector<GeometryAllocation>& bucket = bucket_it->second;
+  bucket.erase(std::find_if(bucket.begin(), bucket.end(), [allocation](const GeometryAllocation other) {
+    return other.index == allocation.index && other.generation == allocation.generation;
+  }));
+  if (bucket.empty()) {
+    ranges_by_hash_.erase(bucket_it);
+  }
+
+  release_block(&free_vertices_, range.vertex_offset, range.vertex_count);
+  if (range.index_count > 0U) {
+    release_block(&free_indices_, range.index_offset, range.index_count);
+  }
+  ranges_.erase(allocation);
+  return bytes;
+}
+
+const GeometryRange* GeometryPool::range(const GeometryAllocation allocation) const {
+  const Entry* entry = ranges_.get(allocation);
+  return entry != nullptr ? &entry->range : nullptr;
+}
+
+void GeometryPool::defragment() {
+  std::vector<Entry>& live = ranges_.values();
+
+  std::vector<size_t> order(live.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+
+  // Ranges only ever move towards the front, so copying in offset order never overwrites live data.
+  std::sort(order.begin(), order.end(), [&live](const size_t a, const size_t b) {
+    return live[a].range.vertex_offset < live[b].range.vertex_offset;
+  });
+  uint32_t vertex_cursor = 0;
+  for (const size_t i : order) {
+    GeometryRange& range = live[i].range;
+    move_down(&vertices_, range.vertex_offset, vertex_cursor, range.vertex_count);
+    move_down(&normals_, range.vertex_offset, vertex_cursor, range.vertex_count);
+    move_down(&uvs_, range.vertex_offset, vertex_cursor, range.vertex_count);
+    range.vertex_offset = vertex_cursor;
+    vertex_cursor += range.vertex_count;
+  }
+
+  std::sort(order.begin(), order.end(), [&live](const size_t a, const size_t b) {
+    return live[a].range.index_offset < live[b].range.index_offset;
+  });
+  uint32_t index_cursor = 0;
+  for (const size_t i : order) {
+    GeometryRange& range = live[i].range;
+    if (range.index_count == 0U) {
+      continue;
+    }
+    move_down(&indices_, range.index_offset, index_cursor, range.index_count);
+    range.index_offset = index_cursor;
+    index_cursor += range.index_count;
+  }
+
+  free_vertices_.clear();
+  if (vertex_cursor < vertices_.size()) {
+    free_vertices_.push_back({vertex_cursor, static_cast<uint32_t>(vertices_.size()) - vertex_cursor});
+  }
+  free_indices_.clear();
+  if (index_cursor < indices_.size()) {
+    free_indices_.push_back({index_cursor, static_cast<uint32_t>(indices_.size()) - index_cursor});
+  }
+
+  revision_ += 1;
+  defragmentations_ += 1;
+}
+
+const std::vector<Vertex>& GeometryPool::vertices() const {
+  return vertices_;
+}
+
+const std::vector<math::Vec3>& GeometryPool::normals() const {
+  return normals_;
+}
+
+const std::vector<math::Vec2>& GeometryPool::uvs() const {
+  return uvs_;
+}
+
+const std::vector<uint32_t>& GeometryPool::indices() const {
+  return indices_;
+}
+
+uint64_t GeometryPool::revision() const {
+  return revision_;
+}
+
+GeometryPoolStats GeometryPool::stats() const {
+  GeometryPoolStats out{};
+  out.allocations = static_cast<uint32_t>(ranges_.size());
+  out.vertex_capacity = static_cast<uint32_t>(vertices_.size());
+  out.index_capacity = static_cast<uint32_t>(indices_.size());
+  out.vertex_used = out.vertex_capacity;
+  out.index_used = out.index_capacity;
+  out.free_vertex_blocks = static_cast<uint32_t>(free_vertices_.size());
+  out.free_index_blocks = static_cast<uint32_t>(free_indices_.size());
+
+  for (const FreeBlock& block : free_vertices_) {
+    out.vertex_used -= block.count;
+    out.largest_free_vertex_block = std::max(out.largest_free_vertex_block, block.count);
+  }
+  for (const FreeBlock& block : free_indices_) {
+    out.index_used -= block.count;
+    out.largest_free_index_block = std::max(out.largest_free_index_block, block.count);
+  }
+
+  out.defragmentations = defragmentations_;
+  out.dedup_hits = dedup_hits_;
+  out.bytes_saved = bytes_saved_;
+  return out;
+}
+
+size_t GeometryPool::memory_bytes() const {
+  return (vertices_.size() * sizeof(Vertex)) +
+         (normals_.size() * sizeof(math::Vec3)) +
+         (uvs_.size() * sizeof(math::Vec2)) +
+         (indices_.size() * sizeof(uint32_t));
+}
+
+bool GeometryPool::range_matches(const GeometryRange& range, const MeshData& mesh) const {
+  return range.vertex_count == mesh.vertices.size() && range.index_count == mesh.indices.size() &&
+         stream_matches(vertices_, range.vertex_offset, range.vertex_count, mesh.vertices) &&
+         stream_matches(normals_, range.vertex_offset, range.vertex_count, mesh.normals) &&
+         stream_matches(uvs_, range.vertex_offset, range.vertex_count, mesh.uvs) &&
+         stream_matches(indices_, range.index_offset, range.index_count, mesh.indices);
+}
+
+uint32_t GeometryPool::allocate_vertices(const uint32_t count) {
+  uint32_t offset = 0;
+  if (!take_first_fit(&free_vertices_, count, &offset)) {
+    grow_vertices(count);
+    take_first_fit(&free_vertices_, count, &offset);
+  }
+  return offset;
+}
+
+uint32_t GeometryPool::allocate_indices(const uint32_t count) {
+  uint32_t offset = 0;
+  if (!take_first_fit(&free_indices_, count, &offset)) {
+    grow_indices(count);
+    take_first_fit(&free_indices_, count, &offset);
+  }
+  return offset;
+}
+
+void GeometryPool::grow_vertices(const uint32_t min_count) {
+  const uint32_t old_size = static_cast<uint32_t>(vertices_.size());
+  const uint32_t extra = std::max(min_count, old_size == 0U ? initial_vertex_capacity_ : old_size / 2U);
+  vertices_.resize(static_cast<size_t>(old_size) + extra);
+  normals_.resize(vertices_.size());
+  uvs_.resize(vertices_.size());
+  release_block(&free_vertices_, old_size, extra);
+  revision_ += 1;
+}
+
+void GeometryPool::grow_indices(const uint32_t min_count) {
+  const uint32_t old_size = static_cast<uint32_t>(indices_.size());
+  const uint32_t extra = std::max(min_count, old_size == 0U ? initial_index_capacity_ : old_size / 2U);
+  indices_.resize(static_cast<size_t>(old_size) + extra);
+  release_block(&free_indices_, old_size, extra);
+  revision_ += 1;
+}
+
+bool GeometryPool::take_first_fit(std::vector<FreeBlock>* blocks, const uint32_t count, uint32_t* out_offset) {
+  for (auto it = blocks->begin(); it != blocks->end(); ++it) {
+    if (it->count < count) {
+      continue;
+    }
+
+    *out_offset = it->offset;
+    it->offset += count;
+    it->count -= count;
+    if (it->count == 0U) {
+      blocks->erase(it);
+    }
+    return true;
+  }
+  return false;
+}
+
+void GeometryPool::release_block(std::vector<FreeBlock>* blocks, const uint32_t offset, const uint32_t count) {
+  auto it = std::lower_bound(blocks->begin(), blocks->end(), offset, [](const FreeBlock& block, const uint32_t value) {
+    return block.offset < value;
+  });
+  it = blocks->insert(it, FreeBlock{offset, count});
+
+  // Coalesce with the following block, then with the preceding one.
+  const auto next = it + 1;
+  if (next != blocks->end() && it->offset + it->count == next->offset) {
+    it->count += next->count;
+    blocks->erase(next);
+  }
+  if (it != blocks->begin()) {
+    const auto prev = it - 1;
+    if (prev->offset + prev->count == it->offset) {
+      prev->count += it->count;
+      blocks->erase(it);
+    }
+  }
+}
+
+} // namespace engine::assets
@@ -1,14 +1,42 @@
 #include "engine/assets/gltf_loader.h"
 
+#include "engine/io/vfs.h"
+
 #include <cmath>
 #include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <iterator>
+#include <string_view>
+#include <utility>
 
 namespace engine::assets {
 
 namespace {
 
+std::vector<uint32_t> make_cone_indices(const int segments, const int stride) {
+  std::vector<uint32_t> indices;
+
+  // Side triangles.
+  for (int i = 0; i < segments; i += stride) {
+    const uint32_t curr = 2U + static_cast<uint32_t>(i);
+    const uint32_t next = 2U + static_cast<uint32_t>((i + stride) % segments);
+    indices.push_back(0U);
+    indices.push_back(curr);
+    indices.push_back(next);
+  }
+
+  // Base cap triangles.
+  for (int i = 0; i < segments; i += stride) {
+    const uint32_t curr = 2U + static_cast<uint32_t>(i);
+    const uint32_t next = 2U + static_cast<uint32_t>((i + stride) % segments);
+    indices.push_back(1U);
+    indices.push_back(next);
+    indices.push_back(curr);
+  }
+
+  return indices;
+}
+
 MeshData make_cone_mesh(const int segments) {
   MeshData mesh{};
   if (segments < 3) {
@@ -28,22 +56,14 @@ MeshData make_cone_mesh(const int segments) {
     mesh.vertices.push_back(Vertex{{radius * std::cos(t), -half_height, radius * std::sin(t)}});
   }
 
-  // Side triangles.
-  for (int i = 0; i < segments; ++i) {
-    const uint32_t curr = 2U + static_cast<uint32_t>(i);
-    const uint32_t next = 2U + static_cast<uint32_t>((i + 1) % segments);
-    mesh.indices.push_back(0U);
-    mesh.indices.push_back(curr);
-    mesh.indices.push_back(next);
-  }
+  mesh.indices = make_cone_indices(segments, 1);
 
-  // Base cap triangles.
-  for (int i = 0; i < segments; ++i) {
-    const uint32_t curr = 2U + static_cast<uint32_t>(i);
-    const uint32_t next = 2U + static_cast<uint32_t>((i + 1) % segments);
-    mesh.indices.push_back(1U);
-    mesh.indices.push_back(next);
-    mesh.indices.push_back(curr);
+  // Coarser levels skip ring vertices; the error is the sagitta of the skipped arc.
+  for (int stride = 2; segments / stride >= 3 && mesh.lods.size() + 1U < max_mesh_lods; stride *= 2) {
+    MeshLod lod{};
+    lod.indices = make_cone_indices(segments, stride);
+    lod.error = radius * (1.0F - std::cos(3.14159265359F * static_cast<float>(stride) / static_cast<float>(segments)));
+    mesh.lods.push_back(std::move(lod));
   }
 
   mesh.bounds = compute_aabb(mesh.vertices);
@@ -55,8 +75,7 @@ MeshData make_cone_mesh(const int segments) {
 GltfLoadResult GltfLoader::load(const std::string& path) {
   GltfLoadResult result{};
 
-  const std::filesystem::path file_path(path);
-  const std::string ext = file_path.extension().string();
+  const std::string ext = std::filesystem::path(path).extension().string();
   if (ext != ".gltf" && ext != ".glb") {
     result.error = "Unsupported mesh format: " + ext;
     return result;
@@ -68,15 +87,38 @@ GltfLoadResult GltfLoader::load(const std::string& path) {
     return result;
   }
 
-  std::ostringstream content_stream;
-  content_stream << in.rdbuf();
-  const std::string content = content_stream.str();
-  if (content.empty()) {
+  const std::vector<uint8_t> content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  return load_from_memory(path, content);
+}
+
+GltfLoadResult GltfLoader::load(const std::string& path, const io::Vfs& vfs) {
+  const io::FileData file = vfs.read(path);
+  if (!file.ok) {
+    GltfLoadResult result{};
+    result.error = file.error.empty() ? "Failed to open glTF file: " + path : file.error;
+    return result;
+  }
+
+  return load_from_memory(path, file.bytes());
+}
+
+GltfLoadResult GltfLoader::load_from_memory(const std::string& path, const std::span<const uint8_t> bytes) {
+  GltfLoadResult result{};
+
+  const std::filesystem::path file_path(path);
+  const std::string ext = file_path.extension().string();
+  if (ext != ".gltf" && ext != ".glb") {
+    result.error = "Unsupported mesh format: " + ext;
+    return result;
+  }
+
+  if (bytes.empty()) {
     result.error = "glTF file is empty: " + path;
     return result;
   }
 
-  if (ext == ".gltf" && content.find("\"asset\"") == std::string::npos) {
+  const std::string_view content(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  if (ext == ".gltf" && content.find("\"asset\"") == std::string_view::npos) {
     result.error = "Invalid glTF JSON (missing asset object): " + path;
     return result;
   }
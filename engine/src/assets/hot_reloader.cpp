@@ -0,0 +1,139 @@
+#include "engine/assets/hot_reloader.h"
+
+#include "engine/assets/asset_manager.h"
+#include "engine/core/logger.h"
+
+#include <chrono>
+#include <filesystem>
+#include <utility>
+
+namespace engine::assets {
+
+namespace {
+
+bool is_mesh_source(const std::string& path) {
+  const std::string ext = std::filesystem::path(path).extension().string();
+  return ext == ".gltf" || ext == ".glb";
+}
+
+} // namespace
+
+AssetHotReloader::AssetHotReloader(AssetManager& assets, core::Logger* logger)
+    : assets_(assets),
+      logger_(logger) {}
+
+AssetHotReloader::~AssetHotReloader() {
+  stop();
+}
+
+bool AssetHotReloader::start(const std::string& root, const bool force_polling) {
+  stop();
+
+  if (!watcher_.watch_directory(root, force_polling)) {
+    if (logger_ != nullptr) {
+      logger_->warn("Hot reload disabled, cannot watch directory: " + root);
+    }
+    return false;
+  }
+
+  stop_requested_ = false;
+  worker_ = std::thread(&AssetHotReloader::worker_main, this);
+
+  if (logger_ != nullptr) {
+    const char* backend = watcher_.backend() == io::FileWatchBackend::Inotify ? "inotify" : "polling";
+    logger_->info("Hot reload watching '" + root + "' (" + backend + ")");
+  }
+  return true;
+}
+
+void AssetHotReloader::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_requested_ = true;
+  }
+  wake_.notify_all();
+
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  watcher_.stop();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  completed_.clear();
+}
+
+uint32_t AssetHotReloader::update() {
+  std::vector<Reimport> ready;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ready.swap(completed_);
+  }
+
+  uint32_t applied = 0;
+  for (Reimport& reimport : ready) {
+    if (assets_.apply_reload(reimport.path, std::move(reimport.result))) {
+      applied += 1;
+    }
+  }
+
+  if (applied > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.swaps_applied += applied;
+  }
+  return applied;
+}
+
+bool AssetHotReloader::running() const {
+  return worker_.joinable();
+}
+
+io::FileWatchBackend AssetHotReloader::backend() const {
+  return watcher_.backend();
+}
+
+HotReloadStats AssetHotReloader::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void AssetHotReloader::worker_main() {
+  std::vector<std::string> changed;
+
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait_for(lock, std::chrono::milliseconds(100), [this] { return stop_requested_; });
+      if (stop_requested_) {
+        return;
+      }
+    }
+
+    changed.clear();
+    watcher_.poll(&changed);
+
+    for (const std::string& path : changed) {
+      if (!is_mesh_source(path) || !std::filesystem::exists(path)) {
+        continue;
+      }
+      if (!assets_.is_loaded_path(path)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.changes_detected += 1;
+        continue;
+      }
+
+      // Only the changed file is re-imported, through the same VFS and import settings as the
+      // original load; the swap waits for the next update().
+      Reimport reimport{path, assets_.import_file(path)};
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      stats_.changes_detected += 1;
+      stats_.reimports += 1;
+      if (!reimport.result.ok) {
+        stats_.failures += 1;
+      }
+      completed_.push_back(std::move(reimport));
+    }
+  }
+}
+
+} // namespace engine::assets
@@ -1,5 +1,7 @@
 #include "engine/assets/mesh_data.h"
 
+#include "engine/assets/vertex_format.h"
+
 #include <algorithm>
 
 namespace engine::assets {
@@ -26,4 +28,46 @@ Aabb compute_aabb(const std::vector<Vertex>& vertices) {
   return out;
 }
 
+Aabb merge_aabb(const Aabb& a, const Aabb& b) {
+  Aabb out{};
+  out.min = {std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)};
+  out.max = {std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)};
+  return out;
+}
+
+size_t mesh_memory_bytes(const MeshData& mesh) {
+  size_t bytes = (mesh.vertices.size() * sizeof(Vertex)) +
+                 (mesh.normals.size() * sizeof(math::Vec3)) +
+                 (mesh.uvs.size() * sizeof(math::Vec2)) +
+                 (mesh.indices.size() * sizeof(uint32_t));
+  for (const MeshLod& lod : mesh.lods) {
+    bytes += lod.indices.size() * sizeof(uint32_t);
+  }
+  bytes += (mesh.meshlets.size() * sizeof(Meshlet)) +
+           (mesh.meshlet_vertices.size() * sizeof(uint32_t)) +
+           mesh.meshlet_triangles.size();
+  if (mesh.compressed != nullptr) {
+    bytes += compressed_memory_bytes(*mesh.compressed);
+  }
+  return bytes;
+}
+
+uint32_t mesh_lod_count(const MeshData& mesh) {
+  return std::min(max_mesh_lods, 1U + static_cast<uint32_t>(mesh.lods.size()));
+}
+
+const std::vector<uint32_t>& mesh_lod_indices(const MeshData& mesh, const uint32_t lod) {
+  if (lod == 0U || mesh.lods.empty()) {
+    return mesh.indices;
+  }
+  return mesh.lods[std::min<size_t>(lod, mesh.lods.size()) - 1U].indices;
+}
+
+float mesh_lod_error(const MeshData& mesh, const uint32_t lod) {
+  if (lod == 0U || mesh.lods.empty()) {
+    return 0.0F;
+  }
+  return mesh.lods[std::min<size_t>(lod, mesh.lods.size()) - 1U].error;
+}
+
 } // namespace engine::assets
@@ -0,0 +1,396 @@
+#include "engine/assets/mesh_simplifier.h"
+
+#include "engine/core/thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <latch>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+namespace engine::assets {
+
+namespace {
+
+// Symmetric 4x4 quadric stored as its 10 unique terms.
+struct Quadric {
+  double a00 = 0.0;
+  double a01 = 0.0;
+  double a02 = 0.0;
+  double a11 = 0.0;
+  double a12 = 0.0;
+  double a22 = 0.0;
+  double b0 = 0.0;
+  double b1 = 0.0;
+  double b2 = 0.0;
+  double c = 0.0;
+
+  Quadric& operator+=(const Quadric& o) {
+    a00 += o.a00;
+    a01 += o.a01;
+    a02 += o.a02;
+    a11 += o.a11;
+    a12 += o.a12;
+    a22 += o.a22;
+    b0 += o.b0;
+    b1 += o.b1;
+    b2 += o.b2;
+    c += o.c;
+    return *this;
+  }
+};
+
+// Unweighted plane quadrics, so sqrt(error) stays a distance in object units.
+void add_plane(Quadric* q, const math::Vec3& n, const float d) {
+  q->a00 += static_cast<double>(n.x) * n.x;
+  q->a01 += static_cast<double>(n.x) * n.y;
+  q->a02 += static_cast<double>(n.x) * n.z;
+  q->a11 += static_cast<double>(n.y) * n.y;
+  q->a12 += static_cast<double>(n.y) * n.z;
+  q->a22 += static_cast<double>(n.z) * n.z;
+  q->b0 += static_cast<double>(n.x) * d;
+  q->b1 += static_cast<double>(n.y) * d;
+  q->b2 += static_cast<double>(n.z) * d;
+  q->c += static_cast<double>(d) * d;
+}
+
+double evaluate(const Quadric& q, const math::Vec3& p) {
+  const double x = p.x;
+  const double y = p.y;
+  const double z = p.z;
+  const double value = (q.a00 * x * x) + (2.0 * q.a01 * x * y) + (2.0 * q.a02 * x * z) + (q.a11 * y * y) +
+                       (2.0 * q.a12 * y * z) + (q.a22 * z * z) + (2.0 * ((q.b0 * x) + (q.b1 * y) + (q.b2 * z))) + q.c;
+  return std::max(0.0, value);
+}
+
+Quadric sum(Quadric a, const Quadric& b) {
+  a += b;
+  return a;
+}
+
+uint64_t edge_key(const uint32_t a, const uint32_t b) {
+  return (static_cast<uint64_t>(std::min(a, b)) << 32U) | std::max(a, b);
+}
+
+struct PositionKey {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t z = 0;
+
+  bool operator==(const PositionKey&) const = default;
+};
+
+struct PositionKeyHash {
+  size_t operator()(const PositionKey& key) const {
+    return static_cast<size_t>((static_cast<uint64_t>(key.x) * 73856093ULL) ^ (static_cast<uint64_t>(key.y) * 19349663ULL) ^
+                               (static_cast<uint64_t>(key.z) * 83492791ULL));
+  }
+};
+
+// Vertices that only differ in attributes (UV/normal seams) share one topological vertex.
+struct WeldedVertices {
+  std::vector<uint32_t> class_of;       // per source vertex
+  std::vector<uint32_t> representative; // per class, first source vertex
+  std::vector<uint32_t> members;        // per class, number of source vertices
+};
+
+WeldedVertices weld_positions(const std::vector<Vertex>& vertices) {
+  WeldedVertices out{};
+  out.class_of.resize(vertices.size());
+
+  std::unordered_map<PositionKey, uint32_t, PositionKeyHash> classes;
+  classes.reserve(vertices.size());
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    PositionKey key{};
+    std::memcpy(&key.x, &vertices[i].position.x, sizeof(float));
+    std::memcpy(&key.y, &vertices[i].position.y, sizeof(float));
+    std::memcpy(&key.z, &vertices[i].position.z, sizeof(float));
+
+    const auto [it, inserted] = classes.try_emplace(key, static_cast<uint32_t>(out.representative.size()));
+    if (inserted) {
+      out.representative.push_back(static_cast<uint32_t>(i));
+      out.members.push_back(0U);
+    }
+    out.class_of[i] = it->second;
+    out.members[it->second] += 1U;
+  }
+  return out;
+}
+
+math::Vec3 triangle_normal(const math::Vec3& a, const math::Vec3& b, const math::Vec3& c) {
+  return math::cross(b - a, c - a);
+}
+
+} // namespace
+
+SimplifyResult simplify_mesh(const MeshData& mesh, const SimplifyOptions& options) {
+  SimplifyResult result{};
+  const size_t source_triangles = mesh.indices.size() / 3U;
+  result.indices.assign(mesh.indices.begin(), mesh.indices.begin() + static_cast<std::ptrdiff_t>(source_triangles * 3U));
+  if (source_triangles == 0U ||
+      std::any_of(result.indices.begin(), result.indices.end(), [&mesh](const uint32_t i) { return i >= mesh.vertices.size(); })) {
+    return result;
+  }
+
+  const WeldedVertices welded = weld_positions(mesh.vertices);
+  const auto class_count = static_cast<uint32_t>(welded.representative.size());
+
+  std::vector<math::Vec3> positions(class_count);
+  for (uint32_t v = 0; v < class_count; ++v) {
+    positions[v] = mesh.vertices[welded.representative[v]].position;
+  }
+
+  std::vector<uint32_t>& corners = result.indices;
+  std::vector<uint32_t> classes(corners.size());
+  for (size_t i = 0; i < corners.size(); ++i) {
+    classes[i] = welded.class_of[corners[i]];
+  }
+
+  std::vector<Quadric> quadrics(class_count);
+  for (size_t t = 0; t < source_triangles; ++t) {
+    const uint32_t* tri = &classes[t * 3U];
+    const math::Vec3 n = triangle_normal(positions[tri[0]], positions[tri[1]], positions[tri[2]]);
+    const float len = math::length(n);
+    if (len <= 1.0e-12F) {
+      continue;
+    }
+    const math::Vec3 unit = n * (1.0F / len);
+    const float d = -math::dot(unit, positions[tri[0]]);
+    for (int k = 0; k < 3; ++k) {
+      add_plane(&quadrics[tri[k]], unit, d);
+    }
+  }
+
+  std::vector<uint8_t> locked(class_count, 0U);
+  if (options.lock_borders) {
+    std::unordered_map<uint64_t, uint32_t> edge_uses;
+    edge_uses.reserve(classes.size());
+    for (size_t t = 0; t < source_triangles; ++t) {
+      for (int k = 0; k < 3; ++k) {
+        const uint32_t a = classes[(t * 3U) + k];
+        const uint32_t b = classes[(t * 3U) + ((k + 1) % 3)];
+        if (a != b) {
+          edge_uses[edge_key(a, b)] += 1U;
+        }
+      }
+    }
+    for (const auto& [key, uses] : edge_uses) {
+      if (uses == 1U) {
+        locked[static_cast<uint32_t>(key >> 32U)] = 1U;
+        locked[static_cast<uint32_t>(key & 0xFFFFFFFFULL)] = 1U;
+      }
+    }
+    for (uint32_t v = 0; v < class_count; ++v) {
+      if (welded.members[v] > 1U) {
+        locked[v] = 1U;
+      }
+    }
+  }
+
+  const size_t target = std::max<size_t>(
+      1U, static_cast<size_t>(static_cast<double>(source_triangles) * std::clamp(options.target_ratio, 0.0F, 1.0F)));
+  const double max_cost = static_cast<double>(options.max_error) * options.max_error;
+  double applied_cost = 0.0;
+  size_t live = source_triangles;
+
+  struct Candidate {
+    uint32_t from = 0;
+    uint32_t to = 0;
+    double cost = 0.0;
+  };
+
+  std::vector<uint32_t> collapsed_to(class_count);
+  std::vector<uint8_t> touched(class_count);
+  std::vector<uint32_t> adjacency_offsets(class_count + 1U);
+  std::vector<uint32_t> adjacency;
+  std::vector<uint64_t> edges;
+  std::vector<Candidate> candidates;
+
+  while (live > target) {
+    // Vertex -> triangle adjacency for this pass.
+    std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0U);
+    for (size_t i = 0; i < live * 3U; ++i) {
+      adjacency_offsets[classes[i] + 1U] += 1U;
+    }
+    std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+    adjacency.resize(live * 3U);
+    {
+      std::vector<uint32_t> cursor(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+      for (size_t i = 0; i < live * 3U; ++i) {
+        adjacency[cursor[classes[i]]++] = static_cast<uint32_t>(i / 3U);
+      }
+    }
+
+    edges.clear();
+    for (size_t t = 0; t < live; ++t) {
+      for (int k = 0; k < 3; ++k) {
+        edges.push_back(edge_key(classes[(t * 3U) + k], classes[(t * 3U) + ((k + 1) % 3)]));
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    candidates.clear();
+    for (const uint64_t key : edges) {
+      const auto a = static_cast<uint32_t>(key >> 32U);
+      const auto b = static_cast<uint32_t>(key & 0xFFFFFFFFULL);
+      if (locked[a] != 0U && locked[b] != 0U) {
+        continue;
+      }
+
+      const Quadric combined = sum(quadrics[a], quadrics[b]);
+      const double cost_a_to_b = locked[a] != 0U ? -1.0 : evaluate(combined, positions[b]);
+      const double cost_b_to_a = locked[b] != 0U ? -1.0 : evaluate(combined, positions[a]);
+      if (cost_b_to_a < 0.0 || (cost_a_to_b >= 0.0 && cost_a_to_b <= cost_b_to_a)) {
+        candidates.push_back({a, b, cost_a_to_b});
+      } else {
+        candidates.push_back({b, a, cost_b_to_a});
+      }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& x, const Candidate& y) { return x.cost < y.cost; });
+
+    std::iota(collapsed_to.begin(), collapsed_to.end(), 0U);
+    std::fill(touched.begin(), touched.end(), 0U);
+
+    const size_t wanted = live - target;
+    size_t removed = 0;
+    uint32_t pass_collapses = 0;
+    for (const Candidate& candidate : candidates) {
+      if (candidate.cost > max_cost || removed >= wanted) {
+        break;
+      }
+      if (touched[candidate.from] != 0U || touched[candidate.to] != 0U) {
+        continue;
+      }
+
+      // Reject collapses that flip a surviving triangle around the removed vertex.
+      bool flips = false;
+      uint32_t shared = 0;
+      for (uint32_t a = adjacency_offsets[candidate.from]; a < adjacency_offsets[candidate.from + 1U] && !flips; ++a) {
+        const uint32_t* tri = &classes[static_cast<size_t>(adjacency[a]) * 3U];
+        if (tri[0] == candidate.to || tri[1] == candidate.to || tri[2] == candidate.to) {
+          shared += 1U;
+          continue;
+        }
+
+        math::Vec3 p[3] = {positions[tri[0]], positions[tri[1]], positions[tri[2]]};
+        const math::Vec3 before = triangle_normal(p[0], p[1], p[2]);
+        for (int k = 0; k < 3; ++k) {
+          if (tri[k] == candidate.from) {
+            p[k] = positions[candidate.to];
+          }
+        }
+        flips = math::dot(before, triangle_normal(p[0], p[1], p[2])) <= 0.0F;
+      }
+      if (flips) {
+        continue;
+      }
+
+      collapsed_to[candidate.from] = candidate.to;
+      quadrics[candidate.to] += quadrics[candidate.from];
+      applied_cost = std::max(applied_cost, candidate.cost);
+
+      // Freeze the whole one-ring so later flip tests in this pass see current positions.
+      for (uint32_t a = adjacency_offsets[candidate.from]; a < adjacency_offsets[candidate.from + 1U]; ++a) {
+        const uint32_t* tri = &classes[static_cast<size_t>(adjacency[a]) * 3U];
+        touched[tri[0]] = 1U;
+        touched[tri[1]] = 1U;
+        touched[tri[2]] = 1U;
+      }
+      touched[candidate.to] = 1U;
+
+      removed += shared;
+      pass_collapses += 1U;
+    }
+
+    if (pass_collapses == 0U) {
+      break;
+    }
+    result.collapses += pass_collapses;
+
+    size_t write = 0;
+    for (size_t t = 0; t < live; ++t) {
+      uint32_t tri[3];
+      uint32_t corner[3];
+      for (int k = 0; k < 3; ++k) {
+        const uint32_t cls = classes[(t * 3U) + k];
+        tri[k] = collapsed_to[cls];
+        corner[k] = tri[k] != cls ? welded.representative[tri[k]] : corners[(t * 3U) + k];
+      }
+      if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2]) {
+        continue;
+      }
+      for (int k = 0; k < 3; ++k) {
+        classes[(write * 3U) + k] = tri[k];
+        corners[(write * 3U) + k] = corner[k];
+      }
+      write += 1U;
+    }
+    live = write;
+  }
+
+  corners.resize(live * 3U);
+  result.error = static_cast<float>(std::sqrt(applied_cost));
+  return result;
+}
+
+void generate_lod_chain(MeshData* mesh, const LodChainOptions& options) {
+  mesh->lods.clear();
+
+  size_t previous_triangles = mesh->indices.size() / 3U;
+  float previous_error = 0.0F;
+  for (const float ratio : options.triangle_ratios) {
+    if (mesh->lods.size() + 1U >= max_mesh_lods) {
+      break;
+    }
+
+    SimplifyOptions simplify_options{};
+    simplify_options.target_ratio = ratio;
+    simplify_options.max_error = options.max_error;
+    simplify_options.lock_borders = options.lock_borders;
+    SimplifyResult simplified = simplify_mesh(*mesh, simplify_options);
+
+    const size_t triangles = simplified.indices.size() / 3U;
+    if (triangles == 0U || static_cast<float>(triangles) > static_cast<float>(previous_triangles) * options.min_reduction) {
+      break;
+    }
+
+    // Levels are simplified from LOD 0 independently; keep the published error monotonic.
+    MeshLod lod{};
+    lod.indices = std::move(simplified.indices);
+    lod.error = std::max(simplified.error, previous_error);
+    previous_triangles = triangles;
+    previous_error = lod.error;
+    mesh->lods.push_back(std::move(lod));
+  }
+}
+
+void generate_missing_lod_chains(const std::span<MeshData> meshes, const LodChainOptions& options, core::ThreadPool* pool) {
+  std::vector<MeshData*> pending;
+  for (MeshData& mesh : meshes) {
+    if (mesh.lods.empty() && mesh.indices.size() >= 3U) {
+      pending.push_back(&mesh);
+    }
+  }
+
+  if (pool == nullptr || pending.size() < 2U) {
+    for (MeshData* mesh : pending) {
+      generate_lod_chain(mesh, options);
+    }
+    return;
+  }
+
+  // Must not be called from a job on the same pool: the caller blocks until all meshes are done.
+  std::latch done(static_cast<std::ptrdiff_t>(pending.size()));
+  for (MeshData* mesh : pending) {
+    pool->submit([mesh, &options, &done] {
+      generate_lod_chain(mesh, options);
+      done.count_down();
+    });
+  }
+  done.wait();
+}
+
+} // namespace engine::assets
@@ -0,0 +1,158 @@
+#include "engine/assets/mesh_store.h"
+
+#include "engine/assets/vertex_format.h"
+#include "engine/core/hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace engine::assets {
+
+namespace {
+
+template <typename T>
+uint64_t hash_stream(const std::vector<T>& stream, const uint64_t hash) {
+  const uint64_t count = stream.size();
+  const uint64_t with_count = core::fnv1a_64(&count, sizeof(count), hash);
+  return stream.empty() ? with_count : core::fnv1a_64(stream.data(), stream.size() * sizeof(T), with_count);
+}
+
+template <typename T>
+bool stream_equal(const std::vector<T>& a, const std::vector<T>& b) {
+  return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
+bool compressed_vertices_equal(const CompressedMesh* a, const CompressedMesh* b) {
+  if (a == nullptr || b == nullptr) {
+    return a == b;
+  }
+  return a->vertex_count == b->vertex_count &&
+         a->layout.position == b->layout.position && a->layout.normal == b->layout.normal &&
+         a->layout.uv == b->layout.uv &&
+         std::memcmp(&a->bounds, &b->bounds, sizeof(Aabb)) == 0 &&
+         stream_equal(a->position_stream, b->position_stream) &&
+         stream_equal(a->attribute_stream, b->attribute_stream);
+}
+
+} // namespace
+
+uint64_t hash_mesh_content(const MeshData& mesh) {
+  uint64_t hash = core::fnv1a_64_offset_basis;
+  hash = hash_stream(mesh.vertices, hash);
+  hash = hash_stream(mesh.normals, hash);
+  hash = hash_stream(mesh.uvs, hash);
+  hash = hash_stream(mesh.indices, hash);
+  for (const MeshLod& lod : mesh.lods) {
+    hash = hash_stream(lod.indices, hash);
+    hash = core::fnv1a_64(&lod.error, sizeof(lod.error), hash);
+  }
+  hash = hash_stream(mesh.meshlets, hash);
+  hash = hash_stream(mesh.meshlet_vertices, hash);
+  hash = hash_stream(mesh.meshlet_triangles, hash);
+  if (mesh.compressed != nullptr) {
+    // Quantized positions are relative to the bounds, so equal streams need equal bounds.
+    const CompressedMesh& compressed = *mesh.compressed;
+    hash = core::fnv1a_64(&compressed.bounds, sizeof(compressed.bounds), hash);
+    hash = hash_stream(compressed.position_stream, hash);
+    hash = hash_stream(compressed.attribute_stream, hash);
+  }
+  return hash;
+}
+
+bool mesh_content_equal(const MeshData& a, const MeshData& b) {
+  return stream_equal(a.vertices, b.vertices) &&
+         stream_equal(a.normals, b.normals) &&
+         stream_equal(a.uvs, b.uvs) &&
+         stream_equal(a.indices, b.indices) &&
+         std::equal(a.lods.begin(), a.lods.end(), b.lods.begin(), b.lods.end(), [](const MeshLod& x, const MeshLod& y) {
+           return x.error == y.error && stream_equal(x.indices, y.indices);
+         }) &&
+         stream_equal(a.meshlets, b.meshlets) &&
+         stream_equal(a.meshlet_vertices, b.meshlet_vertices) &&
+         stream_equal(a.meshlet_triangles, b.meshlet_triangles) &&
+         compressed_vertices_equal(a.compressed.get(), b.compressed.get());
+}
+
+std::shared_ptr<const MeshData> MeshStore::acquire(MeshData mesh, bool* out_deduplicated) {
+  const uint64_t hash = hash_mesh_content(mesh);
+  std::vector<Entry>& bucket = buckets_[hash];
+
+  for (Entry& entry : bucket) {
+    if (mesh_content_equal(*entry.data, mesh)) {
+      entry.ref_count += 1;
+      stats_.dedup_hits += 1;
+      stats_.bytes_saved += entry.bytes;
+      if (out_deduplicated != nullptr) {
+        *out_deduplicated = true;
+      }
+      return entry.data;
+    }
+  }
+
+  Entry entry{};
+  entry.bytes = mesh_memory_bytes(mesh);
+  entry.data = std::make_shared<const MeshData>(std::move(mesh));
+  entry.ref_count = 1;
+
+  stats_.unique_bytes += entry.bytes;
+  hash_by_buffer_[entry.data.get()] = hash;
+  bucket.push_back(entry);
+
+  if (out_deduplicated != nullptr) {
+    *out_deduplicated = false;
+  }
+  return entry.data;
+}
+
+size_t MeshStore::release(const std::shared_ptr<const MeshData>& mesh) {
+  const auto hash_it = hash_by_buffer_.find(mesh.get());
+  if (hash_it == hash_by_buffer_.end()) {
+    return 0;
+  }
+
+  const auto bucket_it = buckets_.find(hash_it->second);
+  if (bucket_it == buckets_.end()) {
+    return 0;
+  }
+
+  std::vector<Entry>& bucket = bucket_it->second;
+  for (size_t i = 0; i < bucket.size(); ++i) {
+    Entry& entry = bucket[i];
+    if (entry.data != mesh) {
+      continue;
+    }
+
+    entry.ref_count -= 1;
+    if (entry.ref_count > 0) {
+      stats_.bytes_saved -= entry.bytes;
+      return 0;
+    }
+
+    const size_t freed = entry.bytes;
+    stats_.unique_bytes -= freed;
+    hash_by_buffer_.erase(hash_it);
+    bucket.erase(bucket.begin() + static_cast<std::ptrdiff_t>(i));
+    if (bucket.empty()) {
+      buckets_.erase(bucket_it);
+    }
+    return freed;
+  }
+
+  return 0;
+}
+
+MeshStoreStats MeshStore::stats() const {
+  MeshStoreStats out = stats_;
+  out.unique_meshes = static_cast<uint32_t>(hash_by_buffer_.size());
+  out.shared_references = 0;
+  for (const auto& [hash, bucket] : buckets_) {
+    (void)hash;
+    for (const Entry& entry : bucket) {
+      out.shared_references += entry.ref_count > 1 ? entry.ref_count : 0U;
+    }
+  }
+  return out;
+}
+
+} // namespace engine::assets
@@ -0,0 +1,199 @@
+#include "engine/assets/meshlet_builder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace engine::assets {
+
+namespace {
+
+constexpr uint32_t no_slot = std::numeric_limits<uint32_t>::max();
+// Cones wider than this (min normal . axis) cannot reject anything useful.
+constexpr float min_cone_dot = 0.1F;
+
+void compute_meshlet_bounds(const MeshData& mesh, Meshlet* meshlet) {
+  const uint32_t* vertices = mesh.meshlet_vertices.data() + meshlet->vertex_offset;
+  const uint8_t* triangles = mesh.meshlet_triangles.data() + meshlet->triangle_offset;
+
+  math::Vec3 min = mesh.vertices[vertices[0]].position;
+  math::Vec3 max = min;
+  for (uint32_t i = 1; i < meshlet->vertex_count; ++i) {
+    const math::Vec3& p = mesh.vertices[vertices[i]].position;
+    min = {std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z)};
+    max = {std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z)};
+  }
+  meshlet->center = (min + max) * 0.5F;
+  meshlet->radius = 0.0F;
+  for (uint32_t i = 0; i < meshlet->vertex_count; ++i) {
+    meshlet->radius = std::max(meshlet->radius, math::length(mesh.vertices[vertices[i]].position - meshlet->center));
+  }
+
+  // Normal cone from counter-clockwise front faces.
+  math::Vec3 normal_sum{0.0F, 0.0F, 0.0F};
+  for (uint32_t t = 0; t < meshlet->triangle_count; ++t) {
+    const math::Vec3& p0 = mesh.vertices[vertices[triangles[(t * 3U) + 0U]]].position;
+    const math::Vec3& p1 = mesh.vertices[vertices[triangles[(t * 3U) + 1U]]].position;
+    const math::Vec3& p2 = mesh.vertices[vertices[triangles[(t * 3U) + 2U]]].position;
+    normal_sum = normal_sum + math::normalize(math::cross(p1 - p0, p2 - p0));
+  }
+
+  meshlet->cone_axis = math::normalize(normal_sum);
+  meshlet->cone_apex = meshlet->center;
+  meshlet->cone_cutoff = 2.0F;
+  if (math::length(meshlet->cone_axis) < 0.5F) {
+    return;
+  }
+
+  float min_dot = 1.0F;
+  for (uint32_t t = 0; t < meshlet->triangle_count; ++t) {
+    const math::Vec3& p0 = mesh.vertices[vertices[triangles[(t * 3U) + 0U]]].position;
+    const math::Vec3& p1 = mesh.vertices[vertices[triangles[(t * 3U) + 1U]]].position;
+    const math::Vec3& p2 = mesh.vertices[vertices[triangles[(t * 3U) + 2U]]].position;
+    const math::Vec3 normal = math::normalize(math::cross(p1 - p0, p2 - p0));
+    if (math::length(normal) > 0.5F) {
+      min_dot = std::min(min_dot, math::dot(normal, meshlet->cone_axis));
+    }
+  }
+  if (min_dot < min_cone_dot) {
+    return;
+  }
+
+  // Move the apex back along the axis until every triangle plane lies in front of it.
+  float max_t = 0.0F;
+  for (uint32_t t = 0; t < meshlet->triangle_count; ++t) {
+    const math::Vec3& p0 = mesh.vertices[vertices[triangles[(t * 3U) + 0U]]].position;
+    const math::Vec3& p1 = mesh.vertices[vertices[triangles[(t * 3U) + 1U]]].position;
+    const math::Vec3& p2 = mesh.vertices[vertices[triangles[(t * 3U) + 2U]]].position;
+    const math::Vec3 normal = math::normalize(math::cross(p1 - p0, p2 - p0));
+    const float denominator = math::dot(normal, meshlet->cone_axis);
+    if (denominator > 0.0F) {
+      max_t = std::max(max_t, math::dot(meshlet->center - p0, normal) / denominator);
+    }
+  }
+  meshlet->cone_apex = meshlet->center - (meshlet->cone_axis * max_t);
+  meshlet->cone_cutoff = std::sqrt(std::max(0.0F, 1.0F - (min_dot * min_dot)));
+}
+
+} // namespace
+
+uint32_t build_meshlets(MeshData* mesh, const MeshletOptions& options) {
+  mesh->meshlets.clear();
+  mesh->meshlet_vertices.clear();
+  mesh->meshlet_triangles.clear();
+
+  // Local vertex indices are stored in a byte.
+  const uint32_t max_vertices = std::clamp(options.max_vertices, 3U, 256U);
+  const uint32_t max_triangles = std::max(options.max_triangles, 1U);
+  const auto vertex_count = static_cast<uint32_t>(mesh->vertices.size());
+  const auto triangle_count = static_cast<uint32_t>(mesh->indices.size() / 3U);
+  if (triangle_count == 0U || triangle_count < options.min_source_triangles) {
+    return 0;
+  }
+  for (const uint32_t index : mesh->indices) {
+    if (index >= vertex_count) {
+      return 0;
+    }
+  }
+
+  // Vertex -> triangle adjacency in compressed rows.
+  std::vector<uint32_t> adjacency_offsets(static_cast<size_t>(vertex_count) + 1U, 0U);
+  for (uint32_t i = 0; i < triangle_count * 3U; ++i) {
+    adjacency_offsets[mesh->indices[i] + 1U] += 1;
+  }
+  for (uint32_t v = 0; v < vertex_count; ++v) {
+    adjacency_offsets[v + 1U] += adjacency_offsets[v];
+  }
+  std::vector<uint32_t> adjacency(static_cast<size_t>(triangle_count) * 3U);
+  std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+  for (uint32_t i = 0; i < triangle_count * 3U; ++i) {
+    adjacency[fill[mesh->indices[i]]++] = i / 3U;
+  }
+
+  std::vector<uint8_t> used(triangle_count, 0U);
+  std::vector<uint32_t> local_slot(vertex_count, no_slot);
+  std::vector<uint32_t> candidates;
+  uint32_t cursor = 0;
+
+  Meshlet meshlet;
+  const auto new_vertices = [&](const uint32_t triangle) {
+    uint32_t count = 0;
+    for (uint32_t k = 0; k < 3U; ++k) {
+      count += local_slot[mesh->indices[(triangle * 3U) + k]] == no_slot ? 1U : 0U;
+    }
+    return count;
+  };
+  const auto add_triangle = [&](const uint32_t triangle) {
+    used[triangle] = 1U;
+    for (uint32_t k = 0; k < 3U; ++k) {
+      const uint32_t vertex = mesh->indices[(triangle * 3U) + k];
+      if (local_slot[vertex] == no_slot) {
+        local_slot[vertex] = meshlet.vertex_count++;
+        mesh->meshlet_vertices.push_back(vertex);
+        for (uint32_t a = adjacency_offsets[vertex]; a < adjacency_offsets[vertex + 1U]; ++a) {
+          if (used[adjacency[a]] == 0U) {
+            candidates.push_back(adjacency[a]);
+          }
+        }
+      }
+      mesh->meshlet_triangles.push_back(static_cast<uint8_t>(local_slot[vertex]));
+    }
+    meshlet.triangle_count += 1;
+  };
+
+  while (true) {
+    while (cursor < triangle_count && used[cursor] != 0U) {
+      ++cursor;
+    }
+    if (cursor == triangle_count) {
+      break;
+    }
+
+    meshlet = {};
+    meshlet.vertex_offset = static_cast<uint32_t>(mesh->meshlet_vertices.size());
+    meshlet.triangle_offset = static_cast<uint32_t>(mesh->meshlet_triangles.size());
+    candidates.clear();
+    add_triangle(cursor);
+
+    // Grow across shared vertices, preferring triangles that add the fewest new vertices.
+    while (meshlet.triangle_count < max_triangles) {
+      uint32_t best = no_slot;
+      uint32_t best_cost = 4U;
+      size_t kept = 0;
+      for (const uint32_t candidate : candidates) {
+        if (used[candidate] != 0U) {
+          continue;
+        }
+        candidates[kept++] = candidate;
+        const uint32_t cost = new_vertices(candidate);
+        if (cost < best_cost && meshlet.vertex_count + cost <= max_vertices) {
+          best = candidate;
+          best_cost = cost;
+        }
+      }
+      candidates.resize(kept);
+      if (best == no_slot) {
+        break;
+      }
+      add_triangle(best);
+    }
+
+    for (uint32_t i = 0; i < meshlet.vertex_count; ++i) {
+      local_slot[mesh->meshlet_vertices[meshlet.vertex_offset + i]] = no_slot;
+    }
+    compute_meshlet_bounds(*mesh, &meshlet);
+    mesh->meshlets.push_back(meshlet);
+  }
+
+  return static_cast<uint32_t>(mesh->meshlets.size());
+}
+
+void append_meshlet_indices(const MeshData& mesh, const Meshlet& meshlet, std::vector<uint32_t>* out_indices) {
+  const uint32_t* vertices = mesh.meshlet_vertices.data() + meshlet.vertex_offset;
+  const uint8_t* triangles = mesh.meshlet_triangles.data() + meshlet.triangle_offset;
+  for (uint32_t i = 0; i < meshlet.triangle_count * 3U; ++i) {
+    out_indices->push_back(vertices[triangles[i]]);
+  }
+}
+
+} // namespace engine::assets
@@ -0,0 +1,488 @@
+#include "engine/assets/vertex_format.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace engine::assets {
+
+namespace {
+
+constexpr float unorm16_max = 65535.0F;
+
+float sign_not_zero(const float v) {
+  return (v >= 0.0F) ? 1.0F : -1.0F;
+}
+
+math::Vec2 octahedral_encode(const math::Vec3& n) {
+  const float l1 = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+  if (l1 <= 0.000001F) {
+    return {0.0F, 0.0F};
+  }
+
+  math::Vec2 p{n.x / l1, n.y / l1};
+  if (n.z < 0.0F) {
+    const float px = p.x;
+    p.x = (1.0F - std::fabs(p.y)) * sign_not_zero(px);
+    p.y = (1.0F - std::fabs(px)) * sign_not_zero(p.y);
+  }
+  return p;
+}
+
+math::Vec3 octahedral_decode(const math::Vec2& p) {
+  math::Vec3 n{p.x, p.y, 1.0F - std::fabs(p.x) - std::fabs(p.y)};
+  if (n.z < 0.0F) {
+    const float nx = n.x;
+    n.x = (1.0F - std::fabs(n.y)) * sign_not_zero(nx);
+    n.y = (1.0F - std::fabs(nx)) * sign_not_zero(n.y);
+  }
+  return math::normalize(n);
+}
+
+template <typename T>
+T quantize_snorm(const float v) {
+  constexpr float max_value = static_cast<float>((1 << ((sizeof(T) * 8) - 1)) - 1);
+  return static_cast<T>(std::lround(std::clamp(v, -1.0F, 1.0F) * max_value));
+}
+
+template <typename T>
+float dequantize_snorm(const T v) {
+  constexpr float max_value = static_cast<float>((1 << ((sizeof(T) * 8) - 1)) - 1);
+  return std::max(static_cast<float>(v) / max_value, -1.0F);
+}
+
+uint16_t quantize_unorm16(const float value, const float min, const float extent) {
+  if (extent <= 0.0F) {
+    return 0;
+  }
+  const float t = std::clamp((value - min) / extent, 0.0F, 1.0F);
+  return static_cast<uint16_t>(std::lround(t * unorm16_max));
+}
+
+float dequantize_unorm16(const uint16_t value, const float min, const float extent) {
+  return min + ((static_cast<float>(value) / unorm16_max) * extent);
+}
+
+template <typename T>
+void write_value(std::vector<uint8_t>* stream, const size_t offset, const T value) {
+  std::memcpy(stream->data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T read_value(const std::vector<uint8_t>& stream, const size_t offset) {
+  T value{};
+  std::memcpy(&value, stream.data() + offset, sizeof(T));
+  return value;
+}
+
+uint32_t normal_bytes(const NormalEncoding encoding) {
+  switch (encoding) {
+  case NormalEncoding::Float32:
+    return 12U;
+  case NormalEncoding::Octahedral8:
+    return 2U;
+  case NormalEncoding::Octahedral16:
+    return 4U;
+  case NormalEncoding::None:
+  default:
+    return 0U;
+  }
+}
+
+uint32_t uv_bytes(const UvEncoding encoding) {
+  switch (encoding) {
+  case UvEncoding::Float32:
+    return 8U;
+  case UvEncoding::Half16:
+    return 4U;
+  case UvEncoding::None:
+  default:
+    return 0U;
+  }
+}
+
+math::Vec3 extent_of(const Aabb& bounds) {
+  return bounds.max - bounds.min;
+}
+
+} // namespace
+
+uint32_t position_stride(const VertexLayout& layout) {
+  return layout.position == PositionEncoding::Unorm16 ? 8U : 12U;
+}
+
+uint32_t attribute_stride(const VertexLayout& layout) {
+  return normal_bytes(layout.normal) + uv_bytes(layout.uv);
+}
+
+size_t compressed_memory_bytes(const CompressedMesh& mesh) {
+  return mesh.position_stream.size() + mesh.attribute_stream.size() + mesh.index_stream.size();
+}
+
+namespace {
+
+void compress_vertices(const MeshData& mesh, const VertexLayout& layout, CompressedMesh* out_mesh) {
+  CompressedMesh& out = *out_mesh;
+  out.layout = layout;
+  out.vertex_count = static_cast<uint32_t>(mesh.vertices.size());
+  out.bounds = mesh.bounds;
+
+  // Attributes the source mesh does not carry are dropped from the layout.
+  if (mesh.normals.size() != mesh.vertices.size()) {
+    out.layout.normal = NormalEncoding::None;
+  }
+  if (mesh.uvs.size() != mesh.vertices.size()) {
+    out.layout.uv = UvEncoding::None;
+  }
+
+  const math::Vec3 extent = extent_of(out.bounds);
+  const uint32_t pos_stride = position_stride(out.layout);
+  out.position_stream.resize(static_cast<size_t>(out.vertex_count) * pos_stride);
+  for (uint32_t i = 0; i < out.vertex_count; ++i) {
+    const math::Vec3& p = mesh.vertices[i].position;
+    const size_t base = static_cast<size_t>(i) * pos_stride;
+    if (out.layout.position == PositionEncoding::Unorm16) {
+      write_value(&out.position_stream, base + 0U, quantize_unorm16(p.x, out.bounds.min.x, extent.x));
+      write_value(&out.position_stream, base + 2U, quantize_unorm16(p.y, out.bounds.min.y, extent.y));
+      write_value(&out.position_stream, base + 4U, quantize_unorm16(p.z, out.bounds.min.z, extent.z));
+      write_value(&out.position_stream, base + 6U, static_cast<uint16_t>(0U));
+    } else {
+      write_value(&out.position_stream, base, p);
+    }
+  }
+
+  const uint32_t attr_stride = attribute_stride(out.layout);
+  out.attribute_stream.resize(static_cast<size_t>(out.vertex_count) * attr_stride);
+  for (uint32_t i = 0; i < out.vertex_count && attr_stride > 0U; ++i) {
+    size_t offset = static_cast<size_t>(i) * attr_stride;
+
+    switch (out.layout.normal) {
+    case NormalEncoding::Float32:
+      write_value(&out.attribute_stream, offset, mesh.normals[i]);
+      break;
+    case NormalEncoding::Octahedral8: {
+      const math::Vec2 oct = octahedral_encode(mesh.normals[i]);
+      write_value(&out.attribute_stream, offset + 0U, quantize_snorm<int8_t>(oct.x));
+      write_value(&out.attribute_stream, offset + 1U, quantize_snorm<int8_t>(oct.y));
+      break;
+    }
+    case NormalEncoding::Octahedral16: {
+      const math::Vec2 oct = octahedral_encode(mesh.normals[i]);
+      write_value(&out.attribute_stream, offset + 0U, quantize_snorm<int16_t>(oct.x));
+      write_value(&out.attribute_stream, offset + 2U, quantize_snorm<int16_t>(oct.y));
+      break;
+    }
+    case NormalEncoding::None:
+    default:
+      break;
+    }
+    offset += normal_bytes(out.layout.normal);
+
+    if (out.layout.uv == UvEncoding::Float32) {
+      write_value(&out.attribute_stream, offset, mesh.uvs[i]);
+    } else if (out.layout.uv == UvEncoding::Half16) {
+      write_value(&out.attribute_stream, offset + 0U, float_to_half(mesh.uvs[i].x));
+      write_value(&out.attribute_stream, offset + 2U, float_to_half(mesh.uvs[i].y));
+    }
+  }
+}
+
+} // namespace
+
+CompressedMesh compress_mesh(const MeshData& mesh, const VertexLayout& layout) {
+  CompressedMesh out{};
+  compress_vertices(mesh, layout, &out);
+  out.index_count = static_cast<uint32_t>(mesh.indices.size());
+
+  // 0xFFFF stays reserved as primitive restart on GPU backends.
+  out.index_format = (layout.allow_16bit_indices && out.vertex_count < 0xFFFFU) ? IndexFormat::Uint16
+                                                                                 : IndexFormat::Uint32;
+  if (out.index_format == IndexFormat::Uint16) {
+    out.index_stream.resize(static_cast<size_t>(out.index_count) * sizeof(uint16_t));
+    for (uint32_t i = 0; i < out.index_count; ++i) {
+      write_value(&out.index_stream, static_cast<size_t>(i) * sizeof(uint16_t), static_cast<uint16_t>(mesh.indices[i]));
+    }
+  } else {
+    out.index_stream.resize(static_cast<size_t>(out.index_count) * sizeof(uint32_t));
+    if (out.index_count > 0U) {
+      std::memcpy(out.index_stream.data(), mesh.indices.data(), out.index_stream.size());
+    }
+  }
+
+  return out;
+}
+
+void decode_positions(const CompressedMesh& mesh, std::vector<math::Vec3>* out_positions) {
+  if (out_positions == nullptr) {
+    return;
+  }
+
+  out_positions->resize(mesh.vertex_count);
+  const uint32_t stride = position_stride(mesh.layout);
+  if (mesh.layout.position == PositionEncoding::Float32) {
+    for (uint32_t i = 0; i < mesh.vertex_count; ++i) {
+      (*out_positions)[i] = read_value<math::Vec3>(mesh.position_stream, static_cast<size_t>(i) * stride);
+    }
+    return;
+  }
+
+  const math::Vec3 extent = extent_of(mesh.bounds);
+  for (uint32_t i = 0; i < mesh.vertex_count; ++i) {
+    const size_t base = static_cast<size_t>(i) * stride;
+    (*out_positions)[i] = {
+        dequantize_unorm16(read_value<uint16_t>(mesh.position_stream, base + 0U), mesh.bounds.min.x, extent.x),
+        dequantize_unorm16(read_value<uint16_t>(mesh.position_stream, base + 2U), mesh.bounds.min.y, extent.y),
+        dequantize_unorm16(read_value<uint16_t>(mesh.position_stream, base + 4U), mesh.bounds.min.z, extent.z),
+    };
+  }
+}
+
+void decode_normals(const CompressedMesh& mesh, std::vector<math::Vec3>* out_normals) {
+  if (out_normals == nullptr) {
+    return;
+  }
+
+  out_normals->clear();
+  if (mesh.layout.normal == NormalEncoding::None) {
+    return;
+  }
+
+  out_normals->resize(mesh.vertex_count);
+  const uint32_t stride = attribute_stride(mesh.layout);
+  for (uint32_t i = 0; i < mesh.vertex_count; ++i) {
+    const size_t base = static_cast<size_t>(i) * stride;
+    switch (mesh.layout.normal) {
+    case NormalEncoding::Float32:
+      (*out_normals)[i] = read_value<math::Vec3>(mesh.attribute_stream, base);
+      break;
+    case NormalEncoding::Octahedral8:
+      (*out_normals)[i] = octahedral_decode({dequantize_snorm(read_value<int8_t>(mesh.attribute_stream, base + 0U)),
+                                             dequantize_snorm(read_value<int8_t>(mesh.attribute_stream, base + 1U))});
+      break;
+    case NormalEncoding::Octahedral16:
+      (*out_normals)[i] = octahedral_decode({dequantize_snorm(read_value<int16_t>(mesh.attribute_stream, base + 0U)),
+                                             dequantize_snorm(read_value<int16_t>(mesh.attribute_stream, base + 2U))});
+      break;
+    case NormalEncoding::None:
+    default:
+      break;
+    }
+  }
+}
+
+void decode_uvs(const CompressedMesh& mesh, std::vector<math::Vec2>* out_uvs) {
+  if (out_uvs == nullptr) {
+    return;
+  }
+
+  out_uvs->clear();
+  if (mesh.layout.uv == UvEncoding::None) {
+    return;
+  }
+
+  out_uvs->resize(mesh.vertex_count);
+  const uint32_t stride = attribute_stride(mesh.layout);
+  const uint32_t offset = normal_bytes(mesh.layout.normal);
+  for (uint32_t i = 0; i < mesh.vertex_count; ++i) {
+    const size_t base = (static_cast<size_t>(i) * stride) + offset;
+    if (mesh.layout.uv == UvEncoding::Float32) {
+      (*out_uvs)[i] = read_value<math::Vec2>(mesh.attribute_stream, base);
+    } else {
+      (*out_uvs)[i] = {
+          half_to_float(read_value<uint16_t>(mesh.attribute_stream, base + 0U)),
+          half_to_float(read_value<uint16_t>(mesh.attribute_stream, base + 2U)),
+      };
+    }
+  }
+}
+
+uint32_t read_index(const CompressedMesh& mesh, const uint32_t i) {
+  if (mesh.index_format == IndexFormat::Uint16) {
+    return read_value<uint16_t>(mesh.index_stream, static_cast<size_t>(i) * sizeof(uint16_t));
+  }
+  return read_value<uint32_t>(mesh.index_stream, static_cast<size_t>(i) * sizeof(uint32_t));
+}
+
+MeshData decompress_mesh(const CompressedMesh& mesh) {
+  MeshData out{};
+  out.bounds = mesh.bounds;
+
+  std::vector<math::Vec3> positions;
+  decode_positions(mesh, &positions);
+  out.vertices.reserve(positions.size());
+  for (const math::Vec3& p : positions) {
+    out.vertices.push_back(Vertex{p});
+  }
+
+  decode_normals(mesh, &out.normals);
+  decode_uvs(mesh, &out.uvs);
+
+  out.indices.resize(mesh.index_count);
+  for (uint32_t i = 0; i < mesh.index_count; ++i) {
+    out.indices[i] = read_index(mesh, i);
+  }
+
+  return out;
+}
+
+void compress_vertex_streams(MeshData* mesh, const VertexLayout& layout) {
+  if (mesh->compressed != nullptr || mesh->vertices.empty()) {
+    return;
+  }
+
+  auto compressed = std::make_shared<CompressedMesh>();
+  compress_vertices(*mesh, layout, compressed.get());
+  mesh->compressed = std::move(compressed);
+  mesh->vertices = {};
+  mesh->normals = {};
+  mesh->uvs = {};
+}
+
+void decompress_vertex_streams(MeshData* mesh) {
+  if (mesh->compressed == nullptr) {
+    return;
+  }
+
+  const CompressedMesh& compressed = *mesh->compressed;
+  std::vector<math::Vec3> positions;
+  decode_positions(compressed, &positions);
+  mesh->vertices.clear();
+  mesh->vertices.reserve(positions.size());
+  for (const math::Vec3& p : positions) {
+    mesh->vertices.push_back(Vertex{p});
+  }
+  decode_normals(compressed, &mesh->normals);
+  decode_uvs(compressed, &mesh->uvs);
+  mesh->compressed = nullptr;
+}
+
+uint32_t mesh_vertex_count(const MeshData& mesh) {
+  return mesh.compressed != nullptr ? mesh.compressed->vertex_count : static_cast<uint32_t>(mesh.vertices.size());
+}
+
+const math::Vec3* mesh_positions(const MeshData& mesh, std::vector<math::Vec3>* scratch) {
+  if (mesh.compressed == nullptr) {
+    return mesh.vertices.empty() ? nullptr : &mesh.vertices[0].position;
+  }
+  decode_positions(*mesh.compressed, scratch);
+  return scratch->empty() ? nullptr : scratch->data();
+}
+
+uint16_t float_to_half(const float value) {
+  const uint32_t bits = std::bit_cast<uint32_t>(value);
+  const uint16_t sign = static_cast<uint16_t>((bits >> 16U) & 0x8000U);
+  const uint32_t abs_bits = bits & 0x7FFFFFFFU;
+
+  if (abs_bits > 0x7F800000U) {
+    return static_cast<uint16_t>(sign | 0x7E00U);
+  }
+
+  const int exponent = static_cast<int>((abs_bits >> 23U) & 0xFFU) - 127 + 15;
+  uint32_t mantissa = abs_bits & 0x7FFFFFU;
+
+  if (exponent >= 31) {
+    return static_cast<uint16_t>(sign | 0x7C00U);
+  }
+
+  if (exponent <= 0) {
+    if (exponent < -10) {
+      return sign;
+    }
+    mantissa |= 0x800000U;
+    const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+    uint32_t half_mantissa = mantissa >> shift;
+    if (((mantissa >> (shift - 1U)) & 1U) != 0U) {
+      half_mantissa += 1U;
+    }
+    return static_cast<uint16_t>(sign | half_mantissa);
+  }
+
+  uint32_t half = (static_cast<uint32_t>(exponent) << 10U) | (mantissa >> 13U);
+  if ((mantissa & 0x1000U) != 0U) {
+    half += 1U; // carry into the exponent is the correct rounding result
+  }
+  return static_cast<uint16_t>(sign | half);
+}
+
+float half_to_float(const uint16_t value) {
+  const uint32_t sign = static_cast<uint32_t>(value & 0x8000U) << 16U;
+  uint32_t exponent = (value >> 10U) & 0x1FU;
+  uint32_t mantissa = value & 0x3FFU;
+
+  if (exponent == 0U) {
+    if (mantissa == 0U) {
+      return std::bit_cast<float>(sign);
+    }
+
+    uint32_t shift = 0U;
+    while ((mantissa & 0x400U) == 0U) {
+      mantissa <<= 1U;
+      ++shift;
+    }
+    mantissa &= 0x3FFU;
+    exponent = 127U - 15U + 1U - shift;
+    return std::bit_cast<float>(sign | (exponent << 23U) | (mantissa << 13U));
+  }
+
+  if (exponent == 31U) {
+    return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13U));
+  }
+
+  return std::bit_cast<float>(sign | ((exponent + 112U) << 23U) | (mantissa << 13U));
+}
+
+QuantizationReport measure_quantization(const MeshData& mesh, const VertexLayout& layout, const uint32_t decode_iterations) {
+  QuantizationReport report{};
+  report.source_bytes = mesh_memory_bytes(mesh);
+
+  const CompressedMesh compressed = compress_mesh(mesh, layout);
+  report.compressed_bytes = compressed_memory_bytes(compressed);
+
+  const MeshData decoded = decompress_mesh(compressed);
+
+  double position_error_sum = 0.0;
+  for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+    const float error = math::length(decoded.vertices[i].position - mesh.vertices[i].position);
+    report.max_position_error = std::max(report.max_position_error, error);
+    position_error_sum += static_cast<double>(error);
+  }
+  if (!mesh.vertices.empty()) {
+    report.mean_position_error = static_cast<float>(position_error_sum / static_cast<double>(mesh.vertices.size()));
+  }
+
+  for (size_t i = 0; i < decoded.normals.size(); ++i) {
+    const float cos_angle = std::clamp(math::dot(math::normalize(mesh.normals[i]), decoded.normals[i]), -1.0F, 1.0F);
+    const float degrees = std::acos(cos_angle) * (180.0F / 3.14159265359F);
+    report.max_normal_error_degrees = std::max(report.max_normal_error_degrees, degrees);
+  }
+
+  for (size_t i = 0; i < decoded.uvs.size(); ++i) {
+    report.max_uv_error = std::max(report.max_uv_error, std::fabs(decoded.uvs[i].x - mesh.uvs[i].x));
+    report.max_uv_error = std::max(report.max_uv_error, std::fabs(decoded.uvs[i].y - mesh.uvs[i].y));
+  }
+
+  if (decode_iterations == 0U || compressed.vertex_count == 0U) {
+    return report;
+  }
+
+  std::vector<math::Vec3> positions;
+  std::vector<math::Vec3> normals;
+  std::vector<math::Vec2> uvs;
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < decode_iterations; ++i) {
+    decode_positions(compressed, &positions);
+    decode_normals(compressed, &normals);
+    decode_uvs(compressed, &uvs);
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  const double total_ns = std::chrono::duration<double, std::nano>(end - start).count();
+  report.decode_ns_per_vertex = total_ns / (static_cast<double>(decode_iterations) * static_cast<double>(compressed.vertex_count));
+  return report;
+}
+
+} // namespace engine::assets
@@ -0,0 +1,376 @@
+#include "engine/core/allocators.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <memory>
+
+namespace engine::core {
+
+namespace {
+
+constexpr size_t align_up(const size_t value, const size_t alignment) {
+  return (value + alignment - 1U) & ~(alignment - 1U);
+}
+
+void note_used(AllocatorStats* stats, const size_t bytes) {
+  stats->used_bytes += bytes;
+  stats->peak_used_bytes = std::max(stats->peak_used_bytes, stats->used_bytes);
+  stats->live_allocations += 1;
+}
+
+} // namespace
+
+double AllocatorStats::fragmentation() const {
+  if (free_bytes == 0U) {
+    return 0.0;
+  }
+  return 1.0 - (static_cast<double>(largest_free_bytes) / static_cast<double>(free_bytes));
+}
+
+// --- TrackedResource ---
+
+TrackedResource::TrackedResource(const MemoryTag tag,
+                                 std::pmr::memory_resource* upstream,
+                                 MemoryTracker* tracker)
+    : tag_(tag),
+      upstream_(upstream),
+      tracker_(tracker) {}
+
+MemoryTag TrackedResource::tag() const {
+  return tag_;
+}
+
+void* TrackedResource::do_allocate(const size_t bytes, const size_t alignment) {
+  void* pointer = upstream_->allocate(bytes, alignment);
+  tracker_->record_allocation(tag_, bytes);
+  return pointer;
+}
+
+void TrackedResource::do_deallocate(void* pointer, const size_t bytes, const size_t alignment) {
+  upstream_->deallocate(pointer, bytes, alignment);
+  tracker_->record_deallocation(tag_, bytes);
+}
+
+bool TrackedResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+// --- PoolResource ---
+
+PoolResource::PoolResource(const size_t block_size,
+                           const size_t blocks_per_chunk,
+                           std::pmr::memory_resource* upstream)
+    : block_size_(align_up(std::max(block_size, sizeof(FreeBlock)), alignof(std::max_align_t))),
+      blocks_per_chunk_(std::max<size_t>(blocks_per_chunk, 1U)),
+      upstream_(upstream) {}
+
+PoolResource::~PoolResource() {
+  for (void* chunk : chunks_) {
+    upstream_->deallocate(chunk, block_size_ * blocks_per_chunk_, alignof(std::max_align_t));
+  }
+}
+
+size_t PoolResource::block_size() const {
+  return block_size_;
+}
+
+AllocatorStats PoolResource::stats() const {
+  AllocatorStats stats = stats_;
+  stats.free_bytes = stats.capacity_bytes - stats.used_bytes;
+  stats.largest_free_bytes = stats.free_bytes > 0U ? block_size_ : 0U;
+  return stats;
+}
+
+void* PoolResource::do_allocate(const size_t bytes, const size_t alignment) {
+  if (bytes > block_size_ || alignment > alignof(std::max_align_t)) {
+    stats_.fallback_allocations += 1;
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  if (free_list_ == nullptr) {
+    add_chunk();
+  }
+  FreeBlock* block = free_list_;
+  free_list_ = block->next;
+  note_used(&stats_, block_size_);
+  return block;
+}
+
+void PoolResource::do_deallocate(void* pointer, const size_t bytes, const size_t alignment) {
+  if (bytes > block_size_ || alignment > alignof(std::max_align_t)) {
+    upstream_->deallocate(pointer, bytes, alignment);
+    return;
+  }
+
+  auto* block = static_cast<FreeBlock*>(pointer);
+  block->next = free_list_;
+  free_list_ = block;
+  stats_.used_bytes -= block_size_;
+  stats_.live_allocations -= 1;
+}
+
+bool PoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+void PoolResource::add_chunk() {
+  auto* chunk = static_cast<std::byte*>(upstream_->allocate(block_size_ * blocks_per_chunk_, alignof(std::max_align_t)));
+  chunks_.push_back(chunk);
+  stats_.capacity_bytes += block_size_ * blocks_per_chunk_;
+
+  // Thread back to front so blocks are handed out in address order.
+  for (size_t i = blocks_per_chunk_; i > 0U; --i) {
+    auto* block = reinterpret_cast<FreeBlock*>(chunk + ((i - 1U) * block_size_));
+    block->next = free_list_;
+    free_list_ = block;
+  }
+}
+
+// --- ArenaResource ---
+
+ArenaResource::ArenaResource(const size_t chunk_size, std::pmr::memory_resource* upstream)
+    : chunk_size_(std::max<size_t>(chunk_size, 256U)),
+      upstream_(upstream) {}
+
+ArenaResource::~ArenaResource() {
+  release_chunks(0U);
+}
+
+void ArenaResource::reset() {
+  release_chunks(1U);
+  offset_ = 0;
+  stats_.used_bytes = 0;
+  stats_.overhead_bytes = 0;
+  stats_.live_allocations = 0;
+}
+
+AllocatorStats ArenaResource::stats() const {
+  AllocatorStats stats = stats_;
+  stats.free_bytes = chunks_.empty() ? 0U : chunks_.back().size - offset_;
+  stats.largest_free_bytes = stats.free_bytes;
+  return stats;
+}
+
+void* ArenaResource::do_allocate(const size_t bytes, const size_t alignment) {
+  if (!chunks_.empty()) {
+    const Chunk& chunk = chunks_.back();
+    const auto address = reinterpret_cast<uintptr_t>(chunk.data + offset_);
+    const size_t padding = align_up(address, alignment) - address;
+    if (offset_ + padding + bytes <= chunk.size) {
+      void* pointer = chunk.data + offset_ + padding;
+      offset_ += padding + bytes;
+      note_used(&stats_, padding + bytes);
+      return pointer;
+    }
+  }
+
+  if (!chunks_.empty()) {
+    stats_.overhead_bytes += chunks_.back().size - offset_;
+  }
+  const size_t size = std::max(chunk_size_, bytes + alignment);
+  chunks_.push_back({static_cast<std::byte*>(upstream_->allocate(size, alignof(std::max_align_t))), size});
+  stats_.capacity_bytes += size;
+
+  const auto address = reinterpret_cast<uintptr_t>(chunks_.back().data);
+  const size_t padding = align_up(address, alignment) - address;
+  offset_ = padding + bytes;
+  note_used(&stats_, padding + bytes);
+  return chunks_.back().data + padding;
+}
+
+void ArenaResource::do_deallocate(void* /*pointer*/, const size_t /*bytes*/, const size_t /*alignment*/) {}
+
+bool ArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+void ArenaResource::release_chunks(const size_t keep) {
+  while (chunks_.size() > keep) {
+    upstream_->deallocate(chunks_.back().data, chunks_.back().size, alignof(std::max_align_t));
+    stats_.capacity_bytes -= chunks_.back().size;
+    chunks_.pop_back();
+  }
+}
+
+// --- TlsfResource ---
+
+static_assert(sizeof(void*) == 8U, "TlsfResource block headers assume 64-bit pointers");
+
+TlsfResource::TlsfResource(const size_t capacity_bytes, std::pmr::memory_resource* upstream) : upstream_(upstream) {
+  // One free block spanning the region, then a zero-size used sentinel so every
+  // block has a physical successor.
+  region_size_ = align_up(std::max(capacity_bytes, small_block_size), block_alignment) + (2U * header_size);
+  region_ = static_cast<std::byte*>(upstream_->allocate(region_size_, block_alignment));
+  stats_.capacity_bytes = region_size_;
+
+  auto* block = reinterpret_cast<Block*>(region_);
+  block->prev_physical = nullptr;
+  block->size = region_size_ - (2U * header_size);
+  Block* sentinel = next_physical(block);
+  sentinel->prev_physical = block;
+  sentinel->size = 0;
+  insert_free(block);
+}
+
+TlsfResource::~TlsfResource() {
+  upstream_->deallocate(region_, region_size_, block_alignment);
+}
+
+AllocatorStats TlsfResource::stats() const {
+  AllocatorStats stats = stats_;
+  stats.free_bytes = 0;
+  stats.largest_free_bytes = 0;
+  stats.overhead_bytes = header_size; // the sentinel
+  for (const Block* block = reinterpret_cast<const Block*>(region_); block_size(block) != 0U;
+       block = next_physical(block)) {
+    stats.overhead_bytes += header_size;
+    if (is_free(block)) {
+      stats.free_bytes += block_size(block);
+      stats.largest_free_bytes = std::max(stats.largest_free_bytes, block_size(block));
+    }
+  }
+  return stats;
+}
+
+void* TlsfResource::do_allocate(const size_t bytes, const size_t alignment) {
+  const size_t size = align_up(std::max(bytes, min_block_size), block_alignment);
+  Block* block = alignment <= block_alignment && size < region_size_ ? find_free(size) : nullptr;
+  if (block == nullptr) {
+    stats_.fallback_allocations += 1;
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  remove_free(block);
+  if (block_size(block) >= size + header_size + min_block_size) {
+    auto* remainder = reinterpret_cast<Block*>(reinterpret_cast<std::byte*>(block) + header_size + size);
+    remainder->prev_physical = block;
+    remainder->size = block_size(block) - size - header_size;
+    next_physical(remainder)->prev_physical = remainder;
+    block->size = size;
+    insert_free(remainder);
+  }
+
+  note_used(&stats_, block->size);
+  return reinterpret_cast<std::byte*>(block) + header_size;
+}
+
+void TlsfResource::do_deallocate(void* pointer, const size_t bytes, const size_t alignment) {
+  if (!owns(pointer)) {
+    upstream_->deallocate(pointer, bytes, alignment);
+    return;
+  }
+
+  auto* block = reinterpret_cast<Block*>(static_cast<std::byte*>(pointer) - header_size);
+  stats_.used_bytes -= block->size;
+  stats_.live_allocations -= 1;
+
+  if (Block* previous = block->prev_physical; previous != nullptr && is_free(previous)) {
+    remove_free(previous);
+    previous->size = block_size(previous) + header_size + block->size;
+    block = previous;
+    next_physical(block)->prev_physical = block;
+  }
+  if (Block* next = next_physical(block); is_free(next)) {
+    remove_free(next);
+    block->size = block_size(block) + header_size + block_size(next);
+    next_physical(block)->prev_physical = block;
+  }
+  insert_free(block);
+}
+
+bool TlsfResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+size_t TlsfResource::block_size(const Block* block) {
+  return block->size & ~size_t{1};
+}
+
+bool TlsfResource::is_free(const Block* block) {
+  return (block->size & 1U) != 0U;
+}
+
+TlsfResource::Block* TlsfResource::next_physical(const Block* block) {
+  return reinterpret_cast<Block*>(reinterpret_cast<std::byte*>(const_cast<Block*>(block)) + header_size +
+                                  block_size(block));
+}
+
+void TlsfResource::mapping(const size_t size, uint32_t* out_first, uint32_t* out_second) {
+  if (size < small_block_size) {
+    *out_first = 0;
+    *out_second = static_cast<uint32_t>(size / (small_block_size / second_level_count));
+    return;
+  }
+  const auto log2 = static_cast<uint32_t>(std::bit_width(size) - 1U);
+  *out_second = static_cast<uint32_t>(size >> (log2 - second_level_log2)) ^ second_level_count;
+  *out_first = log2 - (first_level_shift - 1U);
+}
+
+TlsfResource::Block* TlsfResource::find_free(size_t size) {
+  // Round up to the next list boundary so any block found is large enough.
+  if (size >= small_block_size) {
+    size += (size_t{1} << (std::bit_width(size) - 1U - second_level_log2)) - 1U;
+  }
+  uint32_t first = 0;
+  uint32_t second = 0;
+  mapping(size, &first, &second);
+  if (first >= first_level_count) {
+    return nullptr;
+  }
+
+  uint32_t second_map = second_level_bitmap_[first] & (~0U << second);
+  if (second_map == 0U) {
+    const uint64_t first_map = first + 1U < 64U ? first_level_bitmap_ & (~uint64_t{0} << (first + 1U)) : 0U;
+    if (first_map == 0U) {
+      return nullptr;
+    }
+    first = static_cast<uint32_t>(std::countr_zero(first_map));
+    second_map = second_level_bitmap_[first];
+  }
+  second = static_cast<uint32_t>(std::countr_zero(second_map));
+  return free_heads_[first][second];
+}
+
+void TlsfResource::insert_free(Block* block) {
+  uint32_t first = 0;
+  uint32_t second = 0;
+  mapping(block_size(block), &first, &second);
+  block->size = block_size(block) | 1U;
+  block->prev_free = nullptr;
+  block->next_free = free_heads_[first][second];
+  if (block->next_free != nullptr) {
+    block->next_free->prev_free = block;
+  }
+  free_heads_[first][second] = block;
+  first_level_bitmap_ |= uint64_t{1} << first;
+  second_level_bitmap_[first] |= 1U << second;
+}
+
+void TlsfResource::remove_free(Block* block) {
+  uint32_t first = 0;
+  uint32_t second = 0;
+  mapping(block_size(block), &first, &second);
+  if (block->prev_free != nullptr) {
+    block->prev_free->next_free = block->next_free;
+  } else {
+    free_heads_[first][second] = block->next_free;
+  }
+  if (block->next_free != nullptr) {
+    block->next_free->prev_free = block->prev_free;
+  }
+  if (free_heads_[first][second] == nullptr) {
+    second_level_bitmap_[first] &= ~(1U << second);
+    if (second_level_bitmap_[first] == 0U) {
+      first_level_bitmap_ &= ~(uint64_t{1} << first);
+    }
+  }
+  block->size = block_size(block);
+}
+
+bool TlsfResource::owns(const void* pointer) const {
+  const auto* bytes = static_cast<const std::byte*>(pointer);
+  return bytes >= region_ && bytes < region_ + region_size_;
+}
+
+} // namespace engine::core
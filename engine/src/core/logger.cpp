@@ -1,9 +1,13 @@
 #include "engine/core/logger.h"
 
+#include "engine/core/memory_tracker.h"
+
 #include <chrono>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <memory_resource>
 #include <sstream>
 #include <thread>
 
@@ -34,11 +38,8 @@ void Logger::log(LogLevel level, std::string_view message) {
   const std::string tid_text = tid_stream.str();
 
 #ifdef ENGINE_HAS_FMT
-  const std::string line = fmt::format("[{}][{}][tid={}] {}",
-                                       timestamp_now(),
-                                       level_text(level),
-                                       tid_text,
-                                       message);
+  std::pmr::string line(tagged_resource(MemoryTag::Logging));
+  fmt::format_to(std::back_inserter(line), "[{}][{}][tid={}] {}", timestamp_now(), level_text(level), tid_text, message);
 #else
   std::ostringstream line;
   line << '[' << timestamp_now() << ']'
@@ -0,0 +1,87 @@
+#include "engine/core/memory_tracker.h"
+
+#include "engine/core/allocators.h"
+
+namespace engine::core {
+
+const char* memory_tag_name(const MemoryTag tag) {
+  switch (tag) {
+  case MemoryTag::Scene:
+    return "scene";
+  case MemoryTag::Assets:
+    return "assets";
+  case MemoryTag::Renderer:
+    return "renderer";
+  case MemoryTag::Logging:
+    return "logging";
+  default:
+    return "unknown";
+  }
+}
+
+void MemoryTracker::record_allocation(const MemoryTag tag, const size_t bytes) {
+  Counters& counters = counters_[static_cast<size_t>(tag)];
+  const size_t now = counters.current_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  counters.live_allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.total_allocations.fetch_add(1, std::memory_order_relaxed);
+
+  size_t peak = counters.peak_bytes.load(std::memory_order_relaxed);
+  while (now > peak && !counters.peak_bytes.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+  }
+
+  // Count crossings rather than every allocation made while over budget.
+  const size_t budget = counters.budget_bytes.load(std::memory_order_relaxed);
+  if (budget > 0U && now > budget && now - bytes <= budget) {
+    counters.budget_overruns.fetch_add(1, std::memory_order_relaxed);
+    budget_exceeded_.fetch_or(1U << static_cast<uint32_t>(tag), std::memory_order_relaxed);
+  }
+}
+
+void MemoryTracker::record_deallocation(const MemoryTag tag, const size_t bytes) {
+  Counters& counters = counters_[static_cast<size_t>(tag)];
+  counters.current_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+  counters.live_allocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::set_budget(const MemoryTag tag, const size_t budget_bytes) {
+  Counters& counters = counters_[static_cast<size_t>(tag)];
+  counters.budget_bytes.store(budget_bytes, std::memory_order_relaxed);
+  if (budget_bytes > 0U && counters.current_bytes.load(std::memory_order_relaxed) > budget_bytes) {
+    counters.budget_overruns.fetch_add(1, std::memory_order_relaxed);
+    budget_exceeded_.fetch_or(1U << static_cast<uint32_t>(tag), std::memory_order_relaxed);
+  }
+}
+
+MemoryTagStats MemoryTracker::stats(const MemoryTag tag) const {
+  const Counters& counters = counters_[static_cast<size_t>(tag)];
+  MemoryTagStats stats;
+  stats.current_bytes = counters.current_bytes.load(std::memory_order_relaxed);
+  stats.peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed);
+  stats.budget_bytes = counters.budget_bytes.load(std::memory_order_relaxed);
+  stats.live_allocations = counters.live_allocations.load(std::memory_order_relaxed);
+  stats.total_allocations = counters.total_allocations.load(std::memory_order_relaxed);
+  stats.budget_overruns = counters.budget_overruns.load(std::memory_order_relaxed);
+  return stats;
+}
+
+uint32_t MemoryTracker::take_budget_exceeded() {
+  return budget_exceeded_.exchange(0U, std::memory_order_relaxed);
+}
+
+// Both are leaked on purpose: containers in other statics may free into them during shutdown.
+MemoryTracker& memory_tracker() {
+  static MemoryTracker* tracker = new MemoryTracker();
+  return *tracker;
+}
+
+std::pmr::memory_resource* tagged_resource(const MemoryTag tag) {
+  static auto* resources = new std::array<TrackedResource, memory_tag_count>{
+      TrackedResource(MemoryTag::Scene),
+      TrackedResource(MemoryTag::Assets),
+      TrackedResource(MemoryTag::Renderer),
+      TrackedResource(MemoryTag::Logging),
+  };
+  return &(*resources)[static_cast<size_t>(tag)];
+}
+
+} // namespace engine::core
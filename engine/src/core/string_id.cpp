@@ -0,0 +1,99 @@
+#include "engine/core/string_id.h"
+
+#include "engine/core/logger.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace engine::core {
+
+namespace {
+
+struct StringTable {
+  std::shared_mutex mutex;
+  std::unordered_map<StringId, std::string, StringIdHash> strings; // node based, so text never moves
+  size_t bytes = 0;
+  uint64_t collisions = 0;
+  std::atomic<Logger*> logger{nullptr};
+};
+
+StringTable& string_table() {
+  static StringTable* table = new StringTable(); // leaked on purpose: ids may be resolved during static destruction
+  return *table;
+}
+
+// Called without the table lock held; interned text never moves, so existing stays valid.
+void report_collision(StringTable& table,
+                      const StringId id,
+                      const std::string_view existing,
+                      const std::string_view text) {
+  {
+    std::unique_lock<std::shared_mutex> lock(table.mutex);
+    table.collisions += 1;
+  }
+  if (Logger* logger = table.logger.load(std::memory_order_acquire); logger != nullptr) {
+    char hash[19];
+    std::snprintf(hash, sizeof(hash), "0x%016llx", static_cast<unsigned long long>(id.value()));
+    logger->error("String id collision: '" + std::string(text) + "' hashes to " + hash + ", already taken by '" +
+                  std::string(existing) + "'; its id resolves to the other string");
+  }
+}
+
+} // namespace
+
+StringId intern(const std::string_view text) {
+  const StringId id(text);
+  StringTable& table = string_table();
+
+  std::string_view existing;
+  bool found = false;
+  {
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+    if (const auto it = table.strings.find(id); it != table.strings.end()) {
+      existing = it->second;
+      found = true;
+    }
+  }
+  if (!found) {
+    std::unique_lock<std::shared_mutex> lock(table.mutex);
+    const auto [it, inserted] = table.strings.try_emplace(id, text);
+    if (inserted) {
+      table.bytes += text.size();
+      return id;
+    }
+    existing = it->second;
+  }
+
+  if (existing != text) {
+    report_collision(table, id, existing, text);
+  }
+  return id;
+}
+
+std::string_view string_id_text(const StringId id) {
+  StringTable& table = string_table();
+  std::shared_lock<std::shared_mutex> lock(table.mutex);
+  const auto it = table.strings.find(id);
+  return it != table.strings.end() ? std::string_view(it->second) : std::string_view();
+}
+
+void set_string_table_logger(Logger* logger) {
+  string_table().logger.store(logger, std::memory_order_release);
+}
+
+StringTableStats string_table_stats() {
+  StringTable& table = string_table();
+  std::shared_lock<std::shared_mutex> lock(table.mutex);
+
+  StringTableStats out{};
+  out.strings = static_cast<uint32_t>(table.strings.size());
+  out.bytes = table.bytes;
+  out.collisions = table.collisions;
+  return out;
+}
+
+} // namespace engine::core
@@ -0,0 +1,75 @@
+#include "engine/core/thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace engine::core {
+
+ThreadPool::ThreadPool(uint32_t thread_count) {
+  if (thread_count == 0U) {
+    const uint32_t hardware = std::thread::hardware_concurrency();
+    thread_count = std::max(1U, hardware > 1U ? hardware - 1U : 1U);
+  }
+
+  workers_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    workers_.emplace_back(&ThreadPool::worker_main, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  job_ready_.notify_all();
+
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::submit(std::function<void()> job) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    jobs_.push_back(std::move(job));
+  }
+  job_ready_.notify_one();
+}
+
+void ThreadPool::wait_idle() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return jobs_.empty() && active_jobs_ == 0U; });
+}
+
+uint32_t ThreadPool::thread_count() const {
+  return static_cast<uint32_t>(workers_.size());
+}
+
+void ThreadPool::worker_main() {
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_ready_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+      if (jobs_.empty()) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+      active_jobs_ += 1;
+    }
+
+    job();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      active_jobs_ -= 1;
+      if (jobs_.empty() && active_jobs_ == 0U) {
+        idle_.notify_all();
+      }
+    }
+  }
+}
+
+} // namespace engine::core
@@ -0,0 +1,42 @@
+#include "engine/input/input_event.h"
+
+#include <bit>
+#include <chrono>
+
+namespace engine::input {
+
+uint64_t event_clock_ns() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+InputEventRing::InputEventRing(const size_t capacity)
+    : events_(std::bit_ceil(capacity < 2U ? size_t{2} : capacity)),
+      mask_(events_.size() - 1U) {}
+
+bool InputEventRing::push(const InputEvent& event) {
+  const size_t head = head_.load(std::memory_order_relaxed);
+  if (head - tail_.load(std::memory_order_acquire) == events_.size()) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  events_[head & mask_] = event;
+  head_.store(head + 1U, std::memory_order_release);
+  return true;
+}
+
+bool InputEventRing::pop(InputEvent* out_event) {
+  const size_t tail = tail_.load(std::memory_order_relaxed);
+  if (tail == head_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  *out_event = events_[tail & mask_];
+  tail_.store(tail + 1U, std::memory_order_release);
+  return true;
+}
+
+uint64_t InputEventRing::dropped() const {
+  return dropped_.load(std::memory_order_relaxed);
+}
+
+} // namespace engine::input
@@ -0,0 +1,53 @@
+#include "engine/input/input_latency.h"
+
+#include <algorithm>
+
+namespace engine::input {
+
+void InputLatencyTracker::record_consumed(const uint64_t event_ns, const uint64_t consumed_ns) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  consumed_.add(event_ns, consumed_ns);
+}
+
+void InputLatencyTracker::record_presented(const uint64_t event_ns, const uint64_t presented_ns) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  presented_.add(event_ns, presented_ns);
+}
+
+LatencySummary InputLatencyTracker::consume_latency() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return consumed_.summarize();
+}
+
+LatencySummary InputLatencyTracker::present_latency() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return presented_.summarize();
+}
+
+void InputLatencyTracker::Window::add(const uint64_t from_ns, const uint64_t to_ns) {
+  const uint64_t delta_ns = to_ns > from_ns ? to_ns - from_ns : 0U;
+  samples_ms[next] = static_cast<float>(static_cast<double>(delta_ns) / 1.0e6);
+  next = (next + 1U) % window_size;
+  count = std::min(count + 1U, window_size);
+}
+
+LatencySummary InputLatencyTracker::Window::summarize() const {
+  LatencySummary summary;
+  summary.samples = count;
+  if (count == 0U) {
+    return summary;
+  }
+
+  std::array<float, window_size> sorted = samples_ms;
+  std::sort(sorted.begin(), sorted.begin() + count);
+  double total = 0.0;
+  for (uint32_t i = 0; i < count; ++i) {
+    total += sorted[i];
+  }
+  summary.avg_ms = total / count;
+  summary.p95_ms = sorted[std::min(count - 1U, (count * 95U) / 100U)];
+  summary.max_ms = sorted[count - 1U];
+  return summary;
+}
+
+} // namespace engine::input
@@ -0,0 +1,216 @@
+#include "engine/input/input_recording.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+namespace engine::input {
+
+namespace {
+
+void set_error(std::string* out_error, const std::string& message) {
+  if (out_error != nullptr) {
+    *out_error = message;
+  }
+}
+
+// Smallest encodings, used to bound the header counts before reserving.
+constexpr size_t min_frame_bytes = sizeof(double) + sizeof(uint32_t);
+constexpr size_t min_event_bytes = 2U;
+
+// The format is little endian; values are byte-swapped on big-endian hosts.
+template <typename T>
+T little_endian(const T value) {
+  static_assert(std::is_arithmetic_v<T>);
+  if constexpr (std::endian::native == std::endian::big) {
+    auto bytes = std::bit_cast<std::array<uint8_t, sizeof(T)>>(value);
+    std::reverse(bytes.begin(), bytes.end());
+    return std::bit_cast<T>(bytes);
+  } else {
+    return value;
+  }
+}
+
+template <typename T>
+void append_value(std::vector<uint8_t>* bytes, const T& value) {
+  const T stored = little_endian(value);
+  const size_t offset = bytes->size();
+  bytes->resize(offset + sizeof(T));
+  std::memcpy(bytes->data() + offset, &stored, sizeof(T));
+}
+
+class ByteReader {
+public:
+  explicit ByteReader(const std::vector<uint8_t>& bytes) : bytes_(bytes) {}
+
+  template <typename T>
+  bool read(T* out_value) {
+    if (bytes_.size() - offset_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(out_value, bytes_.data() + offset_, sizeof(T));
+    *out_value = little_endian(*out_value);
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  size_t remaining() const {
+    return bytes_.size() - offset_;
+  }
+
+  bool at_end() const {
+    return offset_ == bytes_.size();
+  }
+
+private:
+  const std::vector<uint8_t>& bytes_;
+  size_t offset_ = 0;
+};
+
+} // namespace
+
+void InputRecording::clear() {
+  frames_.clear();
+  events_.clear();
+}
+
+void InputRecording::add_frame(const double delta_seconds, const std::span<const InputEvent> events) {
+  RecordedFrame frame;
+  frame.delta_seconds = delta_seconds;
+  frame.first_event = static_cast<uint32_t>(events_.size());
+  frame.event_count = static_cast<uint32_t>(events.size());
+  frames_.push_back(frame);
+  events_.insert(events_.end(), events.begin(), events.end());
+}
+
+size_t InputRecording::frame_count() const {
+  return frames_.size();
+}
+
+const RecordedFrame& InputRecording::frame(const size_t index) const {
+  return frames_[index];
+}
+
+std::span<const InputEvent> InputRecording::events(const RecordedFrame& frame) const {
+  return {events_.data() + frame.first_event, frame.event_count};
+}
+
+double InputRecording::duration_seconds() const {
+  double total = 0.0;
+  for (const RecordedFrame& frame : frames_) {
+    total += frame.delta_seconds;
+  }
+  return total;
+}
+
+bool InputRecording::save(const std::string& path, std::string* out_error) const {
+  std::vector<uint8_t> bytes;
+  bytes.reserve(sizeof(InputRecordingHeader) + (frames_.size() * 12U) + (events_.size() * 10U));
+
+  append_value(&bytes, input_recording_magic);
+  append_value(&bytes, input_recording_version);
+  append_value(&bytes, static_cast<uint32_t>(frames_.size()));
+  append_value(&bytes, static_cast<uint32_t>(events_.size()));
+
+  for (const RecordedFrame& frame : frames_) {
+    append_value(&bytes, frame.delta_seconds);
+    append_value(&bytes, frame.event_count);
+    for (const InputEvent& event : events(frame)) {
+      append_value(&bytes, static_cast<uint8_t>(event.type));
+      append_value(&bytes, static_cast<uint8_t>(event.key));
+      if (event.type == InputEventType::MouseMove) {
+        append_value(&bytes, event.x);
+        append_value(&bytes, event.y);
+      } else if (event.type == InputEventType::Scroll) {
+        append_value(&bytes, event.y);
+      }
+    }
+  }
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    set_error(out_error, "Failed to create input recording: " + path);
+    return false;
+  }
+  out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  if (!out.good()) {
+    set_error(out_error, "Failed to write input recording: " + path);
+    return false;
+  }
+  return true;
+}
+
+bool InputRecording::load(const std::string& path, std::string* out_error) {
+  clear();
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    set_error(out_error, "Failed to open input recording: " + path);
+    return false;
+  }
+  const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  ByteReader reader(bytes);
+  InputRecordingHeader header;
+  if (!reader.read(&header.magic) || !reader.read(&header.version) || !reader.read(&header.frame_count) ||
+      !reader.read(&header.event_count) || header.magic != input_recording_magic ||
+      header.version != input_recording_version) {
+    set_error(out_error, "Not an input recording: " + path);
+    return false;
+  }
+
+  // Counts come from the file; reject any the remaining bytes cannot hold before reserving.
+  const uint64_t frame_bytes = static_cast<uint64_t>(header.frame_count) * min_frame_bytes;
+  if (frame_bytes > reader.remaining() ||
+      static_cast<uint64_t>(header.event_count) * min_event_bytes > reader.remaining() - frame_bytes) {
+    set_error(out_error, "Truncated input recording: " + path);
+    return false;
+  }
+
+  frames_.reserve(header.frame_count);
+  events_.reserve(header.event_count);
+  for (uint32_t f = 0; f < header.frame_count; ++f) {
+    RecordedFrame frame;
+    frame.first_event = static_cast<uint32_t>(events_.size());
+    if (!reader.read(&frame.delta_seconds) || !reader.read(&frame.event_count)) {
+      clear();
+      set_error(out_error, "Truncated input recording: " + path);
+      return false;
+    }
+
+    for (uint32_t e = 0; e < frame.event_count; ++e) {
+      uint8_t type = 0;
+      uint8_t key = 0;
+      InputEvent event;
+      bool ok = reader.read(&type) && reader.read(&key) && type <= static_cast<uint8_t>(InputEventType::Scroll) &&
+                key < static_cast<uint8_t>(Key::Count);
+      event.type = static_cast<InputEventType>(type);
+      event.key = static_cast<Key>(key);
+      if (ok && event.type == InputEventType::MouseMove) {
+        ok = reader.read(&event.x) && reader.read(&event.y);
+      } else if (ok && event.type == InputEventType::Scroll) {
+        ok = reader.read(&event.y);
+      }
+      if (!ok) {
+        clear();
+        set_error(out_error, "Corrupt input recording: " + path);
+        return false;
+      }
+      events_.push_back(event);
+    }
+    frames_.push_back(frame);
+  }
+
+  if (events_.size() != header.event_count || !reader.at_end()) {
+    clear();
+    set_error(out_error, "Corrupt input recording: " + path);
+    return false;
+  }
+  return true;
+}
+
+} // namespace engine::input
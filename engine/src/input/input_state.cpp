@@ -1,34 +1,38 @@
 #include "engine/input/input_state.h"
 
+#include "engine/input/input_event.h"
+
 namespace engine::input {
 
 void InputState::begin_frame() {
-  pressed_.clear();
-  released_.clear();
+  pressed_.reset();
+  released_.reset();
   mouse_delta_ = {};
   scroll_delta_ = 0.0F;
 }
 
 void InputState::on_key_down(Key key) {
-  if (key == Key::Unknown) {
+  if (key == Key::Unknown || key >= Key::Count) {
     return;
   }
 
-  if (!down_.contains(key)) {
-    pressed_.insert(key);
+  const auto bit = static_cast<size_t>(key);
+  if (!down_.test(bit)) {
+    pressed_.set(bit);
   }
-  down_.insert(key);
+  down_.set(bit);
 }
 
 void InputState::on_key_up(Key key) {
-  if (key == Key::Unknown) {
+  if (key == Key::Unknown || key >= Key::Count) {
     return;
   }
 
-  if (down_.contains(key)) {
-    released_.insert(key);
+  const auto bit = static_cast<size_t>(key);
+  if (down_.test(bit)) {
+    released_.set(bit);
   }
-  down_.erase(key);
+  down_.reset(bit);
 }
 
 void InputState::on_mouse_move(float x, float y) {
@@ -42,16 +46,33 @@ void InputState::on_scroll(float delta_y) {
   scroll_delta_ += delta_y;
 }
 
+void InputState::apply(const InputEvent& event) {
+  switch (event.type) {
+  case InputEventType::KeyDown:
+    on_key_down(event.key);
+    break;
+  case InputEventType::KeyUp:
+    on_key_up(event.key);
+    break;
+  case InputEventType::MouseMove:
+    on_mouse_move(event.x, event.y);
+    break;
+  case InputEventType::Scroll:
+    on_scroll(event.y);
+    break;
+  }
+}
+
 bool InputState::is_down(Key key) const {
-  return down_.contains(key);
+  return key < Key::Count && down_.test(static_cast<size_t>(key));
 }
 
 bool InputState::was_pressed(Key key) const {
-  return pressed_.contains(key);
+  return key < Key::Count && pressed_.test(static_cast<size_t>(key));
 }
 
 bool InputState::was_released(Key key) const {
-  return released_.contains(key);
+  return key < Key::Count && released_.test(static_cast<size_t>(key));
 }
 
 bool InputState::isDown(Key key) const {
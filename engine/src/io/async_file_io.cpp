@@ -0,0 +1,518 @@
+#include "engine/io/async_file_io.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define ENGINE_ASYNC_IO_URING 1
+#include <atomic>
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace engine::io {
+
+namespace {
+
+// Owns a coroutine suspended in ReadAwaitable. If the read is dropped without completing,
+// the coroutine frame is destroyed instead of leaking.
+class SuspendedCoroutine {
+public:
+  explicit SuspendedCoroutine(const std::coroutine_handle<> handle)
+      : handle_(handle) {}
+  ~SuspendedCoroutine() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  SuspendedCoroutine(const SuspendedCoroutine&) = delete;
+  SuspendedCoroutine& operator=(const SuspendedCoroutine&) = delete;
+
+  void resume() { std::exchange(handle_, nullptr).resume(); }
+
+private:
+  std::coroutine_handle<> handle_;
+};
+
+#ifdef ENGINE_ASYNC_IO_URING
+// A single SQE read is capped by the kernel at 2 GiB; larger reads are resubmitted.
+constexpr uint64_t max_uring_read = 1ULL << 30U;
+#endif
+
+} // namespace
+
+#ifdef ENGINE_ASYNC_IO_URING
+
+// Minimal io_uring wrapper on raw syscalls (no liburing dependency).
+struct AsyncFileIo::Ring {
+  int fd = -1;
+  void* sq_ptr = nullptr;
+  size_t sq_size = 0;
+  void* cq_ptr = nullptr;
+  size_t cq_size = 0;
+  io_uring_sqe* sqes = nullptr;
+  size_t sqes_size = 0;
+
+  unsigned* sq_head = nullptr;
+  unsigned* sq_tail = nullptr;
+  unsigned* sq_mask = nullptr;
+  unsigned* sq_array = nullptr;
+  unsigned sq_entries = 0;
+  unsigned* cq_head = nullptr;
+  unsigned* cq_tail = nullptr;
+  unsigned* cq_mask = nullptr;
+  io_uring_cqe* cqes = nullptr;
+
+  unsigned unsubmitted = 0;
+
+  Ring() = default;
+  Ring(const Ring&) = delete;
+  Ring& operator=(const Ring&) = delete;
+
+  ~Ring() {
+    if (sqes != nullptr) {
+      munmap(sqes, sqes_size);
+    }
+    if (cq_ptr != nullptr && cq_ptr != sq_ptr) {
+      munmap(cq_ptr, cq_size);
+    }
+    if (sq_ptr != nullptr) {
+      munmap(sq_ptr, sq_size);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+
+  bool init(const uint32_t entries) {
+    io_uring_params params{};
+    fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) {
+      return false;
+    }
+
+    sq_size = params.sq_off.array + (params.sq_entries * sizeof(unsigned));
+    cq_size = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0U;
+    if (single_mmap) {
+      sq_size = std::max(sq_size, cq_size);
+      cq_size = sq_size;
+    }
+
+    void* sq = mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED) {
+      return false;
+    }
+    sq_ptr = sq;
+
+    if (single_mmap) {
+      cq_ptr = sq_ptr;
+    } else {
+      void* cq = mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+      if (cq == MAP_FAILED) {
+        return false;
+      }
+      cq_ptr = cq;
+    }
+
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqe_memory = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqe_memory == MAP_FAILED) {
+      return false;
+    }
+    sqes = static_cast<io_uring_sqe*>(sqe_memory);
+
+    auto* sq_base = static_cast<uint8_t*>(sq_ptr);
+    sq_head = reinterpret_cast<unsigned*>(sq_base + params.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned*>(sq_base + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned*>(sq_base + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned*>(sq_base + params.sq_off.array);
+    sq_entries = params.sq_entries;
+
+    auto* cq_base = static_cast<uint8_t*>(cq_ptr);
+    cq_head = reinterpret_cast<unsigned*>(cq_base + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned*>(cq_base + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned*>(cq_base + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe*>(cq_base + params.cq_off.cqes);
+    return true;
+  }
+
+  io_uring_sqe* next_sqe() {
+    const unsigned head = std::atomic_ref<unsigned>(*sq_head).load(std::memory_order_acquire);
+    const unsigned tail = *sq_tail;
+    if (tail - head >= sq_entries) {
+      return nullptr;
+    }
+
+    const unsigned index = tail & *sq_mask;
+    sq_array[index] = index;
+    io_uring_sqe* sqe = &sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    std::atomic_ref<unsigned>(*sq_tail).store(tail + 1U, std::memory_order_release);
+    unsubmitted += 1;
+    return sqe;
+  }
+
+  bool cq_empty() const {
+    return *cq_head == std::atomic_ref<unsigned>(*cq_tail).load(std::memory_order_acquire);
+  }
+
+  int enter(const unsigned to_submit, const unsigned min_complete, const unsigned flags) {
+    const int result = static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+    if (result > 0) {
+      unsubmitted -= std::min(unsubmitted, static_cast<unsigned>(result));
+    }
+    return result;
+  }
+};
+
+#else
+
+struct AsyncFileIo::Ring {};
+
+#endif
+
+ReadAwaitable::ReadAwaitable(AsyncFileIo& io, ReadRequest request)
+    : io_(&io),
+      request_(std::move(request)) {}
+
+void ReadAwaitable::await_suspend(const std::coroutine_handle<> handle) {
+  // std::function needs a copyable callable, hence the shared owner.
+  auto suspended = std::make_shared<SuspendedCoroutine>(handle);
+  io_->read(std::move(request_), [this, suspended](ReadCompletion& completion) {
+    result_ = std::move(completion);
+    // May finish the coroutine and free this awaitable with it.
+    suspended->resume();
+  });
+}
+
+ReadCompletion ReadAwaitable::await_resume() {
+  return std::move(result_);
+}
+
+AsyncFileIo::AsyncFileIo(const uint32_t queue_depth, const bool force_thread_pool)
+    : queue_depth_(std::max(1U, queue_depth)) {
+#ifdef ENGINE_ASYNC_IO_URING
+  if (!force_thread_pool) {
+    auto ring = std::make_unique<Ring>();
+    if (ring->init(queue_depth_)) {
+      ring_ = std::move(ring);
+      queue_depth_ = std::min(queue_depth_, ring_->sq_entries);
+      backend_ = AsyncIoBackend::IoUring;
+      return;
+    }
+  }
+#else
+  (void)force_thread_pool;
+#endif
+
+  pool_ = std::make_unique<core::ThreadPool>(std::min(4U, queue_depth_));
+  backend_ = AsyncIoBackend::ThreadPool;
+}
+
+AsyncFileIo::~AsyncFileIo() {
+  // In-flight reads still target slot buffers (and pool jobs touch finished_), so drain them first.
+  for (const uint32_t slot : queued_) {
+    slots_[slot] = {};
+    free_slots_.push_back(slot);
+  }
+  queued_.clear();
+  for (Slot& slot : slots_) {
+    slot.callback = nullptr;
+  }
+  wait_all();
+}
+
+uint64_t AsyncFileIo::read(ReadRequest request, ReadCallback callback) {
+  const uint32_t slot = acquire_slot();
+  Slot& entry = slots_[slot];
+  entry.id = next_id_++;
+  entry.request = std::move(request);
+  entry.callback = std::move(callback);
+  queued_.push_back(slot);
+  return entry.id;
+}
+
+ReadAwaitable AsyncFileIo::read_async(ReadRequest request) {
+  return ReadAwaitable(*this, std::move(request));
+}
+
+void AsyncFileIo::submit() {
+  size_t started = 0;
+
+#ifdef ENGINE_ASYNC_IO_URING
+  if (ring_ != nullptr) {
+    size_t resubmitted = 0;
+    while (resubmitted < resubmit_.size() && queue_uring_read(resubmit_[resubmitted])) {
+      resubmitted += 1;
+    }
+    resubmit_.erase(resubmit_.begin(), resubmit_.begin() + static_cast<std::ptrdiff_t>(resubmitted));
+
+    while (started < queued_.size() && in_flight_ < queue_depth_) {
+      start_uring(queued_[started]);
+      started += 1;
+    }
+
+    if (ring_->unsubmitted > 0U) {
+      ring_->enter(ring_->unsubmitted, 0U, 0U);
+      stats_.submit_batches += 1;
+    }
+  }
+#endif
+
+  if (pool_ != nullptr) {
+    while (started < queued_.size() && in_flight_ < queue_depth_) {
+      start_thread_pool(queued_[started]);
+      started += 1;
+    }
+    if (started > 0U) {
+      stats_.submit_batches += 1;
+    }
+  }
+
+  queued_.erase(queued_.begin(), queued_.begin() + static_cast<std::ptrdiff_t>(started));
+}
+
+uint32_t AsyncFileIo::poll() {
+  submit();
+  if (ring_ != nullptr) {
+    reap_uring(false);
+  }
+  return finish();
+}
+
+void AsyncFileIo::wait_all() {
+  while (!queued_.empty() || in_flight_ > 0U) {
+    submit();
+    // Reads that failed before reaching the kernel are already finished; never block on them.
+    finish();
+    if (in_flight_ == 0U) {
+      continue;
+    }
+    if (ring_ != nullptr) {
+      reap_uring(true);
+    } else if (pool_ != nullptr) {
+      pool_->wait_idle();
+    }
+    finish();
+  }
+}
+
+AsyncIoBackend AsyncFileIo::backend() const {
+  return backend_;
+}
+
+AsyncIoStats AsyncFileIo::stats() const {
+  AsyncIoStats out = stats_;
+  out.queued = static_cast<uint32_t>(queued_.size());
+  out.in_flight = in_flight_;
+  return out;
+}
+
+uint32_t AsyncFileIo::pending() const {
+  return static_cast<uint32_t>(queued_.size()) + in_flight_;
+}
+
+uint32_t AsyncFileIo::acquire_slot() {
+  if (!free_slots_.empty()) {
+    const uint32_t slot = free_slots_.back();
+    free_slots_.pop_back();
+    slots_[slot].in_use = true;
+    return slot;
+  }
+
+  slots_.emplace_back();
+  slots_.back().in_use = true;
+  return static_cast<uint32_t>(slots_.size() - 1U);
+}
+
+void AsyncFileIo::push_finished(Finished finished) {
+  std::lock_guard<std::mutex> lock(finished_mutex_);
+  finished_.push_back(std::move(finished));
+}
+
+void AsyncFileIo::start_uring(const uint32_t slot) {
+  in_flight_ += 1;
+  stats_.submitted += 1;
+  stats_.peak_in_flight = std::max(stats_.peak_in_flight, in_flight_);
+
+#ifdef ENGINE_ASYNC_IO_URING
+  Slot& entry = slots_[slot];
+  entry.fd = open(entry.request.path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (entry.fd < 0) {
+    push_finished({slot, false, "Failed to open file: " + entry.request.path, {}});
+    return;
+  }
+
+  struct stat file_stat{};
+  if (fstat(entry.fd, &file_stat) != 0) {
+    push_finished({slot, false, "Failed to stat file: " + entry.request.path, {}});
+    return;
+  }
+
+  const auto file_size = static_cast<uint64_t>(file_stat.st_size);
+  const uint64_t available = entry.request.offset < file_size ? file_size - entry.request.offset : 0U;
+  const uint64_t length = entry.request.size == 0U ? available : std::min(entry.request.size, available);
+  entry.bytes.resize(static_cast<size_t>(length));
+  entry.done = 0;
+
+  if (length == 0U) {
+    push_finished({slot, true, {}, {}});
+    return;
+  }
+
+  // The kernel reads straight into the slot buffer, which stays put until the read completes.
+  if (!queue_uring_read(slot)) {
+    resubmit_.push_back(slot);
+  }
+#else
+  (void)slot;
+#endif
+}
+
+bool AsyncFileIo::queue_uring_read(const uint32_t slot) {
+#ifdef ENGINE_ASYNC_IO_URING
+  io_uring_sqe* sqe = ring_->next_sqe();
+  if (sqe == nullptr) {
+    return false;
+  }
+
+  Slot& entry = slots_[slot];
+  const uint64_t remaining = entry.bytes.size() - entry.done;
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = entry.fd;
+  sqe->addr = reinterpret_cast<uint64_t>(entry.bytes.data() + entry.done);
+  sqe->len = static_cast<uint32_t>(std::min(remaining, max_uring_read));
+  sqe->off = entry.request.offset + entry.done;
+  sqe->user_data = slot;
+  return true;
+#else
+  (void)slot;
+  return false;
+#endif
+}
+
+bool AsyncFileIo::reap_uring(const bool wait) {
+#ifdef ENGINE_ASYNC_IO_URING
+  if (ring_->cq_empty() && in_flight_ > 0U) {
+    // Flushes deferred completion work; blocks for one completion when waiting.
+    ring_->enter(0U, wait ? 1U : 0U, IORING_ENTER_GETEVENTS);
+  }
+
+  unsigned head = *ring_->cq_head;
+  const unsigned tail = std::atomic_ref<unsigned>(*ring_->cq_tail).load(std::memory_order_acquire);
+  const bool reaped = head != tail;
+  for (; head != tail; ++head) {
+    const io_uring_cqe& cqe = ring_->cqes[head & *ring_->cq_mask];
+    const auto slot = static_cast<uint32_t>(cqe.user_data);
+    Slot& entry = slots_[slot];
+
+    if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+      resubmit_.push_back(slot);
+    } else if (cqe.res < 0) {
+      push_finished({slot, false, "Read failed for " + entry.request.path + ": " + std::strerror(-cqe.res), {}});
+    } else if (cqe.res == 0) {
+      entry.bytes.resize(static_cast<size_t>(entry.done)); // file shrank underneath us
+      push_finished({slot, true, {}, {}});
+    } else {
+      entry.done += static_cast<uint64_t>(cqe.res);
+      if (entry.done < entry.bytes.size()) {
+        resubmit_.push_back(slot);
+      } else {
+        push_finished({slot, true, {}, {}});
+      }
+    }
+  }
+  std::atomic_ref<unsigned>(*ring_->cq_head).store(head, std::memory_order_release);
+  return reaped;
+#else
+  (void)wait;
+  return false;
+#endif
+}
+
+void AsyncFileIo::start_thread_pool(const uint32_t slot) {
+  in_flight_ += 1;
+  stats_.submitted += 1;
+  stats_.peak_in_flight = std::max(stats_.peak_in_flight, in_flight_);
+
+  pool_->submit([this, slot, request = slots_[slot].request] {
+    Finished finished{};
+    finished.slot = slot;
+
+    std::error_code ec;
+    const uint64_t file_size = std::filesystem::file_size(request.path, ec);
+    std::ifstream file(request.path, std::ios::binary);
+    if (ec || !file.is_open()) {
+      finished.error = "Failed to open file: " + request.path;
+      push_finished(std::move(finished));
+      return;
+    }
+
+    const uint64_t available = request.offset < file_size ? file_size - request.offset : 0U;
+    const uint64_t length = request.size == 0U ? available : std::min(request.size, available);
+    finished.bytes.resize(static_cast<size_t>(length));
+    file.seekg(static_cast<std::streamoff>(request.offset));
+    if (length > 0U && !file.read(reinterpret_cast<char*>(finished.bytes.data()), static_cast<std::streamsize>(length))) {
+      finished.error = "Read failed for " + request.path;
+      push_finished(std::move(finished));
+      return;
+    }
+
+    finished.ok = true;
+    push_finished(std::move(finished));
+  });
+}
+
+uint32_t AsyncFileIo::finish() {
+  std::vector<Finished> finished;
+  {
+    std::lock_guard<std::mutex> lock(finished_mutex_);
+    finished.swap(finished_);
+  }
+
+  for (Finished& item : finished) {
+    Slot& entry = slots_[item.slot];
+
+    ReadCompletion completion{};
+    completion.id = entry.id;
+    completion.ok = item.ok;
+    completion.path = std::move(entry.request.path);
+    completion.error = std::move(item.error);
+    completion.bytes = ring_ != nullptr ? std::move(entry.bytes) : std::move(item.bytes);
+    ReadCallback callback = std::move(entry.callback);
+
+#ifdef ENGINE_ASYNC_IO_URING
+    if (entry.fd >= 0) {
+      close(entry.fd);
+    }
+#endif
+    entry = {};
+    free_slots_.push_back(item.slot);
+    in_flight_ -= 1;
+
+    stats_.completed += 1;
+    if (completion.ok) {
+      stats_.bytes_read += completion.bytes.size();
+    } else {
+      stats_.failed += 1;
+    }
+
+    // Callbacks may queue further reads; the slot has already been recycled.
+    if (callback) {
+      callback(completion);
+    }
+  }
+  return static_cast<uint32_t>(finished.size());
+}
+
+} // namespace engine::io
@@ -0,0 +1,209 @@
+#include "engine/io/file_watcher.h"
+
+#include <algorithm>
+#include <system_error>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace engine::io {
+
+namespace {
+
+void append_unique(std::vector<std::string>* out, std::string path) {
+  if (std::find(out->begin(), out->end(), path) == out->end()) {
+    out->push_back(std::move(path));
+  }
+}
+
+} // namespace
+
+FileWatcher::~FileWatcher() {
+  stop();
+}
+
+bool FileWatcher::watch_directory(const std::string& root, const bool force_polling) {
+  stop();
+
+  std::error_code ec;
+  if (!std::filesystem::is_directory(root, ec)) {
+    return false;
+  }
+
+  root_ = std::filesystem::path(root).lexically_normal();
+  if (!force_polling && start_inotify()) {
+    backend_ = FileWatchBackend::Inotify;
+    return true;
+  }
+
+  scan(&stamps_);
+  last_scan_ = std::chrono::steady_clock::now();
+  backend_ = FileWatchBackend::Polling;
+  return true;
+}
+
+void FileWatcher::stop() {
+#if defined(__linux__)
+  if (inotify_fd_ >= 0) {
+    close(inotify_fd_);
+  }
+#endif
+  inotify_fd_ = -1;
+  watch_dirs_.clear();
+  stamps_.clear();
+  backend_ = FileWatchBackend::None;
+}
+
+void FileWatcher::poll(std::vector<std::string>* out_changed_paths) {
+  if (out_changed_paths == nullptr) {
+    return;
+  }
+
+  switch (backend_) {
+  case FileWatchBackend::Inotify:
+    poll_inotify(out_changed_paths);
+    break;
+  case FileWatchBackend::Polling:
+    poll_scan(out_changed_paths);
+    break;
+  case FileWatchBackend::None:
+  default:
+    break;
+  }
+}
+
+void FileWatcher::set_poll_interval(const double seconds) {
+  poll_interval_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(std::max(0.0, seconds)));
+}
+
+FileWatchBackend FileWatcher::backend() const {
+  return backend_;
+}
+
+bool FileWatcher::start_inotify() {
+#if defined(__linux__)
+  inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (inotify_fd_ < 0) {
+    return false;
+  }
+
+  add_inotify_watch(root_);
+  std::error_code ec;
+  for (auto it = std::filesystem::recursive_directory_iterator(root_, ec);
+       !ec && it != std::filesystem::recursive_directory_iterator();
+       it.increment(ec)) {
+    if (it->is_directory(ec)) {
+      add_inotify_watch(it->path());
+    }
+  }
+
+  if (watch_dirs_.empty()) {
+    close(inotify_fd_);
+    inotify_fd_ = -1;
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void FileWatcher::add_inotify_watch(const std::filesystem::path& directory) {
+#if defined(__linux__)
+  constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE;
+  const int wd = inotify_add_watch(inotify_fd_, directory.c_str(), mask);
+  if (wd >= 0) {
+    watch_dirs_[wd] = directory;
+  }
+#else
+  (void)directory;
+#endif
+}
+
+void FileWatcher::poll_inotify(std::vector<std::string>* out_changed_paths) {
+#if defined(__linux__)
+  alignas(inotify_event) char buffer[4096];
+  for (;;) {
+    const ssize_t length = read(inotify_fd_, buffer, sizeof(buffer));
+    if (length <= 0) {
+      return;
+    }
+
+    for (ssize_t offset = 0; offset < length;) {
+      const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+      offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+      const auto dir_it = watch_dirs_.find(event->wd);
+      if (dir_it == watch_dirs_.end() || event->len == 0) {
+        continue;
+      }
+
+      const std::filesystem::path path = dir_it->second / event->name;
+      if ((event->mask & IN_ISDIR) != 0U) {
+        if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0U) {
+          add_inotify_watch(path);
+        }
+        continue;
+      }
+
+      // IN_CREATE alone is followed by IN_CLOSE_WRITE once the writer is done.
+      if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE)) != 0U) {
+        append_unique(out_changed_paths, path.generic_string());
+      }
+    }
+  }
+#else
+  (void)out_changed_paths;
+#endif
+}
+
+void FileWatcher::scan(std::unordered_map<std::string, FileStamp>* out_stamps) const {
+  out_stamps->clear();
+
+  std::error_code ec;
+  for (auto it = std::filesystem::recursive_directory_iterator(root_, ec);
+       !ec && it != std::filesystem::recursive_directory_iterator();
+       it.increment(ec)) {
+    if (!it->is_regular_file(ec)) {
+      continue;
+    }
+
+    FileStamp stamp{};
+    stamp.write_time = it->last_write_time(ec);
+    stamp.size = it->file_size(ec);
+    (*out_stamps)[it->path().generic_string()] = stamp;
+  }
+}
+
+void FileWatcher::poll_scan(std::vector<std::string>* out_changed_paths) {
+  const auto now = std::chrono::steady_clock::now();
+  if (now - last_scan_ < poll_interval_) {
+    return;
+  }
+  last_scan_ = now;
+
+  std::unordered_map<std::string, FileStamp> current;
+  scan(&current);
+
+  for (const auto& [path, stamp] : current) {
+    const auto previous = stamps_.find(path);
+    if (previous == stamps_.end() || previous->second.write_time != stamp.write_time ||
+        previous->second.size != stamp.size) {
+      append_unique(out_changed_paths, path);
+    }
+  }
+  for (const auto& [path, stamp] : stamps_) {
+    (void)stamp;
+    if (!current.contains(path)) {
+      append_unique(out_changed_paths, path);
+    }
+  }
+
+  stamps_ = std::move(current);
+}
+
+} // namespace engine::io
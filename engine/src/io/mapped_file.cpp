@@ -0,0 +1,137 @@
+#include "engine/io/mapped_file.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine::io {
+
+MappedFile::~MappedFile() {
+  close();
+}
+
+bool MappedFile::open(const std::string& path) {
+  close();
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  LARGE_INTEGER file_size{};
+  if (GetFileSizeEx(file, &file_size) == 0 || file_size.QuadPart <= 0) {
+    CloseHandle(file);
+    return false;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    CloseHandle(file);
+    return false;
+  }
+
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == nullptr) {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+
+  file_handle_ = file;
+  mapping_handle_ = mapping;
+  data_ = static_cast<const uint8_t*>(view);
+  size_ = static_cast<size_t>(file_size.QuadPart);
+  return true;
+#else
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat info{};
+  if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+
+  void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  if (view == MAP_FAILED) {
+    ::close(fd);
+    return false;
+  }
+
+  fd_ = fd;
+  data_ = static_cast<const uint8_t*>(view);
+  size_ = static_cast<size_t>(info.st_size);
+  return true;
+#endif
+}
+
+void MappedFile::close() {
+#if defined(_WIN32)
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+  }
+  if (mapping_handle_ != nullptr) {
+    CloseHandle(static_cast<HANDLE>(mapping_handle_));
+  }
+  if (file_handle_ != nullptr) {
+    CloseHandle(static_cast<HANDLE>(file_handle_));
+  }
+  mapping_handle_ = nullptr;
+  file_handle_ = nullptr;
+#else
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+  fd_ = -1;
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+void MappedFile::prefetch(const size_t offset, const size_t size) const {
+  if (data_ == nullptr || offset >= size_) {
+    return;
+  }
+
+#if defined(_WIN32)
+  WIN32_MEMORY_RANGE_ENTRY range{};
+  range.VirtualAddress = const_cast<uint8_t*>(data_ + offset);
+  range.NumberOfBytes = (size < size_ - offset) ? size : size_ - offset;
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  const long page_size = sysconf(_SC_PAGESIZE);
+  const size_t page = page_size > 0 ? static_cast<size_t>(page_size) : 4096U;
+  const size_t begin = offset - (offset % page);
+  const size_t end = (size < size_ - offset) ? offset + size : size_;
+  madvise(const_cast<uint8_t*>(data_ + begin), end - begin, MADV_WILLNEED);
+#endif
+}
+
+bool MappedFile::is_open() const {
+  return data_ != nullptr;
+}
+
+const uint8_t* MappedFile::data() const {
+  return data_;
+}
+
+size_t MappedFile::size() const {
+  return size_;
+}
+
+} // namespace engine::io
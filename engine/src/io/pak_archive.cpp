@@ -0,0 +1,380 @@
+#include "engine/io/pak_archive.h"
+
+#include "engine/core/hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#ifdef ENGINE_HAS_LZ4
+#include <lz4.h>
+#endif
+
+#ifdef ENGINE_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace engine::io {
+
+namespace {
+
+void set_error(std::string* out_error, const std::string& message) {
+  if (out_error != nullptr) {
+    *out_error = message;
+  }
+}
+
+uint64_t align_up(const uint64_t value, const uint64_t alignment) {
+  return ((value + alignment - 1U) / alignment) * alignment;
+}
+
+bool compress_bytes(const PakCompression compression, std::span<const uint8_t> bytes, std::vector<uint8_t>* out) {
+  switch (compression) {
+#ifdef ENGINE_HAS_LZ4
+  case PakCompression::Lz4: {
+    const int bound = LZ4_compressBound(static_cast<int>(bytes.size()));
+    out->resize(static_cast<size_t>(bound));
+    const int written = LZ4_compress_default(reinterpret_cast<const char*>(bytes.data()),
+                                             reinterpret_cast<char*>(out->data()),
+                                             static_cast<int>(bytes.size()),
+                                             bound);
+    if (written <= 0) {
+      return false;
+    }
+    out->resize(static_cast<size_t>(written));
+    return true;
+  }
+#endif
+#ifdef ENGINE_HAS_ZSTD
+  case PakCompression::Zstd: {
+    out->resize(ZSTD_compressBound(bytes.size()));
+    const size_t written = ZSTD_compress(out->data(), out->size(), bytes.data(), bytes.size(), 19);
+    if (ZSTD_isError(written) != 0U) {
+      return false;
+    }
+    out->resize(written);
+    return true;
+  }
+#endif
+  default:
+    (void)bytes;
+    (void)out;
+    return false;
+  }
+}
+
+} // namespace
+
+std::string normalize_virtual_path(const std::string_view path) {
+  std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+  while (normalized.starts_with("./")) {
+    normalized.erase(0, 2);
+  }
+  return normalized;
+}
+
+uint64_t hash_virtual_path(const std::string_view path) {
+  return core::fnv1a_64(normalize_virtual_path(path));
+}
+
+bool pak_compression_supported(const PakCompression compression) {
+  switch (compression) {
+  case PakCompression::None:
+    return true;
+  case PakCompression::Lz4:
+#ifdef ENGINE_HAS_LZ4
+    return true;
+#else
+    return false;
+#endif
+  case PakCompression::Zstd:
+#ifdef ENGINE_HAS_ZSTD
+    return true;
+#else
+    return false;
+#endif
+  default:
+    return false;
+  }
+}
+
+const char* pak_compression_name(const PakCompression compression) {
+  switch (compression) {
+  case PakCompression::None:
+    return "none";
+  case PakCompression::Lz4:
+    return "lz4";
+  case PakCompression::Zstd:
+    return "zstd";
+  default:
+    return "unknown";
+  }
+}
+
+bool PakArchive::open(const std::string& path, std::string* out_error) {
+  close();
+
+  if (!file_.open(path)) {
+    set_error(out_error, "Failed to map pak archive: " + path);
+    return false;
+  }
+
+  const uint8_t* base = file_.data();
+  const size_t size = file_.size();
+  if (size < sizeof(PakHeader)) {
+    set_error(out_error, "Pak archive is truncated: " + path);
+    close();
+    return false;
+  }
+
+  const auto* header = reinterpret_cast<const PakHeader*>(base);
+  if (header->magic != pak_magic || header->version != pak_version) {
+    set_error(out_error, "Not a supported pak archive: " + path);
+    close();
+    return false;
+  }
+
+  // Written so no sum can wrap: the table must fit between the header and the end of the file.
+  const uint64_t toc_bytes = static_cast<uint64_t>(header->entry_count) * sizeof(PakEntry);
+  if ((header->toc_offset % alignof(PakEntry)) != 0U || header->toc_offset < sizeof(PakHeader) ||
+      header->toc_offset > size || toc_bytes > size - header->toc_offset || header->names_offset > size ||
+      header->names_offset < header->toc_offset + toc_bytes) {
+    set_error(out_error, "Pak archive has a corrupt table of contents: " + path);
+    close();
+    return false;
+  }
+
+  header_ = header;
+  entries_ = reinterpret_cast<const PakEntry*>(base + header->toc_offset);
+  names_ = reinterpret_cast<const char*>(base + header->names_offset);
+  names_size_ = size - static_cast<size_t>(header->names_offset);
+  path_ = path;
+
+  for (const PakEntry& entry : entries()) {
+    const bool stored_in_bounds = entry.offset >= sizeof(PakHeader) && entry.offset <= header->toc_offset &&
+                                  entry.stored_size <= header->toc_offset - entry.offset;
+    const bool size_valid = entry.size <= pak_max_entry_size &&
+                            (static_cast<PakCompression>(entry.compression) != PakCompression::None ||
+                             entry.stored_size == entry.size);
+    if (!stored_in_bounds || !size_valid || entry.name_offset >= names_size_) {
+      set_error(out_error, "Pak archive entry out of bounds: " + path);
+      close();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void PakArchive::close() {
+  file_.close();
+  path_.clear();
+  header_ = nullptr;
+  entries_ = nullptr;
+  names_ = nullptr;
+  names_size_ = 0;
+}
+
+const PakEntry* PakArchive::find(const std::string_view virtual_path) const {
+  if (header_ == nullptr) {
+    return nullptr;
+  }
+
+  const std::string normalized = normalize_virtual_path(virtual_path);
+  const uint64_t hash = core::fnv1a_64(normalized);
+
+  const std::span<const PakEntry> toc = entries();
+  auto it = std::lower_bound(toc.begin(), toc.end(), hash, [](const PakEntry& entry, const uint64_t value) {
+    return entry.path_hash < value;
+  });
+  for (; it != toc.end() && it->path_hash == hash; ++it) {
+    if (entry_name(*it) == normalized) {
+      return &*it;
+    }
+  }
+  return nullptr;
+}
+
+std::string_view PakArchive::entry_name(const PakEntry& entry) const {
+  if (names_ == nullptr || entry.name_offset >= names_size_) {
+    return {};
+  }
+  const char* name = names_ + entry.name_offset;
+  return {name, strnlen(name, names_size_ - entry.name_offset)};
+}
+
+std::span<const uint8_t> PakArchive::stored_bytes(const PakEntry& entry) const {
+  if (header_ == nullptr) {
+    return {};
+  }
+  return {file_.data() + entry.offset, static_cast<size_t>(entry.stored_size)};
+}
+
+bool PakArchive::decompress(const PakEntry& entry, std::vector<uint8_t>* out_bytes, std::string* out_error) const {
+  const std::span<const uint8_t> stored = stored_bytes(entry);
+  const auto compression = static_cast<PakCompression>(entry.compression);
+  out_bytes->resize(static_cast<size_t>(entry.size));
+
+  switch (compression) {
+  case PakCompression::None:
+    if (stored.size() != out_bytes->size()) {
+      set_error(out_error, "Pak entry size mismatch: " + std::string(entry_name(entry)));
+      return false;
+    }
+    std::copy(stored.begin(), stored.end(), out_bytes->begin());
+    return true;
+#ifdef ENGINE_HAS_LZ4
+  case PakCompression::Lz4: {
+    const int written = LZ4_decompress_safe(reinterpret_cast<const char*>(stored.data()),
+                                            reinterpret_cast<char*>(out_bytes->data()),
+                                            static_cast<int>(stored.size()),
+                                            static_cast<int>(out_bytes->size()));
+    if (written < 0 || static_cast<uint64_t>(written) != entry.size) {
+      set_error(out_error, "LZ4 decompression failed for pak entry: " + std::string(entry_name(entry)));
+      return false;
+    }
+    return true;
+  }
+#endif
+#ifdef ENGINE_HAS_ZSTD
+  case PakCompression::Zstd: {
+    const size_t written = ZSTD_decompress(out_bytes->data(), out_bytes->size(), stored.data(), stored.size());
+    if (ZSTD_isError(written) != 0U || written != entry.size) {
+      set_error(out_error, "zstd decompression failed for pak entry: " + std::string(entry_name(entry)));
+      return false;
+    }
+    return true;
+  }
+#endif
+  default:
+    set_error(out_error,
+              std::string("Pak entry uses unsupported compression '") + pak_compression_name(compression) +
+                  "': " + std::string(entry_name(entry)));
+    return false;
+  }
+}
+
+void PakArchive::prefetch(const PakEntry& entry) const {
+  file_.prefetch(static_cast<size_t>(entry.offset), static_cast<size_t>(entry.stored_size));
+}
+
+std::span<const PakEntry> PakArchive::entries() const {
+  if (header_ == nullptr) {
+    return {};
+  }
+  return {entries_, header_->entry_count};
+}
+
+bool PakArchive::is_open() const {
+  return header_ != nullptr;
+}
+
+const std::string& PakArchive::path() const {
+  return path_;
+}
+
+PakWriter::PakWriter(const uint32_t alignment)
+    : alignment_(std::max<uint32_t>(alignof(PakEntry), alignment)) {}
+
+bool PakWriter::add_file(const std::string_view virtual_path,
+                         const std::span<const uint8_t> bytes,
+                         const PakCompression compression,
+                         std::string* out_error) {
+  PendingEntry entry{};
+  entry.name = normalize_virtual_path(virtual_path);
+  entry.path_hash = core::fnv1a_64(entry.name);
+  entry.size = bytes.size();
+
+  for (const PendingEntry& existing : entries_) {
+    if (existing.path_hash == entry.path_hash) {
+      set_error(out_error,
+                existing.name == entry.name ? "Duplicate pak entry: " + entry.name
+                                            : "Pak path hash collision: " + entry.name + " / " + existing.name);
+      return false;
+    }
+  }
+
+  std::vector<uint8_t> compressed;
+  if (compression != PakCompression::None && pak_compression_supported(compression) &&
+      compress_bytes(compression, bytes, &compressed) && compressed.size() < bytes.size()) {
+    entry.compression = compression;
+    entry.stored = std::move(compressed);
+  } else {
+    entry.stored.assign(bytes.begin(), bytes.end());
+  }
+
+  entries_.push_back(std::move(entry));
+  return true;
+}
+
+bool PakWriter::write(const std::string& path, std::string* out_error) const {
+  std::vector<const PendingEntry*> sorted;
+  sorted.reserve(entries_.size());
+  for (const PendingEntry& entry : entries_) {
+    sorted.push_back(&entry);
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const PendingEntry* a, const PendingEntry* b) {
+    return a->path_hash < b->path_hash;
+  });
+
+  std::vector<PakEntry> toc;
+  toc.reserve(sorted.size());
+  std::string names;
+
+  uint64_t cursor = align_up(sizeof(PakHeader), alignment_);
+  for (const PendingEntry* pending : sorted) {
+    PakEntry entry{};
+    entry.path_hash = pending->path_hash;
+    entry.offset = cursor;
+    entry.stored_size = pending->stored.size();
+    entry.size = pending->size;
+    entry.compression = static_cast<uint32_t>(pending->compression);
+    entry.name_offset = static_cast<uint32_t>(names.size());
+    names += pending->name;
+    names.push_back('\0');
+    toc.push_back(entry);
+
+    cursor = align_up(cursor + entry.stored_size, alignment_);
+  }
+
+  PakHeader header{};
+  header.entry_count = static_cast<uint32_t>(toc.size());
+  header.alignment = alignment_;
+  header.toc_offset = cursor;
+  header.names_offset = cursor + (toc.size() * sizeof(PakEntry));
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    set_error(out_error, "Failed to create pak archive: " + path);
+    return false;
+  }
+
+  const auto pad_to = [&out](const uint64_t offset) {
+    const auto position = static_cast<uint64_t>(out.tellp());
+    for (uint64_t i = position; i < offset; ++i) {
+      out.put('\0');
+    }
+  };
+
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    pad_to(toc[i].offset);
+    out.write(reinterpret_cast<const char*>(sorted[i]->stored.data()), static_cast<std::streamsize>(sorted[i]->stored.size()));
+  }
+  pad_to(header.toc_offset);
+  out.write(reinterpret_cast<const char*>(toc.data()), static_cast<std::streamsize>(toc.size() * sizeof(PakEntry)));
+  out.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+  if (!out.good()) {
+    set_error(out_error, "Failed to write pak archive: " + path);
+    return false;
+  }
+  return true;
+}
+
+size_t PakWriter::entry_count() const {
+  return entries_.size();
+}
+
+} // namespace engine::io
@@ -0,0 +1,145 @@
+#include "engine/io/vfs.h"
+
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+namespace engine::io {
+
+std::span<const uint8_t> FileData::bytes() const {
+  return zero_copy() ? view : std::span<const uint8_t>(storage);
+}
+
+bool FileData::zero_copy() const {
+  return view.data() != nullptr;
+}
+
+bool Vfs::mount_pak(const std::string& pak_path, std::string* out_error) {
+  auto pak = std::make_unique<PakArchive>();
+  if (!pak->open(pak_path, out_error)) {
+    return false;
+  }
+
+  Mount mount{};
+  mount.pak = std::move(pak);
+  mounts_.push_back(std::move(mount));
+  return true;
+}
+
+void Vfs::mount_directory(const std::string& root) {
+  Mount mount{};
+  mount.directory = root;
+  mounts_.push_back(std::move(mount));
+}
+
+void Vfs::unmount_all() {
+  mounts_.clear();
+}
+
+FileData Vfs::read(const std::string_view virtual_path) const {
+  FileData out{};
+
+  for (auto it = mounts_.rbegin(); it != mounts_.rend(); ++it) {
+    if (it->pak != nullptr) {
+      const PakEntry* entry = it->pak->find(virtual_path);
+      if (entry == nullptr) {
+        continue;
+      }
+
+      pak_reads_.fetch_add(1, std::memory_order_relaxed);
+      if (static_cast<PakCompression>(entry->compression) == PakCompression::None) {
+        zero_copy_reads_.fetch_add(1, std::memory_order_relaxed);
+        out.view = it->pak->stored_bytes(*entry);
+        out.ok = true;
+        return out;
+      }
+
+      out.ok = it->pak->decompress(*entry, &out.storage, &out.error);
+      return out;
+    }
+
+    const std::filesystem::path file_path = std::filesystem::path(it->directory) / normalize_virtual_path(virtual_path);
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(file_path, ec)) {
+      continue;
+    }
+
+    std::ifstream in(file_path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+      continue;
+    }
+
+    directory_reads_.fetch_add(1, std::memory_order_relaxed);
+    const std::streamsize size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    out.storage.resize(static_cast<size_t>(size > 0 ? size : 0));
+    if (size > 0 && !in.read(reinterpret_cast<char*>(out.storage.data()), size)) {
+      out.error = "Failed to read file: " + file_path.generic_string();
+      return out;
+    }
+    out.ok = true;
+    return out;
+  }
+
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  out.error = "File not found in VFS: " + std::string(virtual_path);
+  return out;
+}
+
+bool Vfs::exists(const std::string_view virtual_path) const {
+  for (auto it = mounts_.rbegin(); it != mounts_.rend(); ++it) {
+    if (it->pak != nullptr) {
+      if (it->pak->find(virtual_path) != nullptr) {
+        return true;
+      }
+      continue;
+    }
+
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(std::filesystem::path(it->directory) / normalize_virtual_path(virtual_path), ec)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Vfs::prefetch(const std::string_view virtual_path) const {
+  for (auto it = mounts_.rbegin(); it != mounts_.rend(); ++it) {
+    if (it->pak == nullptr) {
+      continue;
+    }
+    if (const PakEntry* entry = it->pak->find(virtual_path); entry != nullptr) {
+      it->pak->prefetch(*entry);
+      return;
+    }
+  }
+}
+
+std::string Vfs::native_path(const std::string_view virtual_path) const {
+  for (auto it = mounts_.rbegin(); it != mounts_.rend(); ++it) {
+    if (it->pak != nullptr) {
+      if (it->pak->find(virtual_path) != nullptr) {
+        return {};
+      }
+      continue;
+    }
+
+    const std::filesystem::path file_path = std::filesystem::path(it->directory) / normalize_virtual_path(virtual_path);
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(file_path, ec)) {
+      return file_path.generic_string();
+    }
+  }
+  return {};
+}
+
+VfsStats Vfs::stats() const {
+  VfsStats out{};
+  out.pak_reads = pak_reads_.load(std::memory_order_relaxed);
+  out.zero_copy_reads = zero_copy_reads_.load(std::memory_order_relaxed);
+  out.directory_reads = directory_reads_.load(std::memory_order_relaxed);
+  out.misses = misses_.load(std::memory_order_relaxed);
+  return out;
+}
+
+} // namespace engine::io
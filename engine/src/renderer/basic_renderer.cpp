@@ -1,9 +1,10 @@
 #include "engine/renderer/basic_renderer.h"
 
 #include "engine/math/mat4.h"
-#include "engine/math/vec4.h"
+#include "engine/renderer/vertex_projection.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <string>
@@ -20,20 +21,18 @@ namespace engine::renderer {
 
 namespace {
 
-SDL_FPoint to_screen(const math::Vec4& clip, const int width, const int height) {
-  const float inv_w = 1.0F / clip.w;
-  const float ndc_x = clip.x * inv_w;
-  const float ndc_y = clip.y * inv_w;
+using Clock = std::chrono::steady_clock;
 
-  SDL_FPoint out{};
-  out.x = (ndc_x * 0.5F + 0.5F) * static_cast<float>(width);
-  out.y = (1.0F - (ndc_y * 0.5F + 0.5F)) * static_cast<float>(height);
-  return out;
+double elapsed_ms(const Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
 }
 
 } // namespace
 
-bool BasicRenderer::init(const int width, const int height, const NativeWindowData native_window_data) {
+bool BasicRenderer::init(const int width,
+                         const int height,
+                         const NativeWindowData native_window_data,
+                         const bool off_window_thread) {
   width_ = std::max(1, width);
   height_ = std::max(1, height);
   enabled_ = false;
@@ -45,7 +44,13 @@ bool BasicRenderer::init(const int width, const int height, const NativeWindowDa
   const bool prefer_bgfx = (backend == "bgfx");
 
 #ifdef ENGINE_HAS_BGFX
-  if (prefer_bgfx && native_window_data.nwh != nullptr) {
+#ifdef __APPLE__
+  // bgfx's Metal and GL contexts belong to the main thread here.
+  const bool bgfx_allowed = !off_window_thread;
+#else
+  const bool bgfx_allowed = true;
+#endif
+  if (prefer_bgfx && bgfx_allowed && native_window_data.nwh != nullptr) {
     bgfx::Init init{};
     init.type = bgfx::RendererType::Count;
     init.platformData.nwh = native_window_data.nwh;
@@ -62,7 +67,7 @@ bool BasicRenderer::init(const int width, const int height, const NativeWindowDa
   }
 #endif
 
-  if (native_window_data.sdl_window != nullptr) {
+  if (native_window_data.sdl_window != nullptr && !off_window_thread) {
     SDL_Window* window = reinterpret_cast<SDL_Window*>(native_window_data.sdl_window);
     SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
     if (renderer == nullptr) {
@@ -80,6 +85,45 @@ bool BasicRenderer::init(const int width, const int height, const NativeWindowDa
   return false;
 }
 
+bool BasicRenderer::init_headless(const int width, const int height, const HeadlessBackend backend) {
+  width_ = std::max(1, width);
+  height_ = std::max(1, height);
+  enabled_ = false;
+  using_bgfx_ = false;
+  sdl_renderer_ = nullptr;
+
+  if (backend == HeadlessBackend::BgfxNoop) {
+#ifdef ENGINE_HAS_BGFX
+    bgfx::Init init{};
+    init.type = bgfx::RendererType::Noop;
+    init.resolution.width = static_cast<uint32_t>(width_);
+    init.resolution.height = static_cast<uint32_t>(height_);
+    init.resolution.reset = BGFX_RESET_NONE;
+    if (bgfx::init(init)) {
+      enabled_ = true;
+      using_bgfx_ = true;
+      return true;
+    }
+#endif
+    return false;
+  }
+
+  SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width_, height_, 32, SDL_PIXELFORMAT_RGBA8888);
+  if (surface == nullptr) {
+    return false;
+  }
+  SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+  if (renderer == nullptr) {
+    SDL_FreeSurface(surface);
+    return false;
+  }
+
+  sdl_surface_ = surface;
+  sdl_renderer_ = renderer;
+  enabled_ = true;
+  return true;
+}
+
 void BasicRenderer::shutdown() {
 #ifdef ENGINE_HAS_BGFX
   if (using_bgfx_ && enabled_) {
@@ -91,6 +135,10 @@ void BasicRenderer::shutdown() {
     SDL_DestroyRenderer(reinterpret_cast<SDL_Renderer*>(sdl_renderer_));
     sdl_renderer_ = nullptr;
   }
+  if (sdl_surface_ != nullptr) {
+    SDL_FreeSurface(reinterpret_cast<SDL_Surface*>(sdl_surface_));
+    sdl_surface_ = nullptr;
+  }
 
   enabled_ = false;
   using_bgfx_ = false;
@@ -108,18 +156,33 @@ void BasicRenderer::resize(const int width, const int height) {
 }
 
 void BasicRenderer::begin_frame(const uint32_t clear_color_rgba) {
-  draw_calls_ = 0;
+  const Clock::time_point start = Clock::now();
+  const uint64_t frame_index = frame_stats_.frame_index + 1U;
+  frame_stats_ = RenderStats{};
+  frame_stats_.frame_index = frame_index;
+  bound_geometry_ = nullptr;
+  if (capture_ != nullptr) {
+    capture_->begin_frame(frame_index, clear_color_rgba);
+  }
+  frame_allocator_.begin_frame();
+  cluster_culler_.reset_stats();
 
+  RenderPassStats& clear_pass = frame_stats_.pass(RenderPass::Clear);
 #ifdef ENGINE_HAS_BGFX
   if (using_bgfx_ && enabled_) {
     bgfx::setViewRect(0, 0, 0, static_cast<uint16_t>(width_), static_cast<uint16_t>(height_));
     bgfx::setViewClear(0, BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH, clear_color_rgba, 1.0F, 0);
     bgfx::touch(0);
+    clear_pass.draws = 1;
+    clear_pass.state_changes = 1;
+    frame_stats_.begin_ms = elapsed_ms(start);
+    clear_pass.cpu_ms = frame_stats_.begin_ms;
     return;
   }
 #endif
 
   if (!enabled_ || sdl_renderer_ == nullptr) {
+    frame_stats_.begin_ms = elapsed_ms(start);
     return;
   }
 
@@ -142,92 +205,193 @@ void BasicRenderer::begin_frame(const uint32_t clear_color_rgba) {
       40.0F,
   };
   SDL_RenderFillRectF(renderer, &center_rect);
+
+  // The clear plus the pulsing marker quad.
+  clear_pass.draws = 2;
+  clear_pass.instances = 1;
+  clear_pass.triangles = 2;
+  clear_pass.vertices = 4;
+  clear_pass.state_changes = 2;
+  frame_stats_.begin_ms = elapsed_ms(start);
+  clear_pass.cpu_ms = frame_stats_.begin_ms;
 }
 
-void BasicRenderer::submit_mesh(const assets::MeshData* mesh, const math::Mat4& world_matrix, const runtime::Camera& camera) {
-#ifdef ENGINE_HAS_BGFX
-  if (using_bgfx_ && enabled_) {
-    draw_calls_ += 1;
+void BasicRenderer::submit_mesh(const std::shared_ptr<const assets::MeshData>& mesh,
+                                const math::Mat4& world_matrix,
+                                const runtime::Camera& camera,
+                                const uint32_t lod) {
+  if (capture_ != nullptr) {
+    capture_->add_mesh(mesh, world_matrix, camera, lod);
+  }
+  if (!enabled_) {
     return;
   }
-#endif
 
-  if (!enabled_ || sdl_renderer_ == nullptr) {
+  const Clock::time_point start = Clock::now();
+  RenderPassStats& geometry_pass = frame_stats_.pass(RenderPass::Geometry);
+  const bool clustered = cluster_culling_ && mesh != nullptr && lod == 0U &&
+                         cluster_culler_.cull(*mesh, world_matrix, camera, &cluster_indices_);
+  if (clustered && cluster_indices_.empty()) {
+    geometry_pass.culled += 1;
+  } else {
+    constexpr math::Vec3 fallback_vertices[3] = {
+        {-0.35F, -0.30F, 0.20F},
+        {0.35F, -0.25F, -0.65F},
+        {0.0F, 0.40F, 0.10F},
+    };
+    constexpr uint32_t fallback_indices[3] = {0U, 1U, 2U};
+
+    const math::Vec3* vertices = fallback_vertices;
+    size_t vertex_count = 3;
+    const uint32_t* indices = fallback_indices;
+    size_t index_count = 3;
+    const void* geometry = fallback_vertices;
+    if (mesh != nullptr && assets::mesh_vertex_count(*mesh) >= 3) {
+      // Compressed meshes decode into the same scratch every draw, so they are told apart by their streams.
+      vertices = assets::mesh_positions(*mesh, &decoded_positions_);
+      vertex_count = assets::mesh_vertex_count(*mesh);
+      geometry = mesh->compressed != nullptr ? static_cast<const void*>(mesh->compressed.get()) : vertices;
+      const std::vector<uint32_t>& lod_indices = clustered ? cluster_indices_ : assets::mesh_lod_indices(*mesh, lod);
+      if (lod_indices.size() >= 3) {
+        indices = lod_indices.data();
+        index_count = lod_indices.size();
+      }
+    }
+
+    // The bgfx path only records the draw for now.
+    bool drawn = using_bgfx_;
+    if (!drawn && sdl_renderer_ != nullptr) {
+      drawn = draw_indexed(vertices, vertex_count, indices, index_count, world_matrix, camera);
+    }
+    if (drawn) {
+      record_draw(geometry, vertex_count, index_count);
+    }
+  }
+
+  const double ms = elapsed_ms(start);
+  geometry_pass.cpu_ms += ms;
+  frame_stats_.submit_ms += ms;
+}
+
+void BasicRenderer::submit_model(const assets::ModelData* model,
+                                 const assets::GeometryPool& pool,
+                                 const math::Mat4& world_matrix,
+                                 const runtime::Camera& camera) {
+  if (model == nullptr || !enabled_) {
     return;
   }
 
-  constexpr math::Vec3 fallback_vertices[3] = {
-      {-0.35F, -0.30F, 0.20F},
-      {0.35F, -0.25F, -0.65F},
-      {0.0F, 0.40F, 0.10F},
-  };
-  constexpr uint32_t fallback_indices[3] = {0U, 1U, 2U};
-
-  const math::Vec3* vertices = fallback_vertices;
-  size_t vertex_count = 3;
-  const uint32_t* indices = fallback_indices;
-  size_t index_count = 3;
-  if (mesh != nullptr && mesh->vertices.size() >= 3) {
-    vertices = &mesh->vertices[0].position;
-    vertex_count = mesh->vertices.size();
-    if (mesh->indices.size() >= 3) {
-      indices = mesh->indices.data();
-      index_count = mesh->indices.size();
+  const Clock::time_point start = Clock::now();
+  // All submeshes index into the same pool streams; only the ranges change per draw.
+  const math::Vec3* pool_vertices = pool.vertices().empty() ? nullptr : &pool.vertices()[0].position;
+  for (const assets::Submesh& submesh : model->submeshes) {
+    const assets::GeometryRange* range = pool.range(submesh.geometry);
+    if (range == nullptr || pool_vertices == nullptr || range->index_count < 3U) {
+      continue;
     }
+
+    bool drawn = using_bgfx_;
+    if (!drawn && sdl_renderer_ != nullptr) {
+      drawn = draw_indexed(pool_vertices + range->vertex_offset,
+                           range->vertex_count,
+                           pool.indices().data() + range->index_offset,
+                           range->index_count,
+                           world_matrix,
+                           camera);
+    }
+    if (drawn) {
+      record_draw(pool_vertices, range->vertex_count, range->index_count);
+    }
+  }
+
+  const double ms = elapsed_ms(start);
+  frame_stats_.pass(RenderPass::Geometry).cpu_ms += ms;
+  frame_stats_.submit_ms += ms;
+}
+
+void BasicRenderer::add_culled(const uint32_t count) {
+  if (capture_ != nullptr) {
+    capture_->add_culled(count);
+  }
+  if (enabled_) {
+    frame_stats_.pass(RenderPass::Geometry).culled += count;
   }
+}
 
+void BasicRenderer::record_draw(const void* geometry, const size_t vertex_count, const size_t index_count) {
+  RenderPassStats& geometry_pass = frame_stats_.pass(RenderPass::Geometry);
+  geometry_pass.draws += 1;
+  geometry_pass.instances += 1;
+  geometry_pass.triangles += index_count / 3U;
+  geometry_pass.vertices += vertex_count;
+  if (geometry != bound_geometry_) {
+    geometry_pass.state_changes += 1;
+    bound_geometry_ = geometry;
+  }
+}
+
+bool BasicRenderer::draw_indexed(const math::Vec3* vertices,
+                                 const size_t vertex_count,
+                                 const uint32_t* indices,
+                                 const size_t index_count,
+                                 const math::Mat4& world_matrix,
+                                 const runtime::Camera& camera) {
   const math::Mat4 vp = math::multiply(camera.projection, camera.view);
   const math::Mat4 mvp = math::multiply(vp, world_matrix);
 
-  std::vector<SDL_Vertex> verts(vertex_count);
+  projected_vertices_.resize(vertex_count);
+  project_vertices(vertices, vertex_count, mvp, width_, height_, projected_vertices_.data());
+
+  // SDL copies the geometry during the call, so frame memory is enough.
+  const size_t vertex_bytes = vertex_count * sizeof(SDL_Vertex);
+  const size_t geometry_bytes = vertex_bytes + (index_count * sizeof(int));
+  const FrameAllocation geometry = frame_allocator_.allocate(geometry_bytes);
+  uint8_t* storage = geometry.data;
+  if (!geometry) {
+    overflow_vertices_.resize(geometry_bytes);
+    storage = overflow_vertices_.data();
+  }
+  auto* verts = reinterpret_cast<SDL_Vertex*>(storage);
+  auto* sdl_indices = reinterpret_cast<int*>(storage + vertex_bytes);
   for (size_t i = 0; i < vertex_count; ++i) {
-    const math::Vec4 model{vertices[i].x, vertices[i].y, vertices[i].z, 1.0F};
-    math::Vec4 clip = math::multiply_vec4(mvp, model);
-    if (std::fabs(clip.w) < 0.0001F) {
-      clip.w = (clip.w < 0.0F) ? -0.0001F : 0.0001F;
-    }
-
-    verts[i].position = to_screen(clip, width_, height_);
-
-    const float depth = std::clamp((clip.z / clip.w + 1.0F) * 0.5F, 0.0F, 1.0F);
-    const Uint8 shade = static_cast<Uint8>(220.0F - (depth * 100.0F));
+    const ScreenVertex& projected = projected_vertices_[i];
+    verts[i].position = SDL_FPoint{projected.x, projected.y};
+    const Uint8 shade = static_cast<Uint8>(220.0F - (projected.depth * 100.0F));
     verts[i].color = SDL_Color{255, shade, 90, 255};
     verts[i].tex_coord = SDL_FPoint{0.0F, 0.0F};
   }
 
-  std::vector<int> sdl_indices;
-  sdl_indices.reserve(index_count);
   for (size_t i = 0; i < index_count; ++i) {
     if (static_cast<size_t>(indices[i]) >= vertex_count) {
-      return;
+      return false;
     }
-    sdl_indices.push_back(static_cast<int>(indices[i]));
+    sdl_indices[i] = static_cast<int>(indices[i]);
   }
 
   SDL_Renderer* renderer = reinterpret_cast<SDL_Renderer*>(sdl_renderer_);
-  SDL_RenderGeometry(renderer,
-                     nullptr,
-                     verts.data(),
-                     static_cast<int>(verts.size()),
-                     sdl_indices.data(),
-                     static_cast<int>(sdl_indices.size()));
+  SDL_RenderGeometry(
+      renderer, nullptr, verts, static_cast<int>(vertex_count), sdl_indices, static_cast<int>(index_count));
 
-  draw_calls_ += static_cast<uint32_t>(sdl_indices.size() / 3U);
+  frame_stats_.pass(RenderPass::Geometry).bytes_uploaded += geometry_bytes;
+  return true;
 }
 
 void BasicRenderer::end_frame() {
+  const Clock::time_point start = Clock::now();
 #ifdef ENGINE_HAS_BGFX
   if (using_bgfx_ && enabled_) {
     bgfx::frame();
-    return;
   }
 #endif
 
-  if (!enabled_ || sdl_renderer_ == nullptr) {
-    return;
+  if (!using_bgfx_ && enabled_ && sdl_renderer_ != nullptr) {
+    SDL_RenderPresent(reinterpret_cast<SDL_Renderer*>(sdl_renderer_));
   }
 
-  SDL_RenderPresent(reinterpret_cast<SDL_Renderer*>(sdl_renderer_));
+  frame_allocator_.end_frame();
+
+  frame_stats_.end_ms = elapsed_ms(start);
+  last_frame_stats_ = frame_stats_;
 }
 
 bool BasicRenderer::enabled() const {
@@ -239,7 +403,31 @@ bool BasicRenderer::using_bgfx_backend() const {
 }
 
 uint32_t BasicRenderer::draw_calls() const {
-  return draw_calls_;
+  return frame_stats_.totals().draws;
+}
+
+const RenderStats& BasicRenderer::last_frame_stats() const {
+  return last_frame_stats_;
+}
+
+FrameAllocator& BasicRenderer::frame_allocator() {
+  return frame_allocator_;
+}
+
+const FrameAllocator& BasicRenderer::frame_allocator() const {
+  return frame_allocator_;
+}
+
+void BasicRenderer::set_capture(RenderCapture* capture) {
+  capture_ = capture;
+}
+
+void BasicRenderer::set_cluster_culling(const bool enabled) {
+  cluster_culling_ = enabled;
+}
+
+const ClusterCullStats& BasicRenderer::cluster_stats() const {
+  return cluster_culler_.stats();
 }
 
 } // namespace engine::renderer
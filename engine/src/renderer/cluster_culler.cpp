@@ -0,0 +1,87 @@
+#include "engine/renderer/cluster_culler.h"
+
+#include "engine/assets/meshlet_builder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace engine::renderer {
+
+namespace {
+
+// Beyond this scale ratio normals no longer transform with the world matrix, so cones are skipped.
+constexpr float max_cone_scale_skew = 1.01F;
+
+} // namespace
+
+void ClusterCuller::reset_stats() {
+  stats_ = {};
+}
+
+const ClusterCullStats& ClusterCuller::stats() const {
+  return stats_;
+}
+
+bool ClusterCuller::cull(const assets::MeshData& mesh,
+                         const math::Mat4& world,
+                         const runtime::Camera& camera,
+                         std::vector<uint32_t>* out_indices) {
+  if (mesh.meshlets.empty()) {
+    return false;
+  }
+
+  update_camera(camera);
+  out_indices->clear();
+
+  const float sx = math::length({world.m[0], world.m[1], world.m[2]});
+  const float sy = math::length({world.m[4], world.m[5], world.m[6]});
+  const float sz = math::length({world.m[8], world.m[9], world.m[10]});
+  const float max_scale = std::max(sx, std::max(sy, sz));
+  const float min_scale = std::min(sx, std::min(sy, sz));
+  const bool cones_usable = min_scale > 0.0F && max_scale <= min_scale * max_cone_scale_skew;
+  const float inv_scale = cones_usable ? 1.0F / max_scale : 0.0F;
+
+  stats_.meshes += 1;
+  for (const assets::Meshlet& meshlet : mesh.meshlets) {
+    stats_.clusters_tested += 1;
+    stats_.triangles_total += meshlet.triangle_count;
+
+    const math::Vec3 center = math::multiply_point(world, meshlet.center);
+    if (!math::sphere_in_frustum(frustum_, center, meshlet.radius * max_scale)) {
+      stats_.frustum_culled += 1;
+      continue;
+    }
+
+    if (cones_usable && meshlet.cone_cutoff <= 1.0F) {
+      const math::Vec3 apex = math::multiply_point(world, meshlet.cone_apex);
+      const math::Vec3& a = meshlet.cone_axis;
+      const math::Vec3 axis{
+          ((world.m[0] * a.x) + (world.m[4] * a.y) + (world.m[8] * a.z)) * inv_scale,
+          ((world.m[1] * a.x) + (world.m[5] * a.y) + (world.m[9] * a.z)) * inv_scale,
+          ((world.m[2] * a.x) + (world.m[6] * a.y) + (world.m[10] * a.z)) * inv_scale,
+      };
+      if (math::dot(math::normalize(apex - camera_position_), axis) >= meshlet.cone_cutoff) {
+        stats_.backface_culled += 1;
+        continue;
+      }
+    }
+
+    assets::append_meshlet_indices(mesh, meshlet, out_indices);
+    stats_.triangles_submitted += meshlet.triangle_count;
+  }
+  return true;
+}
+
+void ClusterCuller::update_camera(const runtime::Camera& camera) {
+  const math::Mat4 view_projection = math::multiply(camera.projection, camera.view);
+  if (has_camera_ && std::memcmp(view_projection.m, view_projection_.m, sizeof(view_projection.m)) == 0) {
+    return;
+  }
+  view_projection_ = view_projection;
+  frustum_ = math::frustum_from_matrix(view_projection_);
+  camera_position_ = camera.position;
+  has_camera_ = true;
+}
+
+} // namespace engine::renderer
@@ -0,0 +1,73 @@
+#include "engine/renderer/frame_allocator.h"
+
+#include <algorithm>
+
+namespace engine::renderer {
+
+namespace {
+
+constexpr size_t storage_alignment = 64U;
+
+constexpr size_t align_up(const size_t value, const size_t alignment) {
+  return (value + alignment - 1U) & ~(alignment - 1U);
+}
+
+} // namespace
+
+double FrameAllocatorStats::utilization() const {
+  return capacity_bytes > 0U ? static_cast<double>(used_bytes) / static_cast<double>(capacity_bytes) : 0.0;
+}
+
+FrameAllocator::FrameAllocator(const FrameAllocatorSettings& settings, std::pmr::memory_resource* resource)
+    : settings_(settings),
+      resource_(resource) {
+  settings_.bytes_per_frame = static_cast<uint32_t>(align_up(settings_.bytes_per_frame, storage_alignment));
+  stats_.capacity_bytes = settings_.bytes_per_frame;
+}
+
+FrameAllocator::~FrameAllocator() {
+  if (data_ != nullptr) {
+    resource_->deallocate(data_, settings_.bytes_per_frame, storage_alignment);
+  }
+}
+
+const FrameAllocatorSettings& FrameAllocator::settings() const {
+  return settings_;
+}
+
+void FrameAllocator::begin_frame() {
+  used_ = 0;
+  overflows_ = 0;
+}
+
+FrameAllocation FrameAllocator::allocate(const size_t bytes, const size_t alignment) {
+  const size_t capacity = settings_.bytes_per_frame;
+  const size_t offset = align_up(used_, alignment);
+  if (offset + bytes > capacity) {
+    overflows_ += 1;
+    return {};
+  }
+  if (data_ == nullptr) {
+    data_ = static_cast<uint8_t*>(resource_->allocate(capacity, storage_alignment));
+  }
+
+  used_ = static_cast<uint32_t>(offset + bytes);
+  FrameAllocation allocation;
+  allocation.data = data_ + offset;
+  allocation.offset = static_cast<uint32_t>(offset);
+  allocation.size = static_cast<uint32_t>(bytes);
+  return allocation;
+}
+
+void FrameAllocator::end_frame() {
+  stats_.used_bytes = used_;
+  stats_.peak_used_bytes = std::max(stats_.peak_used_bytes, used_);
+  stats_.overflows = overflows_;
+  stats_.total_overflows += overflows_;
+}
+
+const FrameAllocatorStats& FrameAllocator::stats() const {
+  return stats_;
+}
+
+} // namespace engine::renderer
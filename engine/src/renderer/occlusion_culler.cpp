@@ -0,0 +1,490 @@
+#include "engine/renderer/occlusion_culler.h"
+
+#include "engine/assets/vertex_format.h"
+#include "engine/core/thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <latch>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace engine::renderer {
+
+namespace {
+
+constexpr float near_w_epsilon = 0.0001F;
+constexpr uint32_t min_occluder_limit = 4U;
+constexpr uint32_t rows_per_band_min = 8U;
+constexpr uint32_t queries_per_job_min = 256U;
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(const Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+float max_axis_scale(const math::Mat4& world) {
+  const float sx = math::length({world.m[0], world.m[1], world.m[2]});
+  const float sy = math::length({world.m[4], world.m[5], world.m[6]});
+  const float sz = math::length({world.m[8], world.m[9], world.m[10]});
+  return std::max(sx, std::max(sy, sz));
+}
+
+float edge(const math::Vec3& a, const math::Vec3& b, const float px, const float py) {
+  return ((b.x - a.x) * (py - a.y)) - ((b.y - a.y) * (px - a.x));
+}
+
+} // namespace
+
+OcclusionCuller::OcclusionCuller(core::ThreadPool* pool, const OcclusionSettings& settings) : pool_(pool) {
+  set_settings(settings);
+}
+
+void OcclusionCuller::set_settings(const OcclusionSettings& settings) {
+  settings_ = settings;
+  // Rows are rasterized four pixels at a time.
+  settings_.width = std::max(4U, (settings_.width + 3U) & ~3U);
+  settings_.height = std::max(1U, settings_.height);
+  settings_.max_occluders = std::max(1U, settings_.max_occluders);
+  occluder_limit_ = settings_.max_occluders;
+  resize_levels();
+  built_ = false;
+}
+
+const OcclusionSettings& OcclusionCuller::settings() const {
+  return settings_;
+}
+
+void OcclusionCuller::begin_frame(const runtime::Camera& camera) {
+  view_projection_ = math::multiply(camera.projection, camera.view);
+  frustum_ = math::frustum_from_matrix(view_projection_);
+  camera_position_ = camera.position;
+  tan_half_fov_ = std::tan(std::max(camera.fov_radians, 0.01F) * 0.5F);
+
+  candidates_.clear();
+  triangles_.clear();
+  stats_ = {};
+  stats_.occluder_limit = occluder_limit_;
+  built_ = false;
+}
+
+void OcclusionCuller::add_occluder(const assets::MeshData& mesh, const math::Mat4& world) {
+  if (mesh.indices.size() < 3U) {
+    return;
+  }
+
+  const math::Vec3 local_center = (mesh.bounds.min + mesh.bounds.max) * 0.5F;
+  const math::Vec3 center = math::multiply_point(world, local_center);
+  const float radius = math::length(mesh.bounds.max - local_center) * max_axis_scale(world);
+  if (!math::sphere_in_frustum(frustum_, center, radius)) {
+    return;
+  }
+
+  stats_.occluder_candidates += 1;
+
+  // Projected sphere area relative to the screen; a sphere containing the camera covers everything.
+  const float distance = math::length(center - camera_position_);
+  float fraction = 1.0F;
+  if (distance > radius) {
+    const float ndc_radius = radius / (distance * tan_half_fov_);
+    fraction = std::min(1.0F, ndc_radius * ndc_radius * 0.7853981634F);
+  }
+  if (fraction < settings_.min_occluder_screen_fraction) {
+    return;
+  }
+
+  candidates_.push_back({&mesh, world, fraction});
+}
+
+void OcclusionCuller::build() {
+  const auto start = Clock::now();
+
+  std::sort(candidates_.begin(), candidates_.end(),
+            [](const Occluder& a, const Occluder& b) { return a.screen_fraction > b.screen_fraction; });
+  if (candidates_.size() > occluder_limit_) {
+    candidates_.resize(occluder_limit_);
+  }
+  stats_.occluders_rasterized = static_cast<uint32_t>(candidates_.size());
+
+  transform_occluders();
+  stats_.occluder_triangles = static_cast<uint32_t>(triangles_.size());
+
+  const uint32_t height = levels_[0].height;
+  uint32_t bands = 1;
+  if (pool_ != nullptr) {
+    bands = std::clamp(height / rows_per_band_min, 1U, pool_->thread_count() * 2U);
+  }
+  const uint32_t rows_per_band = (height + bands - 1U) / bands;
+  run_parallel(bands, [this, rows_per_band, height](const uint32_t band) {
+    const uint32_t row_begin = band * rows_per_band;
+    rasterize_rows(row_begin, std::min(height, row_begin + rows_per_band));
+  });
+  stats_.raster_ms = elapsed_ms(start);
+
+  const auto pyramid_start = Clock::now();
+  build_pyramid();
+  stats_.pyramid_ms = elapsed_ms(pyramid_start);
+  built_ = true;
+
+  // Trade occluder count for time: shrink quickly when over budget, grow back slowly.
+  const double spent = stats_.raster_ms + stats_.pyramid_ms;
+  if (spent > settings_.budget_ms * 0.9) {
+    occluder_limit_ = std::max(min_occluder_limit, (occluder_limit_ * 3U) / 4U);
+  } else if (spent < settings_.budget_ms * 0.5) {
+    occluder_limit_ = std::min(settings_.max_occluders, occluder_limit_ + 1U);
+  }
+}
+
+bool OcclusionCuller::is_visible(const assets::Aabb& local_bounds, const math::Mat4& world) {
+  const auto start = Clock::now();
+  const Visibility visibility = classify(local_bounds, world);
+  stats_.tested += 1;
+  stats_.frustum_culled += visibility == Visibility::FrustumCulled ? 1U : 0U;
+  stats_.occluded += visibility == Visibility::Occluded ? 1U : 0U;
+  stats_.test_ms += elapsed_ms(start);
+  return visibility == Visibility::Visible;
+}
+
+bool OcclusionCuller::is_visible(const assets::Aabb& world_bounds) {
+  return is_visible(world_bounds, math::identity());
+}
+
+void OcclusionCuller::test(const std::span<const OcclusionQuery> queries, std::vector<uint8_t>* out_visible) {
+  const auto start = Clock::now();
+  out_visible->resize(queries.size());
+
+  const auto count = static_cast<uint32_t>(queries.size());
+  uint32_t jobs = 1;
+  if (pool_ != nullptr) {
+    jobs = std::clamp(count / queries_per_job_min, 1U, pool_->thread_count() * 2U);
+  }
+  const uint32_t per_job = (count + jobs - 1U) / jobs;
+  std::vector<uint32_t> frustum_culled(jobs, 0U);
+  std::vector<uint32_t> occluded(jobs, 0U);
+
+  run_parallel(jobs, [&](const uint32_t job) {
+    const uint32_t end = std::min(count, (job + 1U) * per_job);
+    for (uint32_t i = job * per_job; i < end; ++i) {
+      const Visibility visibility = classify(queries[i].bounds, queries[i].world);
+      (*out_visible)[i] = visibility == Visibility::Visible ? 1U : 0U;
+      frustum_culled[job] += visibility == Visibility::FrustumCulled ? 1U : 0U;
+      occluded[job] += visibility == Visibility::Occluded ? 1U : 0U;
+    }
+  });
+
+  stats_.tested += count;
+  for (uint32_t job = 0; job < jobs; ++job) {
+    stats_.frustum_culled += frustum_culled[job];
+    stats_.occluded += occluded[job];
+  }
+  stats_.test_ms += elapsed_ms(start);
+}
+
+const OcclusionStats& OcclusionCuller::stats() const {
+  return stats_;
+}
+
+uint32_t OcclusionCuller::pyramid_levels() const {
+  return static_cast<uint32_t>(levels_.size());
+}
+
+const float* OcclusionCuller::pyramid_level(const uint32_t level, uint32_t* out_width, uint32_t* out_height) const {
+  if (level >= levels_.size()) {
+    return nullptr;
+  }
+  if (out_width != nullptr) {
+    *out_width = levels_[level].width;
+  }
+  if (out_height != nullptr) {
+    *out_height = levels_[level].height;
+  }
+  return levels_[level].depth.data();
+}
+
+OcclusionCuller::Visibility OcclusionCuller::classify(const assets::Aabb& local_bounds, const math::Mat4& world) const {
+  math::Vec3 world_min;
+  math::Vec3 world_max;
+  math::transform_aabb(world, local_bounds.min, local_bounds.max, &world_min, &world_max);
+  if (!math::aabb_in_frustum(frustum_, world_min, world_max)) {
+    return Visibility::FrustumCulled;
+  }
+  if (!built_ || triangles_.empty()) {
+    return Visibility::Visible;
+  }
+
+  const math::Mat4 mvp = math::multiply(view_projection_, world);
+  float min_x = 1.0F;
+  float max_x = -1.0F;
+  float min_y = 1.0F;
+  float max_y = -1.0F;
+  float min_z = 1.0F;
+  for (uint32_t corner = 0; corner < 8U; ++corner) {
+    const math::Vec4 local{
+        (corner & 1U) != 0U ? local_bounds.max.x : local_bounds.min.x,
+        (corner & 2U) != 0U ? local_bounds.max.y : local_bounds.min.y,
+        (corner & 4U) != 0U ? local_bounds.max.z : local_bounds.min.z,
+        1.0F,
+    };
+    const math::Vec4 clip = math::multiply_vec4(mvp, local);
+    // Bounds reaching behind the near plane cannot be projected conservatively.
+    if (clip.w <= near_w_epsilon) {
+      return Visibility::Visible;
+    }
+    const float inv_w = 1.0F / clip.w;
+    min_x = std::min(min_x, clip.x * inv_w);
+    max_x = std::max(max_x, clip.x * inv_w);
+    min_y = std::min(min_y, clip.y * inv_w);
+    max_y = std::max(max_y, clip.y * inv_w);
+    min_z = std::min(min_z, clip.z * inv_w);
+  }
+
+  const Level& base = levels_[0];
+  const auto fw = static_cast<float>(base.width);
+  const auto fh = static_cast<float>(base.height);
+  const auto to_px = [](const float value, const float limit) {
+    return static_cast<int>(std::clamp(std::floor(value), 0.0F, limit - 1.0F));
+  };
+  const int x0 = to_px(((min_x * 0.5F) + 0.5F) * fw, fw);
+  const int x1 = to_px(((max_x * 0.5F) + 0.5F) * fw, fw);
+  const int y0 = to_px((0.5F - (max_y * 0.5F)) * fh, fh);
+  const int y1 = to_px((0.5F - (min_y * 0.5F)) * fh, fh);
+
+  // Coarsest level at which the footprint spans at most two texels per axis.
+  uint32_t level = 0;
+  const int extent = std::max(x1 - x0, y1 - y0);
+  while ((extent >> level) > 1 && level + 1U < levels_.size()) {
+    level += 1;
+  }
+
+  const Level& hiz = levels_[level];
+  const int lx0 = x0 >> level;
+  const int ly0 = y0 >> level;
+  const int lx1 = std::min(x1 >> level, static_cast<int>(hiz.width) - 1);
+  const int ly1 = std::min(y1 >> level, static_cast<int>(hiz.height) - 1);
+  float occluder_depth = 0.0F;
+  for (int y = ly0; y <= ly1; ++y) {
+    const float* row = hiz.depth.data() + (static_cast<size_t>(y) * hiz.width);
+    for (int x = lx0; x <= lx1; ++x) {
+      occluder_depth = std::max(occluder_depth, row[x]);
+    }
+  }
+  return min_z > occluder_depth ? Visibility::Occluded : Visibility::Visible;
+}
+
+template <typename Job>
+void OcclusionCuller::run_parallel(const uint32_t job_count, const Job& job) {
+  if (pool_ == nullptr || job_count < 2U) {
+    for (uint32_t i = 0; i < job_count; ++i) {
+      job(i);
+    }
+    return;
+  }
+
+  // The calling thread takes job 0; must not be called from a job on the same pool.
+  std::latch done(static_cast<std::ptrdiff_t>(job_count - 1U));
+  for (uint32_t i = 1; i < job_count; ++i) {
+    pool_->submit([&job, &done, i] {
+      job(i);
+      done.count_down();
+    });
+  }
+  job(0);
+  done.wait();
+}
+
+void OcclusionCuller::transform_occluders() {
+  triangles_.clear();
+  const auto fw = static_cast<float>(levels_[0].width);
+  const auto fh = static_cast<float>(levels_[0].height);
+
+  scratch_.reset();
+  std::pmr::vector<math::Vec4> clip(&scratch_);
+  for (const Occluder& occluder : candidates_) {
+    const assets::MeshData& mesh = *occluder.mesh;
+    // The coarsest LOD is the cheapest shape that still covers roughly the same pixels.
+    const std::vector<uint32_t>& indices = assets::mesh_lod_indices(mesh, assets::mesh_lod_count(mesh) - 1U);
+    const math::Mat4 mvp = math::multiply(view_projection_, occluder.world);
+
+    const math::Vec3* positions = assets::mesh_positions(mesh, &decoded_positions_);
+    clip.resize(assets::mesh_vertex_count(mesh));
+    for (size_t i = 0; i < clip.size(); ++i) {
+      const math::Vec3& p = positions[i];
+      clip[i] = math::multiply_vec4(mvp, {p.x, p.y, p.z, 1.0F});
+    }
+
+    for (size_t i = 0; i + 2U < indices.size(); i += 3U) {
+      ScreenTriangle tri;
+      bool clipped = false;
+      for (uint32_t k = 0; k < 3U; ++k) {
+        const uint32_t index = indices[i + k];
+        if (index >= clip.size() || clip[index].w <= near_w_epsilon) {
+          clipped = true;
+          break;
+        }
+        // Dropping near-plane triangles only loses occlusion, never adds it.
+        const math::Vec4& c = clip[index];
+        const float inv_w = 1.0F / c.w;
+        tri.v[k] = {((c.x * inv_w * 0.5F) + 0.5F) * fw, (0.5F - (c.y * inv_w * 0.5F)) * fh, c.z * inv_w};
+      }
+      if (clipped) {
+        continue;
+      }
+
+      const float min_x = std::min(tri.v[0].x, std::min(tri.v[1].x, tri.v[2].x));
+      const float max_x = std::max(tri.v[0].x, std::max(tri.v[1].x, tri.v[2].x));
+      tri.min_y = std::min(tri.v[0].y, std::min(tri.v[1].y, tri.v[2].y));
+      tri.max_y = std::max(tri.v[0].y, std::max(tri.v[1].y, tri.v[2].y));
+      if (max_x < 0.0F || min_x >= fw || tri.max_y < 0.0F || tri.min_y >= fh) {
+        continue;
+      }
+
+      // Both windings are kept (occluders may be seen from inside); orient counter-clockwise in pixel space.
+      const float area = edge(tri.v[0], tri.v[1], tri.v[2].x, tri.v[2].y);
+      if (std::fabs(area) < 0.0001F) {
+        continue;
+      }
+      if (area < 0.0F) {
+        std::swap(tri.v[1], tri.v[2]);
+      }
+      triangles_.push_back(tri);
+    }
+  }
+}
+
+void OcclusionCuller::rasterize_rows(const uint32_t row_begin, const uint32_t row_end) {
+  Level& base = levels_[0];
+  const uint32_t width = base.width;
+  std::fill(base.depth.begin() + static_cast<std::ptrdiff_t>(row_begin) * width,
+            base.depth.begin() + static_cast<std::ptrdiff_t>(row_end) * width, 1.0F);
+
+  const auto band_top = static_cast<float>(row_begin);
+  const auto band_bottom = static_cast<float>(row_end);
+  for (const ScreenTriangle& tri : triangles_) {
+    if (tri.max_y < band_top || tri.min_y >= band_bottom) {
+      continue;
+    }
+
+    const math::Vec3& a = tri.v[0];
+    const math::Vec3& b = tri.v[1];
+    const math::Vec3& c = tri.v[2];
+    const float inv_area = 1.0F / edge(a, b, c.x, c.y);
+    const float dz1 = (b.z - a.z) * inv_area;
+    const float dz2 = (c.z - a.z) * inv_area;
+
+    // Start x rounded down to a four pixel group so rows stay aligned for SSE.
+    const float min_x = std::min(a.x, std::min(b.x, c.x));
+    const float max_x = std::max(a.x, std::max(b.x, c.x));
+    const uint32_t x_begin = static_cast<uint32_t>(std::max(0.0F, std::floor(min_x))) & ~3U;
+    const uint32_t x_end = std::min(width, static_cast<uint32_t>(std::max(0.0F, std::ceil(max_x))) + 1U);
+    const uint32_t y_begin = std::max(row_begin, static_cast<uint32_t>(std::max(0.0F, std::floor(tri.min_y))));
+    const uint32_t y_end = std::min(row_end, static_cast<uint32_t>(std::max(0.0F, std::ceil(tri.max_y))) + 1U);
+
+    // Edge functions for barycentrics of a, b and c; each is linear in x.
+    const float step0 = -(c.y - b.y);
+    const float step1 = -(a.y - c.y);
+    const float step2 = -(b.y - a.y);
+
+    for (uint32_t y = y_begin; y < y_end; ++y) {
+      const float py = static_cast<float>(y) + 0.5F;
+      const float px = static_cast<float>(x_begin) + 0.5F;
+      float e0 = edge(b, c, px, py);
+      float e1 = edge(c, a, px, py);
+      float e2 = edge(a, b, px, py);
+      float* row = base.depth.data() + (static_cast<size_t>(y) * width);
+
+#if defined(__SSE2__)
+      // The row width is a multiple of four, so the last group never runs past the row; lanes
+      // outside the triangle keep their depth.
+      const __m128 lane = _mm_set_ps(3.0F, 2.0F, 1.0F, 0.0F);
+      const __m128 step0_4 = _mm_set1_ps(step0 * 4.0F);
+      const __m128 step1_4 = _mm_set1_ps(step1 * 4.0F);
+      const __m128 step2_4 = _mm_set1_ps(step2 * 4.0F);
+      const __m128 zero = _mm_setzero_ps();
+      const __m128 z0 = _mm_set1_ps(a.z);
+      const __m128 dz1_4 = _mm_set1_ps(dz1);
+      const __m128 dz2_4 = _mm_set1_ps(dz2);
+      __m128 w0 = _mm_add_ps(_mm_set1_ps(e0), _mm_mul_ps(lane, _mm_set1_ps(step0)));
+      __m128 w1 = _mm_add_ps(_mm_set1_ps(e1), _mm_mul_ps(lane, _mm_set1_ps(step1)));
+      __m128 w2 = _mm_add_ps(_mm_set1_ps(e2), _mm_mul_ps(lane, _mm_set1_ps(step2)));
+      for (uint32_t x = x_begin; x < x_end; x += 4U) {
+        const __m128 inside =
+            _mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_and_ps(_mm_cmpge_ps(w1, zero), _mm_cmpge_ps(w2, zero)));
+        if (_mm_movemask_ps(inside) != 0) {
+          const __m128 z = _mm_add_ps(z0, _mm_add_ps(_mm_mul_ps(w1, dz1_4), _mm_mul_ps(w2, dz2_4)));
+          const __m128 current = _mm_loadu_ps(row + x);
+          const __m128 nearest = _mm_min_ps(current, z);
+          _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+        }
+        w0 = _mm_add_ps(w0, step0_4);
+        w1 = _mm_add_ps(w1, step1_4);
+        w2 = _mm_add_ps(w2, step2_4);
+      }
+#else
+      for (uint32_t x = x_begin; x < x_end; ++x) {
+        if (e0 >= 0.0F && e1 >= 0.0F && e2 >= 0.0F) {
+          const float z = a.z + (e1 * dz1) + (e2 * dz2);
+          row[x] = std::min(row[x], z);
+        }
+        e0 += step0;
+        e1 += step1;
+        e2 += step2;
+      }
+#endif
+    }
+  }
+}
+
+void OcclusionCuller::build_pyramid() {
+  for (size_t level = 1; level < levels_.size(); ++level) {
+    const Level& src = levels_[level - 1U];
+    Level& dst = levels_[level];
+    for (uint32_t y = 0; y < dst.height; ++y) {
+      const uint32_t sy0 = y * 2U;
+      const uint32_t sy1 = std::min(sy0 + 1U, src.height - 1U);
+      const float* row0 = src.depth.data() + (static_cast<size_t>(sy0) * src.width);
+      const float* row1 = src.depth.data() + (static_cast<size_t>(sy1) * src.width);
+      float* out = dst.depth.data() + (static_cast<size_t>(y) * dst.width);
+
+      uint32_t x = 0;
+#if defined(__SSE2__)
+      for (; (x * 2U) + 8U <= src.width; x += 4U) {
+        const __m128 lo = _mm_max_ps(_mm_loadu_ps(row0 + (x * 2U)), _mm_loadu_ps(row1 + (x * 2U)));
+        const __m128 hi = _mm_max_ps(_mm_loadu_ps(row0 + (x * 2U) + 4U), _mm_loadu_ps(row1 + (x * 2U) + 4U));
+        const __m128 even = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 odd = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(out + x, _mm_max_ps(even, odd));
+      }
+#endif
+      for (; x < dst.width; ++x) {
+        const uint32_t sx0 = x * 2U;
+        const uint32_t sx1 = std::min(sx0 + 1U, src.width - 1U);
+        out[x] = std::max(std::max(row0[sx0], row0[sx1]), std::max(row1[sx0], row1[sx1]));
+      }
+    }
+  }
+}
+
+void OcclusionCuller::resize_levels() {
+  levels_.clear();
+  uint32_t width = settings_.width;
+  uint32_t height = settings_.height;
+  while (true) {
+    Level level;
+    level.width = width;
+    level.height = height;
+    level.depth.assign(static_cast<size_t>(width) * height, 1.0F);
+    levels_.push_back(std::move(level));
+    if (width == 1U && height == 1U) {
+      break;
+    }
+    width = std::max(1U, (width + 1U) / 2U);
+    height = std::max(1U, (height + 1U) / 2U);
+  }
+}
+
+} // namespace engine::renderer
@@ -0,0 +1,386 @@
+#include "engine/renderer/render_capture.h"
+
+#include "engine/assets/vertex_format.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace engine::renderer {
+
+namespace {
+
+void set_error(std::string* out_error, const std::string& message) {
+  if (out_error != nullptr) {
+    *out_error = message;
+  }
+}
+
+template <typename T>
+void append_value(std::vector<uint8_t>* bytes, const T& value) {
+  const size_t offset = bytes->size();
+  bytes->resize(offset + sizeof(T));
+  std::memcpy(bytes->data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+void append_array(std::vector<uint8_t>* bytes, const std::vector<T>& values) {
+  append_value(bytes, static_cast<uint32_t>(values.size()));
+  const size_t offset = bytes->size();
+  bytes->resize(offset + (values.size() * sizeof(T)));
+  if (!values.empty()) {
+    std::memcpy(bytes->data() + offset, values.data(), values.size() * sizeof(T));
+  }
+}
+
+// Smallest encodings, used to bound the header counts before allocating.
+constexpr size_t min_mesh_bytes = (6U * sizeof(uint32_t)) + sizeof(assets::Aabb); // empty arrays and bounds
+constexpr size_t min_frame_bytes = 3U * sizeof(uint32_t);
+
+// Whether count records of at least record_bytes each fit in the bytes left.
+bool fits(const uint64_t count, const size_t record_bytes, const size_t remaining) {
+  return count <= remaining / record_bytes;
+}
+
+class ByteReader {
+public:
+  explicit ByteReader(const std::vector<uint8_t>& bytes) : bytes_(bytes) {}
+
+  template <typename T>
+  bool read(T* out_value) {
+    if (bytes_.size() - offset_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(out_value, bytes_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  template <typename T>
+  bool read_array(std::vector<T>* out_values) {
+    uint32_t count = 0;
+    if (!read(&count) || (bytes_.size() - offset_) / sizeof(T) < count) {
+      return false;
+    }
+    out_values->resize(count);
+    if (count > 0U) {
+      std::memcpy(out_values->data(), bytes_.data() + offset_, count * sizeof(T));
+    }
+    offset_ += count * sizeof(T);
+    return true;
+  }
+
+  size_t remaining() const {
+    return bytes_.size() - offset_;
+  }
+
+  bool at_end() const {
+    return offset_ == bytes_.size();
+  }
+
+private:
+  const std::vector<uint8_t>& bytes_;
+  size_t offset_ = 0;
+};
+
+void append_mesh(std::vector<uint8_t>* bytes, const assets::MeshData& mesh) {
+  append_array(bytes, mesh.vertices);
+  append_array(bytes, mesh.indices);
+  append_value(bytes, static_cast<uint32_t>(mesh.lods.size()));
+  for (const assets::MeshLod& lod : mesh.lods) {
+    append_value(bytes, lod.error);
+    append_array(bytes, lod.indices);
+  }
+  append_array(bytes, mesh.meshlets);
+  append_array(bytes, mesh.meshlet_vertices);
+  append_array(bytes, mesh.meshlet_triangles);
+  append_value(bytes, mesh.bounds);
+}
+
+bool indices_in_range(const std::vector<uint32_t>& indices, const size_t limit) {
+  return std::all_of(indices.begin(), indices.end(), [limit](const uint32_t index) { return index < limit; });
+}
+
+// The renderer indexes vertices and meshlet arrays straight from these values, so every
+// offset, count and index is checked against the array it points into.
+bool meshlets_valid(const assets::MeshData& mesh) {
+  if (!indices_in_range(mesh.meshlet_vertices, mesh.vertices.size())) {
+    return false;
+  }
+  for (const assets::Meshlet& meshlet : mesh.meshlets) {
+    const uint64_t vertex_end = static_cast<uint64_t>(meshlet.vertex_offset) + meshlet.vertex_count;
+    const uint64_t triangle_end =
+        static_cast<uint64_t>(meshlet.triangle_offset) + (static_cast<uint64_t>(meshlet.triangle_count) * 3U);
+    if (vertex_end > mesh.meshlet_vertices.size() || triangle_end > mesh.meshlet_triangles.size()) {
+      return false;
+    }
+    for (uint64_t i = meshlet.triangle_offset; i < triangle_end; ++i) {
+      if (mesh.meshlet_triangles[i] >= meshlet.vertex_count) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool read_mesh(ByteReader* reader, assets::MeshData* out_mesh) {
+  uint32_t lod_count = 0;
+  if (!reader->read_array(&out_mesh->vertices) || !reader->read_array(&out_mesh->indices) ||
+      !reader->read(&lod_count) || lod_count > assets::max_mesh_lods ||
+      !indices_in_range(out_mesh->indices, out_mesh->vertices.size())) {
+    return false;
+  }
+  out_mesh->lods.resize(lod_count);
+  for (assets::MeshLod& lod : out_mesh->lods) {
+    if (!reader->read(&lod.error) || !reader->read_array(&lod.indices) ||
+        !indices_in_range(lod.indices, out_mesh->vertices.size())) {
+      return false;
+    }
+  }
+  return reader->read_array(&out_mesh->meshlets) && reader->read_array(&out_mesh->meshlet_vertices) &&
+         reader->read_array(&out_mesh->meshlet_triangles) && reader->read(&out_mesh->bounds) &&
+         meshlets_valid(*out_mesh);
+}
+
+} // namespace
+
+void RenderCapture::set_frame_range(const uint64_t first_frame, const uint64_t frame_count) {
+  first_frame_ = first_frame;
+  frame_limit_ = frame_count;
+}
+
+void RenderCapture::clear() {
+  recording_ = false;
+  frames_.clear();
+  draws_.clear();
+  cameras_.clear();
+  meshes_.clear();
+  mesh_index_.clear();
+}
+
+void RenderCapture::begin_frame(const uint64_t frame_index, const uint32_t clear_color) {
+  recording_ = frame_index >= first_frame_ && !complete();
+  if (!recording_) {
+    return;
+  }
+
+  CapturedFrame frame;
+  frame.clear_color = clear_color;
+  frame.first_draw = static_cast<uint32_t>(draws_.size());
+  frames_.push_back(frame);
+}
+
+void RenderCapture::add_mesh(const std::shared_ptr<const assets::MeshData>& mesh,
+                             const math::Mat4& world,
+                             const runtime::Camera& camera,
+                             const uint32_t lod) {
+  if (!recording_) {
+    return;
+  }
+
+  CapturedDraw draw;
+  draw.world = world;
+  draw.lod = lod;
+  if (mesh != nullptr) {
+    const auto [it, inserted] = mesh_index_.try_emplace(mesh, static_cast<uint32_t>(meshes_.size()));
+    if (inserted) {
+      // Captures store float vertices so replays do not depend on the quantized layout.
+      if (mesh->compressed != nullptr) {
+        auto decoded = std::make_shared<assets::MeshData>(*mesh);
+        assets::decompress_vertex_streams(decoded.get());
+        meshes_.push_back(std::move(decoded));
+      } else {
+        meshes_.push_back(mesh);
+      }
+    }
+    draw.mesh = it->second;
+  }
+
+  CapturedCamera captured;
+  captured.position = camera.position;
+  captured.forward = camera.forward;
+  captured.view = camera.view;
+  captured.projection = camera.projection;
+  captured.viewport_width = camera.viewport_width();
+  captured.viewport_height = camera.viewport_height();
+  // Every draw of a frame normally shares one camera.
+  if (cameras_.empty() || std::memcmp(&cameras_.back(), &captured, sizeof(CapturedCamera)) != 0) {
+    cameras_.push_back(captured);
+  }
+  draw.camera = static_cast<uint32_t>(cameras_.size() - 1U);
+
+  draws_.push_back(draw);
+  frames_.back().draw_count += 1;
+}
+
+void RenderCapture::add_culled(const uint32_t count) {
+  if (recording_) {
+    frames_.back().culled += count;
+  }
+}
+
+bool RenderCapture::complete() const {
+  return frame_limit_ > 0U && frames_.size() >= frame_limit_;
+}
+
+size_t RenderCapture::frame_count() const {
+  return frames_.size();
+}
+
+const CapturedFrame& RenderCapture::frame(const size_t index) const {
+  return frames_[index];
+}
+
+std::span<const CapturedDraw> RenderCapture::draws(const CapturedFrame& frame) const {
+  return {draws_.data() + frame.first_draw, frame.draw_count};
+}
+
+size_t RenderCapture::draw_count() const {
+  return draws_.size();
+}
+
+size_t RenderCapture::mesh_count() const {
+  return meshes_.size();
+}
+
+uint32_t RenderCapture::camera_count() const {
+  return static_cast<uint32_t>(cameras_.size());
+}
+
+const std::shared_ptr<const assets::MeshData>& RenderCapture::mesh(const uint32_t index) const {
+  static const std::shared_ptr<const assets::MeshData> no_mesh;
+  return index < meshes_.size() ? meshes_[index] : no_mesh;
+}
+
+const CapturedCamera& RenderCapture::camera(const uint32_t index) const {
+  return cameras_[index];
+}
+
+runtime::Camera RenderCapture::make_camera(const uint32_t index) const {
+  const CapturedCamera& captured = cameras_[index];
+  runtime::Camera camera;
+  camera.set_viewport(captured.viewport_width, captured.viewport_height);
+  camera.position = captured.position;
+  camera.forward = captured.forward;
+  camera.view = captured.view;
+  camera.projection = captured.projection;
+  return camera;
+}
+
+bool RenderCapture::save(const std::string& path, std::string* out_error) const {
+  std::vector<uint8_t> bytes;
+  bytes.reserve(sizeof(RenderCaptureHeader) + (cameras_.size() * sizeof(CapturedCamera)) +
+                (frames_.size() * min_frame_bytes) + (draws_.size() * sizeof(CapturedDraw)));
+
+  RenderCaptureHeader header;
+  header.mesh_count = static_cast<uint32_t>(meshes_.size());
+  header.camera_count = static_cast<uint32_t>(cameras_.size());
+  header.frame_count = static_cast<uint32_t>(frames_.size());
+  header.draw_count = static_cast<uint32_t>(draws_.size());
+  append_value(&bytes, header);
+
+  for (const std::shared_ptr<const assets::MeshData>& mesh : meshes_) {
+    append_mesh(&bytes, *mesh);
+  }
+  for (const CapturedCamera& camera : cameras_) {
+    append_value(&bytes, camera);
+  }
+  for (const CapturedFrame& frame : frames_) {
+    append_value(&bytes, frame.clear_color);
+    append_value(&bytes, frame.culled);
+    append_value(&bytes, frame.draw_count);
+    for (const CapturedDraw& draw : draws(frame)) {
+      append_value(&bytes, draw);
+    }
+  }
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    set_error(out_error, "Failed to create render capture: " + path);
+    return false;
+  }
+  out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  if (!out.good()) {
+    set_error(out_error, "Failed to write render capture: " + path);
+    return false;
+  }
+  return true;
+}
+
+bool RenderCapture::load(const std::string& path, std::string* out_error) {
+  clear();
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    set_error(out_error, "Failed to open render capture: " + path);
+    return false;
+  }
+  const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  ByteReader reader(bytes);
+  RenderCaptureHeader header;
+  if (!reader.read(&header) || header.magic != render_capture_magic || header.version != render_capture_version) {
+    set_error(out_error, "Not a render capture: " + path);
+    return false;
+  }
+
+  const auto fail = [this, &path, out_error] {
+    clear();
+    set_error(out_error, "Corrupt render capture: " + path);
+    return false;
+  };
+
+  // Counts come from the file; each is checked against the bytes left before anything is allocated.
+  if (!fits(header.mesh_count, min_mesh_bytes, reader.remaining())) {
+    return fail();
+  }
+  meshes_.reserve(header.mesh_count);
+  for (uint32_t m = 0; m < header.mesh_count; ++m) {
+    auto mesh = std::make_shared<assets::MeshData>();
+    if (!read_mesh(&reader, mesh.get())) {
+      return fail();
+    }
+    meshes_.push_back(std::move(mesh));
+  }
+  if (!fits(header.camera_count, sizeof(CapturedCamera), reader.remaining())) {
+    return fail();
+  }
+  cameras_.resize(header.camera_count);
+  for (CapturedCamera& camera : cameras_) {
+    if (!reader.read(&camera)) {
+      return fail();
+    }
+  }
+
+  const uint64_t frame_bytes = static_cast<uint64_t>(header.frame_count) * min_frame_bytes;
+  if (frame_bytes > reader.remaining() ||
+      !fits(header.draw_count, sizeof(CapturedDraw), reader.remaining() - frame_bytes)) {
+    return fail();
+  }
+  frames_.reserve(header.frame_count);
+  draws_.reserve(header.draw_count);
+  for (uint32_t f = 0; f < header.frame_count; ++f) {
+    CapturedFrame frame;
+    frame.first_draw = static_cast<uint32_t>(draws_.size());
+    if (!reader.read(&frame.clear_color) || !reader.read(&frame.culled) || !reader.read(&frame.draw_count)) {
+      return fail();
+    }
+    for (uint32_t d = 0; d < frame.draw_count; ++d) {
+      CapturedDraw draw;
+      if (!reader.read(&draw) || draw.camera >= cameras_.size() ||
+          (draw.mesh != captured_no_mesh && draw.mesh >= meshes_.size())) {
+        return fail();
+      }
+      draws_.push_back(draw);
+    }
+    frames_.push_back(frame);
+  }
+
+  if (draws_.size() != header.draw_count || !reader.at_end()) {
+    return fail();
+  }
+  return true;
+}
+
+} // namespace engine::renderer
@@ -0,0 +1,35 @@
+#include "engine/renderer/render_stats.h"
+
+namespace engine::renderer {
+
+const char* render_pass_name(const RenderPass pass) {
+  switch (pass) {
+  case RenderPass::Clear:
+    return "clear";
+  case RenderPass::Geometry:
+    return "geometry";
+  default:
+    return "unknown";
+  }
+}
+
+void RenderPassStats::accumulate(const RenderPassStats& other) {
+  draws += other.draws;
+  instances += other.instances;
+  triangles += other.triangles;
+  vertices += other.vertices;
+  culled += other.culled;
+  bytes_uploaded += other.bytes_uploaded;
+  state_changes += other.state_changes;
+  cpu_ms += other.cpu_ms;
+}
+
+RenderPassStats RenderStats::totals() const {
+  RenderPassStats total;
+  for (const RenderPassStats& pass_stats : passes) {
+    total.accumulate(pass_stats);
+  }
+  return total;
+}
+
+} // namespace engine::renderer
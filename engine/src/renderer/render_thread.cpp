@@ -0,0 +1,136 @@
+#include "engine/renderer/render_thread.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace engine::renderer {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(const Clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+RenderThread::RenderThread(const uint32_t frames_in_flight)
+    : frames_in_flight_(std::max(1U, frames_in_flight)),
+      packets_(frames_in_flight_ + 1U),
+      states_(frames_in_flight_ + 1U, SlotState::Free) {}
+
+RenderThread::~RenderThread() {
+  stop();
+}
+
+bool RenderThread::start(StartFn on_start, RenderFn render, StopFn on_stop) {
+  if (started_) {
+    return false;
+  }
+
+  render_ = std::move(render);
+  on_stop_ = std::move(on_stop);
+  stopping_ = false;
+
+  std::promise<bool> started;
+  std::future<bool> result = started.get_future();
+  thread_ = std::thread([this, start_fn = std::move(on_start), promise = std::move(started)]() mutable {
+    thread_main(start_fn, &promise);
+  });
+  started_ = result.get();
+  if (!started_) {
+    thread_.join();
+  }
+  return started_;
+}
+
+void RenderThread::stop() {
+  if (!started_) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  queued_.notify_all();
+  thread_.join();
+  started_ = false;
+}
+
+bool RenderThread::running() const {
+  return started_;
+}
+
+FramePacket& RenderThread::acquire() {
+  const auto start = Clock::now();
+  std::unique_lock<std::mutex> lock(mutex_);
+  const auto free_slot = [this] { return std::find(states_.begin(), states_.end(), SlotState::Free); };
+  released_.wait(lock, [&] { return free_slot() != states_.end(); });
+
+  writing_ = static_cast<uint32_t>(free_slot() - states_.begin());
+  states_[writing_] = SlotState::Writing;
+  stats_.acquire_wait_ms = elapsed_ms(start);
+
+  FramePacket& packet = packets_[writing_];
+  packet.frame_index = next_frame_index_++;
+  packet.draws.clear();
+  return packet;
+}
+
+void RenderThread::submit() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    states_[writing_] = SlotState::Queued;
+    queue_.push_back(writing_);
+    stats_.frames_submitted += 1;
+    stats_.frames_in_flight = static_cast<uint32_t>(stats_.frames_submitted - stats_.frames_rendered);
+  }
+  queued_.notify_one();
+}
+
+RenderThreadStats RenderThread::stats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void RenderThread::thread_main(const StartFn& on_start, std::promise<bool>* started) {
+  const bool ok = !on_start || on_start();
+  started->set_value(ok);
+  if (!ok) {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queued_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      break;
+    }
+
+    const uint32_t slot = queue_.front();
+    queue_.pop_front();
+    states_[slot] = SlotState::Rendering;
+    lock.unlock();
+
+    const auto start = Clock::now();
+    render_(packets_[slot]);
+    const double render_ms = elapsed_ms(start);
+
+    lock.lock();
+    states_[slot] = SlotState::Free;
+    stats_.frames_rendered += 1;
+    stats_.render_ms = render_ms;
+    stats_.frames_in_flight = static_cast<uint32_t>(stats_.frames_submitted - stats_.frames_rendered);
+    released_.notify_one();
+  }
+  lock.unlock();
+
+  if (on_stop_) {
+    on_stop_();
+  }
+}
+
+} // namespace engine::renderer
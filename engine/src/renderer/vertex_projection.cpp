@@ -0,0 +1,33 @@
+#include "engine/renderer/vertex_projection.h"
+
+#include "engine/math/vec4.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::renderer {
+
+void project_vertices(const math::Vec3* vertices,
+                      const size_t count,
+                      const math::Mat4& mvp,
+                      const int width,
+                      const int height,
+                      ScreenVertex* out_vertices) {
+  const auto half_width = static_cast<float>(width) * 0.5F;
+  const auto half_height = static_cast<float>(height) * 0.5F;
+  for (size_t i = 0; i < count; ++i) {
+    const math::Vec4 model{vertices[i].x, vertices[i].y, vertices[i].z, 1.0F};
+    math::Vec4 clip = math::multiply_vec4(mvp, model);
+    if (std::fabs(clip.w) < 0.0001F) {
+      clip.w = (clip.w < 0.0F) ? -0.0001F : 0.0001F;
+    }
+
+    const float inv_w = 1.0F / clip.w;
+    ScreenVertex& out = out_vertices[i];
+    out.x = ((clip.x * inv_w) + 1.0F) * half_width;
+    out.y = (1.0F - (clip.y * inv_w)) * half_height;
+    out.depth = std::clamp(((clip.z * inv_w) + 1.0F) * 0.5F, 0.0F, 1.0F);
+  }
+}
+
+} // namespace engine::renderer
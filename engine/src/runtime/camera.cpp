@@ -39,6 +39,14 @@ void Camera::set_viewport(const int width, const int height) {
   projection_dirty_ = true;
 }
 
+int Camera::viewport_width() const {
+  return viewport_width_;
+}
+
+int Camera::viewport_height() const {
+  return viewport_height_;
+}
+
 void Camera::update_orientation(const input::InputState& input) {
   const math::Vec2 delta = input.mouseDelta();
   yaw_ += delta.x * mouse_sensitivity;
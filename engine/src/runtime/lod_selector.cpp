@@ -0,0 +1,99 @@
+#include "engine/runtime/lod_selector.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::runtime {
+
+namespace {
+
+constexpr uint64_t history_sweep_interval = 256U;
+
+float max_axis_scale(const math::Mat4& world) {
+  const float sx = math::length({world.m[0], world.m[1], world.m[2]});
+  const float sy = math::length({world.m[4], world.m[5], world.m[6]});
+  const float sz = math::length({world.m[8], world.m[9], world.m[10]});
+  return std::max(sx, std::max(sy, sz));
+}
+
+} // namespace
+
+void LodSelector::set_settings(const LodSettings& settings) {
+  settings_ = settings;
+}
+
+const LodSettings& LodSelector::settings() const {
+  return settings_;
+}
+
+void LodSelector::begin_frame(const Camera& camera) {
+  camera_position_ = camera.position;
+  near_plane_ = std::max(camera.near_plane, 0.0001F);
+  pixels_per_unit_at_one_ =
+      static_cast<float>(camera.viewport_height()) / (2.0F * std::tan(std::max(camera.fov_radians, 0.01F) * 0.5F));
+  threshold_ = std::max(0.0F, settings_.max_screen_error_pixels) * std::exp2(settings_.bias);
+
+  stats_ = {};
+  frame_ += 1;
+
+  if (frame_ % history_sweep_interval == 0U) {
+    std::erase_if(history_, [this](const auto& item) { return frame_ - item.second.last_frame > history_sweep_interval; });
+  }
+}
+
+uint32_t LodSelector::select(const Entity entity, const assets::MeshData& mesh, const math::Mat4& world) {
+  const uint32_t lod_count = assets::mesh_lod_count(mesh);
+
+  uint32_t lod = 0;
+  if (lod_count > 1U) {
+    const math::Vec3 local_center = (mesh.bounds.min + mesh.bounds.max) * 0.5F;
+    const float scale = max_axis_scale(world);
+    const float radius = math::length(mesh.bounds.max - local_center) * scale;
+    const float distance =
+        std::max(near_plane_, math::length(math::multiply_point(world, local_center) - camera_position_) - radius);
+
+    // Errors grow with the LOD index, so the scan can stop at the first level over the threshold.
+    uint32_t within = 0;
+    uint32_t within_hysteresis = 0;
+    const float coarsen_threshold = threshold_ * (1.0F - std::clamp(settings_.hysteresis, 0.0F, 0.95F));
+    for (uint32_t i = 1; i < lod_count; ++i) {
+      const float error = projected_error(assets::mesh_lod_error(mesh, i) * scale, distance);
+      if (error > threshold_) {
+        break;
+      }
+      within = i;
+      if (error <= coarsen_threshold) {
+        within_hysteresis = i;
+      }
+    }
+
+    lod = within;
+    const auto previous = history_.find(entity.id);
+    if (previous != history_.end() && previous->second.last_frame + 1U == frame_ && within > previous->second.lod) {
+      lod = std::max(previous->second.lod, within_hysteresis);
+    }
+  }
+
+  History& history = history_[entity.id];
+  if (history.last_frame + 1U == frame_ && history.lod != lod) {
+    stats_.transitions += 1;
+  }
+  history.lod = lod;
+  history.last_frame = frame_;
+
+  stats_.selected_per_lod[lod] += 1;
+  stats_.selections += 1;
+  stats_.triangles_selected += assets::mesh_lod_indices(mesh, lod).size() / 3U;
+  stats_.triangles_full_detail += mesh.indices.size() / 3U;
+  return lod;
+}
+
+const LodStats& LodSelector::stats() const {
+  return stats_;
+}
+
+float LodSelector::projected_error(const float world_error, const float distance) const {
+  return world_error * pixels_per_unit_at_one_ / distance;
+}
+
+} // namespace engine::runtime
@@ -1,17 +1,62 @@
 #include "engine/runtime/scene.h"
 
 #include <algorithm>
+#include <iterator>
+#include <utility>
 
 namespace engine::runtime {
 
+namespace {
+
+// Room for the value plus the links and cached hash a standard library hash map node may carry.
+// Bucket arrays are larger and go to the upstream resource.
+template <typename Key, typename Value>
+constexpr size_t map_node_size = (3U * sizeof(void*)) + sizeof(std::pair<const Key, Value>);
+
+constexpr size_t small_node_size = std::max({map_node_size<uint32_t, size_t>,
+                                             map_node_size<uint32_t, MeshComponent>,
+                                             map_node_size<uint32_t, CameraComponent>});
+
+core::AllocatorStats combine(const core::AllocatorStats& a, const core::AllocatorStats& b) {
+  core::AllocatorStats out;
+  out.capacity_bytes = a.capacity_bytes + b.capacity_bytes;
+  out.used_bytes = a.used_bytes + b.used_bytes;
+  out.peak_used_bytes = a.peak_used_bytes + b.peak_used_bytes;
+  out.free_bytes = a.free_bytes + b.free_bytes;
+  out.largest_free_bytes = std::max(a.largest_free_bytes, b.largest_free_bytes);
+  out.overhead_bytes = a.overhead_bytes + b.overhead_bytes;
+  out.live_allocations = a.live_allocations + b.live_allocations;
+  out.fallback_allocations = a.fallback_allocations + b.fallback_allocations;
+  return out;
+}
+
+} // namespace
+
+Scene::Scene(std::pmr::memory_resource* resource)
+    : transform_nodes_(map_node_size<uint32_t, Transform>, 256U, resource),
+      small_nodes_(small_node_size, 256U, resource),
+      nodes_(resource),
+      node_index_(&small_nodes_),
+      static_entities_(resource),
+      dynamic_entities_(resource),
+      transforms_(&transform_nodes_),
+      mesh_components_(&small_nodes_),
+      camera_components_(&small_nodes_) {}
+
 Entity Scene::create_entity(const std::optional<uint32_t> parent_id) {
   Entity e{next_entity_id_++};
+  node_index_[e.id] = nodes_.size();
   nodes_.push_back(Node{e, parent_id});
+  dynamic_entities_.push_back(e);
   transforms_[e.id] = Transform{};
   return e;
 }
 
 Transform& Scene::transform(const Entity entity) {
+  if (const Node* node = find_node(entity.id);
+      node != nullptr && (node->mobility == Mobility::Static || node->has_static_descendant)) {
+    static_revision_ += 1;
+  }
   return transforms_[entity.id];
 }
 
@@ -23,8 +68,54 @@ const Transform* Scene::find_transform(const Entity entity) const {
   return &it->second;
 }
 
-void Scene::add_mesh_component(const Entity entity, const MeshComponent mesh) {
-  mesh_components_[entity.id] = mesh;
+void Scene::set_mobility(const Entity entity, const Mobility mobility) {
+  Node* node = find_node(entity.id);
+  if (node == nullptr || node->mobility == mobility) {
+    return;
+  }
+
+  node->mobility = mobility;
+  std::pmr::vector<Entity>& from = mobility == Mobility::Static ? dynamic_entities_ : static_entities_;
+  std::pmr::vector<Entity>& to = mobility == Mobility::Static ? static_entities_ : dynamic_entities_;
+  // Searched from the back: mobility is usually set right after create_entity.
+  const auto it = std::find_if(from.rbegin(), from.rend(), [&entity](const Entity& e) { return e.id == entity.id; });
+  if (it != from.rend()) {
+    from.erase(std::next(it).base());
+  }
+  to.push_back(entity);
+
+  // Moving an ancestor moves the static entity too; the flag is never cleared, which only costs extra rebuilds.
+  if (mobility == Mobility::Static) {
+    for (Node* parent = node->parent_id ? find_node(*node->parent_id) : nullptr; parent != nullptr;
+         parent = parent->parent_id ? find_node(*parent->parent_id) : nullptr) {
+      parent->has_static_descendant = true;
+    }
+  }
+  static_revision_ += 1;
+}
+
+Mobility Scene::mobility(const Entity entity) const {
+  const Node* node = find_node(entity.id);
+  return node != nullptr ? node->mobility : Mobility::Dynamic;
+}
+
+const std::pmr::vector<Entity>& Scene::static_entities() const {
+  return static_entities_;
+}
+
+const std::pmr::vector<Entity>& Scene::dynamic_entities() const {
+  return dynamic_entities_;
+}
+
+uint64_t Scene::static_revision() const {
+  return static_revision_;
+}
+
+void Scene::add_mesh_component(const Entity entity, MeshComponent mesh) {
+  mesh_components_[entity.id] = std::move(mesh);
+  if (mobility(entity) == Mobility::Static) {
+    static_revision_ += 1;
+  }
 }
 
 const MeshComponent* Scene::find_mesh_component(const Entity entity) const {
@@ -56,7 +147,7 @@ std::vector<Entity> Scene::entities() const {
   return out;
 }
 
-bool Scene::compute_world_matrix(const Entity entity, math::Mat4* out_world) const {
+bool Scene::compute_world_matrix(const Entity entity, math::Mat4* out_world, const float alpha) const {
   if (out_world == nullptr) {
     return false;
   }
@@ -66,16 +157,11 @@ bool Scene::compute_world_matrix(const Entity entity, math::Mat4* out_world) con
     return false;
   }
 
-  Transform local = transform_it->second;
-  local.update_matrix();
-  math::Mat4 world = local.world_matrix;
+  math::Mat4 world = transform_it->second.interpolated_matrix(alpha);
 
   std::optional<uint32_t> parent_id;
-  for (const Node& node : nodes_) {
-    if (node.entity.id == entity.id) {
-      parent_id = node.parent_id;
-      break;
-    }
+  if (const Node* node = find_node(entity.id); node != nullptr) {
+    parent_id = node->parent_id;
   }
 
   while (parent_id.has_value()) {
@@ -84,24 +170,24 @@ bool Scene::compute_world_matrix(const Entity entity, math::Mat4* out_world) con
       break;
     }
 
-    Transform parent = parent_transform_it->second;
-    parent.update_matrix();
-    world = math::multiply(parent.world_matrix, world);
+    world = math::multiply(parent_transform_it->second.interpolated_matrix(alpha), world);
 
-    std::optional<uint32_t> next_parent;
-    for (const Node& node : nodes_) {
-      if (node.entity.id == *parent_id) {
-        next_parent = node.parent_id;
-        break;
-      }
-    }
-    parent_id = next_parent;
+    const Node* parent_node = find_node(*parent_id);
+    parent_id = parent_node != nullptr ? parent_node->parent_id : std::nullopt;
   }
 
   *out_world = world;
   return true;
 }
 
+void Scene::begin_simulation_step() {
+  for (const Entity entity : dynamic_entities_) {
+    if (const auto it = transforms_.find(entity.id); it != transforms_.end()) {
+      it->second.save_previous();
+    }
+  }
+}
+
 uint32_t Scene::entity_count() const {
   return static_cast<uint32_t>(nodes_.size());
 }
@@ -110,4 +196,18 @@ uint32_t Scene::mesh_component_count() const {
   return static_cast<uint32_t>(mesh_components_.size());
 }
 
+core::AllocatorStats Scene::node_pool_stats() const {
+  return combine(transform_nodes_.stats(), small_nodes_.stats());
+}
+
+Scene::Node* Scene::find_node(const uint32_t id) {
+  const auto it = node_index_.find(id);
+  return it != node_index_.end() ? &nodes_[it->second] : nullptr;
+}
+
+const Scene::Node* Scene::find_node(const uint32_t id) const {
+  const auto it = node_index_.find(id);
+  return it != node_index_.end() ? &nodes_[it->second] : nullptr;
+}
+
 } // namespace engine::runtime
@@ -0,0 +1,60 @@
+#include "engine/runtime/static_draw_cache.h"
+
+#include "engine/math/frustum.h"
+
+#include <algorithm>
+
+namespace engine::runtime {
+
+bool StaticDrawCache::update(const Scene& scene, const assets::AssetManager& assets) {
+  if (valid_ && scene_revision_ == scene.static_revision() && asset_revision_ == assets.mesh_data_revision()) {
+    return false;
+  }
+
+  packets_.clear();
+  for (const Entity entity : scene.static_entities()) {
+    const MeshComponent* mesh_component = scene.find_mesh_component(entity);
+    if (mesh_component == nullptr) {
+      continue;
+    }
+
+    DrawPacket packet;
+    if (!scene.compute_world_matrix(entity, &packet.world)) {
+      continue;
+    }
+    packet.entity = entity;
+    packet.mesh = mesh_component->mesh.handle();
+    packet.mesh_data = assets.get_mesh(packet.mesh);
+    if (packet.mesh_data != nullptr) {
+      math::transform_aabb(packet.world, packet.mesh_data->bounds.min, packet.mesh_data->bounds.max,
+                           &packet.world_bounds.min, &packet.world_bounds.max);
+    } else {
+      const math::Vec3 origin = math::multiply_point(packet.world, {0.0F, 0.0F, 0.0F});
+      packet.world_bounds = {origin, origin};
+    }
+    packet.sort_key = (static_cast<uint64_t>(packet.mesh.index) << 32U) | entity.id;
+    packets_.push_back(packet);
+  }
+  std::sort(packets_.begin(), packets_.end(),
+            [](const DrawPacket& a, const DrawPacket& b) { return a.sort_key < b.sort_key; });
+
+  scene_revision_ = scene.static_revision();
+  asset_revision_ = assets.mesh_data_revision();
+  rebuild_count_ += 1;
+  valid_ = true;
+  return true;
+}
+
+void StaticDrawCache::invalidate() {
+  valid_ = false;
+}
+
+const std::vector<DrawPacket>& StaticDrawCache::packets() const {
+  return packets_;
+}
+
+uint64_t StaticDrawCache::rebuild_count() const {
+  return rebuild_count_;
+}
+
+} // namespace engine::runtime
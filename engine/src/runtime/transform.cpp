@@ -15,4 +15,21 @@ void Transform::update_matrix() {
   dirty_ = false;
 }
 
+void Transform::save_previous() {
+  previous_position_ = position;
+  previous_rotation_ = rotation;
+  previous_scale_ = scale;
+  has_previous_ = true;
+}
+
+math::Mat4 Transform::interpolated_matrix(const float alpha) const {
+  if (!has_previous_ || alpha >= 1.0F) {
+    return dirty_ ? math::trs(position, rotation, scale) : world_matrix;
+  }
+  // Euler angles are blended directly; steps are short enough that wrap-around is the only artefact.
+  return math::trs(math::lerp(previous_position_, position, alpha),
+                   math::lerp(previous_rotation_, rotation, alpha),
+                   math::lerp(previous_scale_, scale, alpha));
+}
+
 } // namespace engine::runtime
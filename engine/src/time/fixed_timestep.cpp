@@ -0,0 +1,52 @@
+#include "engine/time/fixed_timestep.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace engine::time {
+
+FixedTimestep::FixedTimestep(const FixedStepSettings& settings) {
+  set_settings(settings);
+}
+
+void FixedTimestep::set_settings(const FixedStepSettings& settings) {
+  settings_ = settings;
+  settings_.tick_rate_hz = std::clamp(settings_.tick_rate_hz, 1.0, 10000.0);
+  settings_.max_steps_per_frame = std::max(1U, settings_.max_steps_per_frame);
+  step_seconds_ = 1.0 / settings_.tick_rate_hz;
+  accumulator_ = std::min(accumulator_, step_seconds_);
+}
+
+const FixedStepSettings& FixedTimestep::settings() const {
+  return settings_;
+}
+
+uint32_t FixedTimestep::advance(const double frame_seconds) {
+  accumulator_ += std::max(0.0, frame_seconds);
+
+  auto steps = static_cast<uint64_t>(std::floor(accumulator_ / step_seconds_));
+  accumulator_ -= static_cast<double>(steps) * step_seconds_;
+  if (steps > settings_.max_steps_per_frame) {
+    stats_.dropped_steps += steps - settings_.max_steps_per_frame;
+    steps = settings_.max_steps_per_frame;
+  }
+
+  stats_.steps_this_frame = static_cast<uint32_t>(steps);
+  stats_.total_steps += steps;
+  stats_.alpha = std::clamp(accumulator_ / step_seconds_, 0.0, 1.0);
+  return stats_.steps_this_frame;
+}
+
+double FixedTimestep::step_seconds() const {
+  return step_seconds_;
+}
+
+double FixedTimestep::alpha() const {
+  return stats_.alpha;
+}
+
+const FixedStepStats& FixedTimestep::stats() const {
+  return stats_;
+}
+
+} // namespace engine::time
@@ -0,0 +1,126 @@
+#include "engine/time/frame_pacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace engine::time {
+
+namespace {
+
+constexpr double error_smoothing = 0.05;
+
+double to_ms(const std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+FramePacer::FramePacer(const FramePacerSettings& settings) {
+  set_settings(settings);
+}
+
+void FramePacer::set_settings(const FramePacerSettings& settings) {
+  settings_ = settings;
+  settings_.spin_threshold_ms = std::max(0.0, settings_.spin_threshold_ms);
+  settings_.pump_interval_ms = std::max(0.1, settings_.pump_interval_ms);
+  has_deadline_ = false;
+  stats_.target_fps = active_target_fps();
+}
+
+const FramePacerSettings& FramePacer::settings() const {
+  return settings_;
+}
+
+void FramePacer::set_window_state(const bool focused, const bool minimized) {
+  if (focused == focused_ && minimized == minimized_) {
+    return;
+  }
+  focused_ = focused;
+  minimized_ = minimized;
+  has_deadline_ = false;
+  stats_.target_fps = active_target_fps();
+}
+
+void FramePacer::wait(const std::function<void()>& pump) {
+  const double target_fps = active_target_fps();
+  stats_.target_fps = target_fps;
+  wait_period(target_fps > 0.0 ? 1.0 / target_fps : 0.0, pump);
+}
+
+void FramePacer::wait_interval(const double interval_seconds, const std::function<void()>& pump) {
+  stats_.target_fps = interval_seconds > 0.0 ? 1.0 / interval_seconds : 0.0;
+  wait_period(interval_seconds, pump);
+}
+
+const FramePacerStats& FramePacer::stats() const {
+  return stats_;
+}
+
+void FramePacer::wait_period(const double period_seconds, const std::function<void()>& pump) {
+  const clock::time_point start = clock::now();
+  if (period_seconds <= 0.0) {
+    has_deadline_ = false;
+    stats_.last_idle_ms = 0.0;
+    return;
+  }
+
+  // Deadlines advance by whole periods so small errors do not accumulate into drift;
+  // after a long stall the schedule restarts instead of rushing to catch up.
+  const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(period_seconds));
+  if (!has_deadline_ || start - deadline_ > period) {
+    deadline_ = start;
+    has_deadline_ = true;
+  }
+  deadline_ += period;
+
+  // Spinning only buys accuracy that nobody sees while minimized or headless.
+  const bool allow_spin = !minimized_;
+  const double spin_ms = allow_spin ? std::max(settings_.spin_threshold_ms, stats_.sleep_overshoot_ms * 1.5) : 0.0;
+  const double remaining_ms = to_ms(deadline_ - start);
+  if (remaining_ms > spin_ms) {
+    // Overshoot is measured per sleep_for call, so slicing for the pump keeps the estimate honest.
+    const auto sleep_until = deadline_ - std::chrono::duration_cast<clock::duration>(
+                                             std::chrono::duration<double, std::milli>(spin_ms));
+    while (true) {
+      if (pump) {
+        pump();
+      }
+      const double left_ms = to_ms(sleep_until - clock::now());
+      if (left_ms <= 0.0) {
+        break;
+      }
+      const double sleep_ms = pump ? std::min(left_ms, settings_.pump_interval_ms) : left_ms;
+      const clock::time_point sleep_start = clock::now();
+      std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(sleep_ms));
+      const double overshoot_ms = std::max(0.0, to_ms(clock::now() - sleep_start) - sleep_ms);
+      stats_.sleep_overshoot_ms += (overshoot_ms - stats_.sleep_overshoot_ms) * error_smoothing;
+    }
+  }
+  if (allow_spin) {
+    while (clock::now() < deadline_) {
+      std::this_thread::yield();
+    }
+  }
+
+  const clock::time_point woke = clock::now();
+  const double error_ms = to_ms(woke - deadline_);
+  stats_.paced_frames += 1;
+  stats_.last_wake_error_ms = error_ms;
+  stats_.avg_wake_error_ms += (std::fabs(error_ms) - stats_.avg_wake_error_ms) * error_smoothing;
+  stats_.max_wake_error_ms = std::max(stats_.max_wake_error_ms, std::fabs(error_ms));
+  stats_.last_idle_ms = to_ms(woke - start);
+}
+
+double FramePacer::active_target_fps() const {
+  if (minimized_) {
+    return settings_.minimized_fps;
+  }
+  if (!focused_ && settings_.unfocused_fps > 0.0) {
+    return settings_.target_fps > 0.0 ? std::min(settings_.target_fps, settings_.unfocused_fps)
+                                      : settings_.unfocused_fps;
+  }
+  return settings_.target_fps;
+}
+
+} // namespace engine::time